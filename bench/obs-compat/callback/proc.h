@@ -0,0 +1,4 @@
+#pragma once
+
+/* Headless bench stand-in for libobs callback/proc.h */
+typedef struct proc_handler proc_handler_t;
@@ -0,0 +1,6 @@
+#pragma once
+
+/* Headless bench stand-in for libobs callback/signal.h */
+typedef struct signal_handler signal_handler_t;
+typedef struct calldata calldata_t;
+typedef void (*signal_callback_t)(void *data, calldata_t *cd);
@@ -0,0 +1,28 @@
+#pragma once
+
+/* Headless bench stand-in for libobs graphics/axisang.h */
+#include "../util/sse-intrin.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct axisang {
+	union {
+		struct {
+			float x, y, z, w;
+		};
+		float ptr[4];
+		__m128 m;
+	};
+};
+
+static inline void axisang_set(struct axisang *dst, float x, float y, float z,
+			       float w)
+{
+	dst->m = _mm_set_ps(w, z, y, x);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,30 @@
+#pragma once
+
+/* Headless bench stand-in for libobs graphics/image-file.h */
+#include <graphics/graphics.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct gs_image_file {
+	gs_texture_t *texture;
+	enum gs_color_format format;
+	uint32_t cx;
+	uint32_t cy;
+	bool is_animated_gif;
+	bool frame_updated;
+	bool loaded;
+
+	uint8_t *texture_data;
+};
+
+typedef struct gs_image_file gs_image_file_t;
+
+EXPORT void gs_image_file_init(gs_image_file_t *image, const char *file);
+EXPORT void gs_image_file_free(gs_image_file_t *image);
+EXPORT void gs_image_file_init_texture(gs_image_file_t *image);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,4 @@
+#pragma once
+
+/* Headless bench stand-in for libobs graphics/input.h */
+typedef struct input_subsystem input_t;
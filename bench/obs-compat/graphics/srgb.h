@@ -0,0 +1,39 @@
+#pragma once
+
+/* Headless bench stand-in for libobs graphics/srgb.h */
+#include <math.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline float gs_srgb_nonlinear_to_linear(float u)
+{
+	return (u <= 0.04045f) ? (u / 12.92f) : powf((u + 0.055f) / 1.055f, 2.4f);
+}
+
+static inline void gs_float3_srgb_nonlinear_to_linear(float *f)
+{
+	f[0] = gs_srgb_nonlinear_to_linear(f[0]);
+	f[1] = gs_srgb_nonlinear_to_linear(f[1]);
+	f[2] = gs_srgb_nonlinear_to_linear(f[2]);
+}
+
+static inline void gs_float4_to_u8x4(uint8_t *u, const float *f)
+{
+	for (int i = 0; i < 4; i++) {
+		float v = f[i] < 0.0f ? 0.0f : (f[i] > 1.0f ? 1.0f : f[i]);
+		u[i] = (uint8_t)(v * 255.0f + 0.5f);
+	}
+}
+
+static inline void gs_u8x4_to_float4(float *f, const uint8_t *u)
+{
+	for (int i = 0; i < 4; i++)
+		f[i] = (float)u[i] / 255.0f;
+}
+
+#ifdef __cplusplus
+}
+#endif
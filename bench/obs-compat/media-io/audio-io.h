@@ -0,0 +1,36 @@
+#pragma once
+
+/* Headless bench stand-in for libobs media-io/audio-io.h */
+#include <stddef.h>
+#include <stdint.h>
+
+#define MAX_AUDIO_MIXES 6
+#define MAX_AUDIO_CHANNELS 8
+#define AUDIO_OUTPUT_FRAMES 1024
+
+#ifndef MAX_AV_PLANES
+#define MAX_AV_PLANES 8
+#endif
+
+typedef struct audio_output audio_t;
+
+enum audio_format {
+	AUDIO_FORMAT_UNKNOWN,
+	AUDIO_FORMAT_U8BIT,
+	AUDIO_FORMAT_16BIT,
+	AUDIO_FORMAT_32BIT,
+	AUDIO_FORMAT_FLOAT,
+};
+
+enum speaker_layout {
+	SPEAKERS_UNKNOWN,
+	SPEAKERS_MONO,
+	SPEAKERS_STEREO,
+};
+
+struct audio_output_data {
+	float *data[MAX_AUDIO_CHANNELS];
+};
+
+typedef void (*audio_output_callback_t)(void *param, size_t mix_idx,
+					struct audio_data *data);
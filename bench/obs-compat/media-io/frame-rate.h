@@ -0,0 +1,9 @@
+#pragma once
+
+/* Headless bench stand-in for libobs media-io/frame-rate.h */
+#include <stdint.h>
+
+struct media_frames_per_second {
+	uint32_t numerator;
+	uint32_t denominator;
+};
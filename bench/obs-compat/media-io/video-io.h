@@ -0,0 +1,30 @@
+#pragma once
+
+/* Headless bench stand-in for libobs media-io/video-io.h */
+#include <stdint.h>
+
+#ifndef MAX_AV_PLANES
+#define MAX_AV_PLANES 8
+#endif
+
+typedef struct video_output video_t;
+
+enum video_format {
+	VIDEO_FORMAT_NONE,
+	VIDEO_FORMAT_I420,
+	VIDEO_FORMAT_NV12,
+	VIDEO_FORMAT_RGBA = 6,
+	VIDEO_FORMAT_BGRA,
+};
+
+enum video_colorspace {
+	VIDEO_CS_DEFAULT,
+	VIDEO_CS_601,
+	VIDEO_CS_709,
+};
+
+enum video_range_type {
+	VIDEO_RANGE_DEFAULT,
+	VIDEO_RANGE_PARTIAL,
+	VIDEO_RANGE_FULL,
+};
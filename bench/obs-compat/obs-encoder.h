@@ -0,0 +1,7 @@
+#pragma once
+
+/* Headless bench stand-in for libobs obs-encoder.h */
+enum obs_encoder_type {
+	OBS_ENCODER_AUDIO,
+	OBS_ENCODER_VIDEO,
+};
@@ -0,0 +1,3 @@
+#pragma once
+
+/* Headless bench stand-in for libobs obs-interaction.h */
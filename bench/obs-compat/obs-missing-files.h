@@ -0,0 +1,7 @@
+#pragma once
+
+/* Headless bench stand-in for libobs obs-missing-files.h */
+typedef struct obs_missing_files obs_missing_files_t;
+typedef struct obs_missing_file obs_missing_file_t;
+typedef void (*obs_missing_file_cb)(void *src, const char *new_path,
+				    void *data);
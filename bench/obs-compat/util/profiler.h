@@ -0,0 +1,4 @@
+#pragma once
+
+/* Headless bench stand-in for libobs util/profiler.h */
+typedef struct profiler_name_store profiler_name_store_t;
@@ -0,0 +1,9 @@
+#pragma once
+
+/* Headless bench stand-in for libobs util/sse-intrin.h (x86 only). */
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#else
+#error "obs-compat: the headless bench currently targets x86/x86_64 only"
+#endif
@@ -0,0 +1,4 @@
+#pragma once
+
+/* Headless bench stand-in for libobs util/text-lookup.h */
+typedef struct text_lookup lookup_t;
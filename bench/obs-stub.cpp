@@ -0,0 +1,1511 @@
+/**
+ * Headless libobs stand-in for the Lower Thirds Plus render benchmark.
+ *
+ * Only the entry points the plugin actually calls are implemented. Graphics
+ * calls are counted instead of executed; obs_data is a small map-backed store
+ * with defaults; private text sources report a size estimated from their text
+ * and font size so layout code sees plausible values.
+ */
+
+#include "obs-stub.hpp"
+#include <graphics/graphics.h>
+#include <graphics/vec2.h>
+#include <graphics/vec3.h>
+#include <graphics/vec4.h>
+#include <graphics/matrix4.h>
+#include <graphics/image-file.h>
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <util/dstr.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cctype>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+// Recording state
+
+static stub_counters counters;
+static int matrix_depth = 0;
+static struct matrix4 identity_matrix()
+{
+	struct matrix4 m;
+	matrix4_identity(&m);
+	return m;
+}
+
+static struct matrix4 matrix_top = identity_matrix();
+static std::vector<struct matrix4> matrix_stack;
+static int blend_depth = 0;
+static bool render_open = false;
+static uint64_t render_vertices = 0;
+static uint32_t base_width = 1920;
+static uint32_t base_height = 1080;
+static bool quiet = false;
+static std::string config_dir;
+static std::string data_dir;
+static uint32_t image_decode_ms = 0;
+static uint32_t image_cx = 64;
+static uint32_t image_cy = 64;
+static std::atomic<uint64_t> image_decodes(0);
+static bool text_deferred = false;
+
+void stub_reset_counters()
+{
+	counters = stub_counters();
+}
+
+const stub_counters &stub_get_counters()
+{
+	return counters;
+}
+
+bool stub_check_balanced()
+{
+	bool ok = true;
+	if (matrix_depth != 0) {
+		blog(LOG_WARNING, "stub: unbalanced gs_matrix_push/pop (depth %d)", matrix_depth);
+		ok = false;
+	}
+	if (blend_depth != 0) {
+		blog(LOG_WARNING, "stub: unbalanced gs_blend_state_push/pop (depth %d)", blend_depth);
+		ok = false;
+	}
+	if (render_open) {
+		blog(LOG_WARNING, "stub: gs_render_start without gs_render_stop");
+		ok = false;
+	}
+	if (counters.render_starts != counters.render_stops) {
+		blog(LOG_WARNING, "stub: %llu gs_render_start vs %llu gs_render_stop",
+			(unsigned long long)counters.render_starts,
+			(unsigned long long)counters.render_stops);
+		ok = false;
+	}
+	matrix_depth = 0;
+	matrix_stack.clear();
+	matrix4_identity(&matrix_top);
+	blend_depth = 0;
+	render_open = false;
+	return ok;
+}
+
+void stub_set_base_size(uint32_t width, uint32_t height)
+{
+	base_width = width;
+	base_height = height;
+}
+
+void stub_set_config_dir(const char *dir)
+{
+	config_dir = dir ? dir : "";
+}
+
+void stub_set_data_dir(const char *dir)
+{
+	data_dir = dir ? dir : "";
+}
+
+void stub_set_image_decode_ms(uint32_t ms)
+{
+	image_decode_ms = ms;
+}
+
+void stub_set_image_size(uint32_t cx, uint32_t cy)
+{
+	image_cx = cx;
+	image_cy = cy;
+}
+
+uint64_t stub_image_decodes()
+{
+	return image_decodes.load();
+}
+
+void stub_set_quiet(bool q)
+{
+	quiet = q;
+}
+
+// ---------------------------------------------------------------------------
+// util: memory, logging, time
+
+extern "C" {
+
+void *bmalloc(size_t size)
+{
+	void *ptr = malloc(size ? size : 1);
+	if (!ptr)
+		abort();
+	return ptr;
+}
+
+void *brealloc(void *ptr, size_t size)
+{
+	void *out = realloc(ptr, size ? size : 1);
+	if (!out)
+		abort();
+	return out;
+}
+
+void bfree(void *ptr)
+{
+	free(ptr);
+}
+
+void *bmemdup(const void *ptr, size_t size)
+{
+	void *out = bmalloc(size);
+	if (size)
+		memcpy(out, ptr, size);
+	return out;
+}
+
+void blogva(int log_level, const char *format, va_list args)
+{
+	if (quiet && log_level > LOG_WARNING)
+		return;
+	vfprintf(stderr, format, args);
+	fputc('\n', stderr);
+}
+
+void blog(int log_level, const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	blogva(log_level, format, args);
+	va_end(args);
+}
+
+uint64_t os_gettime_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void os_sleep_ms(uint32_t duration)
+{
+	usleep(duration * 1000);
+}
+
+// ---------------------------------------------------------------------------
+// util: files (plain POSIX, the bench only runs on Linux)
+
+FILE *os_fopen(const char *path, const char *mode)
+{
+	return fopen(path, mode);
+}
+
+bool os_file_exists(const char *path)
+{
+	struct stat st;
+	return path && stat(path, &st) == 0;
+}
+
+char *os_get_abs_path_ptr(const char *path)
+{
+	char *abs_path = path ? realpath(path, nullptr) : nullptr;
+	if (!abs_path)
+		return nullptr;
+	char *out = bstrdup(abs_path);
+	free(abs_path);
+	return out;
+}
+
+char *os_quick_read_utf8_file(const char *path)
+{
+	FILE *file = fopen(path, "rb");
+	if (!file)
+		return nullptr;
+	std::string text;
+	char buf[4096];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), file)) > 0)
+		text.append(buf, n);
+	fclose(file);
+	return bstrdup(text.c_str());
+}
+
+int os_unlink(const char *path)
+{
+	return unlink(path);
+}
+
+int os_rename(const char *old_path, const char *new_path)
+{
+	return rename(old_path, new_path);
+}
+
+struct os_dir {
+	DIR *dir;
+	struct os_dirent out;
+};
+
+os_dir_t *os_opendir(const char *path)
+{
+	DIR *dir = opendir(path);
+	if (!dir)
+		return nullptr;
+	os_dir_t *listing = new os_dir_t();
+	listing->dir = dir;
+	return listing;
+}
+
+struct os_dirent *os_readdir(os_dir_t *listing)
+{
+	struct dirent *entry = listing ? readdir(listing->dir) : nullptr;
+	if (!entry)
+		return nullptr;
+	snprintf(listing->out.d_name, sizeof(listing->out.d_name), "%s", entry->d_name);
+	listing->out.directory = entry->d_type == DT_DIR;
+	return &listing->out;
+}
+
+void os_closedir(os_dir_t *listing)
+{
+	if (!listing)
+		return;
+	closedir(listing->dir);
+	delete listing;
+}
+
+int os_mkdirs(const char *path)
+{
+	std::string dir(path);
+	for (size_t i = 1; i <= dir.size(); i++) {
+		if (i == dir.size() || dir[i] == '/') {
+			std::string part = dir.substr(0, i);
+			if (mkdir(part.c_str(), 0755) != 0 && errno != EEXIST)
+				return MKDIR_ERROR;
+		}
+	}
+	return MKDIR_SUCCESS;
+}
+
+void dstr_vprintf(struct dstr *dst, const char *format, va_list args)
+{
+	va_list copy;
+	va_copy(copy, args);
+	int len = vsnprintf(nullptr, 0, format, copy);
+	va_end(copy);
+	if (len < 0)
+		len = 0;
+
+	bfree(dst->array);
+	dst->array = (char *)bmalloc((size_t)len + 1);
+	dst->capacity = (size_t)len + 1;
+	dst->len = (size_t)vsnprintf(dst->array, (size_t)len + 1, format, args);
+}
+
+void dstr_printf(struct dstr *dst, const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	dstr_vprintf(dst, format, args);
+	va_end(args);
+}
+
+} // extern "C"
+
+// ---------------------------------------------------------------------------
+// obs_data
+
+namespace {
+
+enum class data_kind { none, integer, real, boolean, string, object };
+
+struct data_value {
+	data_kind kind = data_kind::none;
+	long long i = 0;
+	double d = 0.0;
+	bool b = false;
+	std::string s;
+	obs_data_t *obj = nullptr;
+};
+
+} // namespace
+
+struct obs_data {
+	long refs = 1;
+	std::map<std::string, data_value> user;
+	std::map<std::string, data_value> defaults;
+};
+
+static void release_value(data_value &v)
+{
+	if (v.kind == data_kind::object && v.obj)
+		obs_data_release(v.obj);
+	v = data_value();
+}
+
+static const data_value *find_value(obs_data_t *data, const char *name)
+{
+	if (!data || !name)
+		return nullptr;
+	auto it = data->user.find(name);
+	if (it != data->user.end())
+		return &it->second;
+	it = data->defaults.find(name);
+	if (it != data->defaults.end())
+		return &it->second;
+	return nullptr;
+}
+
+static data_value &slot(std::map<std::string, data_value> &map, const char *name)
+{
+	data_value &v = map[name];
+	release_value(v);
+	return v;
+}
+
+extern "C" {
+
+obs_data_t *obs_data_create()
+{
+	return new obs_data();
+}
+
+void obs_data_addref(obs_data_t *data)
+{
+	if (data)
+		data->refs++;
+}
+
+void obs_data_release(obs_data_t *data)
+{
+	if (!data || --data->refs > 0)
+		return;
+	for (auto &kv : data->user)
+		release_value(kv.second);
+	for (auto &kv : data->defaults)
+		release_value(kv.second);
+	delete data;
+}
+
+void obs_data_set_string(obs_data_t *data, const char *name, const char *val)
+{
+	data_value &v = slot(data->user, name);
+	v.kind = data_kind::string;
+	v.s = val ? val : "";
+}
+
+void obs_data_set_int(obs_data_t *data, const char *name, long long val)
+{
+	data_value &v = slot(data->user, name);
+	v.kind = data_kind::integer;
+	v.i = val;
+}
+
+void obs_data_set_double(obs_data_t *data, const char *name, double val)
+{
+	data_value &v = slot(data->user, name);
+	v.kind = data_kind::real;
+	v.d = val;
+}
+
+void obs_data_set_bool(obs_data_t *data, const char *name, bool val)
+{
+	data_value &v = slot(data->user, name);
+	v.kind = data_kind::boolean;
+	v.b = val;
+}
+
+void obs_data_set_obj(obs_data_t *data, const char *name, obs_data_t *obj)
+{
+	data_value &v = slot(data->user, name);
+	v.kind = data_kind::object;
+	v.obj = obj;
+	obs_data_addref(obj);
+}
+
+void obs_data_set_default_string(obs_data_t *data, const char *name, const char *val)
+{
+	data_value &v = slot(data->defaults, name);
+	v.kind = data_kind::string;
+	v.s = val ? val : "";
+}
+
+void obs_data_set_default_int(obs_data_t *data, const char *name, long long val)
+{
+	data_value &v = slot(data->defaults, name);
+	v.kind = data_kind::integer;
+	v.i = val;
+}
+
+void obs_data_set_default_double(obs_data_t *data, const char *name, double val)
+{
+	data_value &v = slot(data->defaults, name);
+	v.kind = data_kind::real;
+	v.d = val;
+}
+
+void obs_data_set_default_bool(obs_data_t *data, const char *name, bool val)
+{
+	data_value &v = slot(data->defaults, name);
+	v.kind = data_kind::boolean;
+	v.b = val;
+}
+
+void obs_data_set_default_obj(obs_data_t *data, const char *name, obs_data_t *obj)
+{
+	data_value &v = slot(data->defaults, name);
+	v.kind = data_kind::object;
+	v.obj = obj;
+	obs_data_addref(obj);
+}
+
+const char *obs_data_get_string(obs_data_t *data, const char *name)
+{
+	const data_value *v = find_value(data, name);
+	return (v && v->kind == data_kind::string) ? v->s.c_str() : "";
+}
+
+long long obs_data_get_int(obs_data_t *data, const char *name)
+{
+	const data_value *v = find_value(data, name);
+	if (!v)
+		return 0;
+	if (v->kind == data_kind::real)
+		return (long long)v->d;
+	return v->kind == data_kind::integer ? v->i : 0;
+}
+
+double obs_data_get_double(obs_data_t *data, const char *name)
+{
+	const data_value *v = find_value(data, name);
+	if (!v)
+		return 0.0;
+	if (v->kind == data_kind::integer)
+		return (double)v->i;
+	return v->kind == data_kind::real ? v->d : 0.0;
+}
+
+bool obs_data_get_bool(obs_data_t *data, const char *name)
+{
+	const data_value *v = find_value(data, name);
+	return v && v->kind == data_kind::boolean && v->b;
+}
+
+obs_data_t *obs_data_get_obj(obs_data_t *data, const char *name)
+{
+	const data_value *v = find_value(data, name);
+	if (!v || v->kind != data_kind::object)
+		return nullptr;
+	obs_data_addref(v->obj);
+	return v->obj;
+}
+
+} // extern "C"
+
+// ---------------------------------------------------------------------------
+// obs_properties (structure only; nothing is displayed)
+
+struct obs_property {
+	std::string name;
+	std::string description;
+};
+
+struct obs_properties {
+	std::vector<std::unique_ptr<obs_property>> props;
+	std::vector<obs_properties_t *> groups;
+};
+
+static obs_property_t *add_property(obs_properties_t *props, const char *name, const char *desc)
+{
+	props->props.emplace_back(new obs_property());
+	obs_property_t *p = props->props.back().get();
+	p->name = name ? name : "";
+	p->description = desc ? desc : "";
+	return p;
+}
+
+extern "C" {
+
+obs_properties_t *obs_properties_create(void)
+{
+	return new obs_properties();
+}
+
+void obs_properties_destroy(obs_properties_t *props)
+{
+	if (!props)
+		return;
+	for (obs_properties_t *group : props->groups)
+		obs_properties_destroy(group);
+	delete props;
+}
+
+obs_property_t *obs_properties_get(obs_properties_t *props, const char *property)
+{
+	if (!props || !property)
+		return nullptr;
+	for (auto &p : props->props) {
+		if (p->name == property)
+			return p.get();
+	}
+	for (obs_properties_t *group : props->groups) {
+		obs_property_t *p = obs_properties_get(group, property);
+		if (p)
+			return p;
+	}
+	return nullptr;
+}
+
+obs_property_t *obs_properties_add_bool(obs_properties_t *props, const char *name, const char *description)
+{
+	return add_property(props, name, description);
+}
+
+obs_property_t *obs_properties_add_int_slider(obs_properties_t *props, const char *name,
+	const char *description, int min, int max, int step)
+{
+	UNUSED_PARAMETER(min);
+	UNUSED_PARAMETER(max);
+	UNUSED_PARAMETER(step);
+	return add_property(props, name, description);
+}
+
+obs_property_t *obs_properties_add_float_slider(obs_properties_t *props, const char *name,
+	const char *description, double min, double max, double step)
+{
+	UNUSED_PARAMETER(min);
+	UNUSED_PARAMETER(max);
+	UNUSED_PARAMETER(step);
+	return add_property(props, name, description);
+}
+
+obs_property_t *obs_properties_add_text(obs_properties_t *props, const char *name,
+	const char *description, enum obs_text_type type)
+{
+	UNUSED_PARAMETER(type);
+	return add_property(props, name, description);
+}
+
+obs_property_t *obs_properties_add_path(obs_properties_t *props, const char *name,
+	const char *description, enum obs_path_type type, const char *filter, const char *default_path)
+{
+	UNUSED_PARAMETER(type);
+	UNUSED_PARAMETER(filter);
+	UNUSED_PARAMETER(default_path);
+	return add_property(props, name, description);
+}
+
+obs_property_t *obs_properties_add_list(obs_properties_t *props, const char *name,
+	const char *description, enum obs_combo_type type, enum obs_combo_format format)
+{
+	UNUSED_PARAMETER(type);
+	UNUSED_PARAMETER(format);
+	return add_property(props, name, description);
+}
+
+obs_property_t *obs_properties_add_color(obs_properties_t *props, const char *name, const char *description)
+{
+	return add_property(props, name, description);
+}
+
+obs_property_t *obs_properties_add_button2(obs_properties_t *props, const char *name,
+	const char *text, obs_property_clicked_t callback, void *priv)
+{
+	UNUSED_PARAMETER(callback);
+	UNUSED_PARAMETER(priv);
+	return add_property(props, name, text);
+}
+
+obs_property_t *obs_properties_add_font(obs_properties_t *props, const char *name, const char *description)
+{
+	return add_property(props, name, description);
+}
+
+obs_property_t *obs_properties_add_group(obs_properties_t *props, const char *name,
+	const char *description, enum obs_group_type type, obs_properties_t *group)
+{
+	UNUSED_PARAMETER(type);
+	props->groups.push_back(group);
+	return add_property(props, name, description);
+}
+
+void obs_property_set_modified_callback(obs_property_t *p, obs_property_modified_t modified)
+{
+	UNUSED_PARAMETER(p);
+	UNUSED_PARAMETER(modified);
+}
+
+size_t obs_property_list_add_int(obs_property_t *p, const char *name, long long val)
+{
+	UNUSED_PARAMETER(p);
+	UNUSED_PARAMETER(name);
+	UNUSED_PARAMETER(val);
+	return 0;
+}
+
+} // extern "C"
+
+// ---------------------------------------------------------------------------
+// Sources
+
+struct obs_source {
+	std::string id;
+	std::string name;
+	obs_data_t *settings = nullptr;
+	const obs_source_info *info = nullptr;
+	void *context = nullptr;
+	uint32_t width = 0;
+	uint32_t height = 0;
+};
+
+static std::vector<obs_source_info> registered_sources;
+static std::vector<obs_source_t *> deferred_text_sources;
+
+static const obs_source_info *find_source_info(const char *id)
+{
+	for (const obs_source_info &info : registered_sources) {
+		if (strcmp(info.id, id) == 0)
+			return &info;
+	}
+	return nullptr;
+}
+
+// Rough FreeType-like extents so highlight boxes and right alignment see
+// non-zero sizes: ~0.55em advance per character, 1.25em line height
+static void measure_text_source(obs_source_t *source)
+{
+	const char *text = obs_data_get_string(source->settings, "text");
+	obs_data_t *font = obs_data_get_obj(source->settings, "font");
+	long long size = font ? obs_data_get_int(font, "size") : 32;
+	obs_data_release(font);
+
+	size_t len = strlen(text);
+	source->width = len ? (uint32_t)((double)len * (double)size * 0.55) : 0;
+	source->height = len ? (uint32_t)((double)size * 1.25) : 0;
+}
+
+void stub_set_text_deferred(bool deferred)
+{
+	text_deferred = deferred;
+}
+
+void stub_tick_sources()
+{
+	for (obs_source_t *source : deferred_text_sources)
+		measure_text_source(source);
+	deferred_text_sources.clear();
+}
+
+extern "C" {
+
+void obs_register_source_s(const struct obs_source_info *info, size_t size)
+{
+	obs_source_info copy = {};
+	memcpy(&copy, info, size < sizeof(copy) ? size : sizeof(copy));
+	registered_sources.push_back(copy);
+}
+
+obs_source_t *obs_source_create_private(const char *id, const char *name, obs_data_t *settings)
+{
+	obs_source_t *source = new obs_source();
+	source->id = id ? id : "";
+	source->name = name ? name : "";
+	source->settings = obs_data_create();
+	source->info = find_source_info(source->id.c_str());
+
+	if (source->info && source->info->get_defaults)
+		source->info->get_defaults(source->settings);
+
+	if (settings) {
+		for (auto &kv : settings->user) {
+			data_value &v = slot(source->settings->user, kv.first.c_str());
+			v = kv.second;
+			if (v.kind == data_kind::object)
+				obs_data_addref(v.obj);
+		}
+	}
+
+	if (source->info && source->info->create)
+		source->context = source->info->create(source->settings, source);
+	else
+		measure_text_source(source);
+	return source;
+}
+
+void obs_source_release(obs_source_t *source)
+{
+	if (!source)
+		return;
+	if (source->info && source->info->destroy && source->context)
+		source->info->destroy(source->context);
+	deferred_text_sources.erase(std::remove(deferred_text_sources.begin(), deferred_text_sources.end(),
+		source), deferred_text_sources.end());
+	obs_data_release(source->settings);
+	delete source;
+}
+
+void *obs_obj_get_data(void *obj)
+{
+	obs_source_t *source = (obs_source_t *)obj;
+	return source ? source->context : nullptr;
+}
+
+obs_data_t *obs_source_get_settings(const obs_source_t *source)
+{
+	obs_data_addref(source->settings);
+	return source->settings;
+}
+
+void obs_source_update(obs_source_t *source, obs_data_t *settings)
+{
+	if (!source)
+		return;
+
+	if (settings && settings != source->settings) {
+		for (auto &kv : settings->user) {
+			data_value &v = slot(source->settings->user, kv.first.c_str());
+			v = kv.second;
+			if (v.kind == data_kind::object)
+				obs_data_addref(v.obj);
+		}
+	}
+
+	if (source->info && source->info->update && source->context) {
+		source->info->update(source->context, source->settings);
+	} else {
+		counters.source_updates++;
+		if (!text_deferred)
+			measure_text_source(source);
+		else if (std::find(deferred_text_sources.begin(), deferred_text_sources.end(), source) ==
+			deferred_text_sources.end())
+			deferred_text_sources.push_back(source);
+	}
+}
+
+const char *obs_source_get_id(const obs_source_t *source)
+{
+	return source ? source->id.c_str() : nullptr;
+}
+
+uint32_t obs_source_get_width(obs_source_t *source)
+{
+	if (source && !source->info)
+		counters.source_size_queries++;
+	return source ? source->width : 0;
+}
+
+uint32_t obs_source_get_height(obs_source_t *source)
+{
+	if (source && !source->info)
+		counters.source_size_queries++;
+	return source ? source->height : 0;
+}
+
+void obs_source_video_render(obs_source_t *source)
+{
+	if (source)
+		counters.source_renders++;
+}
+
+bool obs_get_video_info(struct obs_video_info *ovi)
+{
+	memset(ovi, 0, sizeof(*ovi));
+	ovi->base_width = base_width;
+	ovi->base_height = base_height;
+	ovi->output_width = base_width;
+	ovi->output_height = base_height;
+	ovi->fps_num = 60;
+	ovi->fps_den = 1;
+	return true;
+}
+
+void obs_enter_graphics(void) {}
+void obs_leave_graphics(void) {}
+
+obs_module_t *obs_current_module(void)
+{
+	return nullptr;
+}
+
+char *obs_module_get_config_path(obs_module_t *module, const char *file)
+{
+	UNUSED_PARAMETER(module);
+	if (config_dir.empty())
+		return nullptr;
+	std::string path = config_dir + "/" + (file ? file : "");
+	return bstrdup(path.c_str());
+}
+
+char *obs_find_module_file(obs_module_t *module, const char *file)
+{
+	UNUSED_PARAMETER(module);
+	if (data_dir.empty())
+		return nullptr;
+	std::string path = data_dir + "/" + (file ? file : "");
+	if (!os_file_exists(path.c_str()))
+		return nullptr;
+	return bstrdup(path.c_str());
+}
+
+} // extern "C"
+
+// ---------------------------------------------------------------------------
+// Graphics
+
+struct gs_effect_param {
+	std::string name;
+	stub_param value = stub_param();
+};
+
+// Base effects accept any parameter and technique; effects loaded from a
+// file only the uniforms and techniques the file declares, like libobs
+struct gs_effect {
+	std::map<std::string, std::unique_ptr<gs_effect_param>> params;
+	bool looping = false;
+	bool from_file = false;
+	std::vector<std::string> uniforms;
+	std::vector<std::string> techniques;
+};
+
+static bool has_name(const std::vector<std::string> &names, const char *name)
+{
+	for (const std::string &n : names)
+		if (n == name)
+			return true;
+	return false;
+}
+
+// Collects the identifier following "<keyword> <type> " (uniforms) or
+// "<keyword> " (techniques) at the start of a line
+static void scan_declarations(const std::string &text, const char *keyword, bool typed,
+	std::vector<std::string> &out)
+{
+	size_t len = strlen(keyword);
+	size_t pos = 0;
+	while ((pos = text.find(keyword, pos)) != std::string::npos) {
+		bool line_start = pos == 0 || text[pos - 1] == '\n';
+		pos += len;
+		if (!line_start || pos >= text.size() || !isspace((unsigned char)text[pos]))
+			continue;
+
+		size_t p = pos;
+		for (int word = 0; word < (typed ? 2 : 1); word++) {
+			while (p < text.size() && isspace((unsigned char)text[p]))
+				p++;
+			size_t start = p;
+			while (p < text.size() && (isalnum((unsigned char)text[p]) || text[p] == '_'))
+				p++;
+			if (word == (typed ? 1 : 0) && p > start)
+				out.push_back(text.substr(start, p - start));
+		}
+	}
+}
+
+bool stub_get_param(gs_effect_t *effect, const char *name, stub_param *out)
+{
+	if (!effect || !name)
+		return false;
+	auto it = effect->params.find(name);
+	if (it == effect->params.end() || !it->second)
+		return false;
+	*out = it->second->value;
+	return true;
+}
+
+struct gs_texture {
+	uint32_t width;
+	uint32_t height;
+	uint32_t levels;
+};
+
+uint32_t stub_texture_levels(gs_texture_t *tex)
+{
+	return tex ? tex->levels : 0;
+}
+
+struct gs_vertex_buffer {
+	struct gs_vb_data *data;
+	uint32_t flags;
+};
+
+struct gs_texture_render {
+	struct gs_texture tex;
+	bool rendered;
+};
+
+struct gs_stage_surface {
+	uint32_t width;
+	uint32_t height;
+	uint32_t pixel_size;
+	std::vector<uint8_t> data;
+};
+
+static gs_vertbuffer_t *loaded_vertexbuffer = nullptr;
+
+static gs_effect_t base_effects[OBS_EFFECT_AREA + 1];
+
+extern "C" {
+
+gs_effect_t *obs_get_base_effect(enum obs_base_effect effect)
+{
+	if ((int)effect < 0 || effect > OBS_EFFECT_AREA)
+		return nullptr;
+	return &base_effects[effect];
+}
+
+gs_effect_t *gs_effect_create_from_file(const char *file, char **error_string)
+{
+	if (error_string)
+		*error_string = nullptr;
+	char *text = file ? os_quick_read_utf8_file(file) : nullptr;
+	if (!text) {
+		if (error_string)
+			*error_string = bstrdup("Could not read effect file");
+		return nullptr;
+	}
+
+	gs_effect_t *effect = new gs_effect();
+	effect->from_file = true;
+	scan_declarations(text, "uniform", true, effect->uniforms);
+	scan_declarations(text, "technique", false, effect->techniques);
+	bfree(text);
+	return effect;
+}
+
+void gs_effect_destroy(gs_effect_t *effect)
+{
+	if (effect && effect->from_file)
+		delete effect;
+}
+
+gs_eparam_t *gs_effect_get_param_by_name(const gs_effect_t *effect, const char *name)
+{
+	if (!effect || !name)
+		return nullptr;
+	if (effect->from_file && !has_name(effect->uniforms, name))
+		return nullptr;
+	gs_effect_t *e = const_cast<gs_effect_t *>(effect);
+	std::unique_ptr<gs_effect_param> &param = e->params[name];
+	if (!param) {
+		param.reset(new gs_effect_param());
+		param->name = name;
+	}
+	return param.get();
+}
+
+// One technique pass per loop, like OBS's built-in effects
+bool gs_effect_loop(gs_effect_t *effect, const char *name)
+{
+	if (!effect)
+		return false;
+	if (effect->from_file && !has_name(effect->techniques, name)) {
+		blog(LOG_WARNING, "stub: effect has no technique '%s'", name);
+		return false;
+	}
+	if (effect->looping) {
+		effect->looping = false;
+		return false;
+	}
+	effect->looping = true;
+	counters.effect_loops++;
+	return true;
+}
+
+void gs_effect_set_float(gs_eparam_t *param, float val)
+{
+	counters.param_sets++;
+	if (param) {
+		param->value.sets++;
+		param->value.value[0] = val;
+	}
+}
+
+void gs_effect_set_int(gs_eparam_t *param, int val)
+{
+	counters.param_sets++;
+	if (param) {
+		param->value.sets++;
+		param->value.int_value = val;
+	}
+}
+
+void gs_effect_set_vec2(gs_eparam_t *param, const struct vec2 *val)
+{
+	counters.param_sets++;
+	if (param) {
+		param->value.sets++;
+		param->value.value[0] = val->x;
+		param->value.value[1] = val->y;
+	}
+}
+
+void gs_effect_set_vec3(gs_eparam_t *param, const struct vec3 *val)
+{
+	counters.param_sets++;
+	if (param) {
+		param->value.sets++;
+		param->value.value[0] = val->x;
+		param->value.value[1] = val->y;
+		param->value.value[2] = val->z;
+	}
+}
+
+void gs_effect_set_vec4(gs_eparam_t *param, const struct vec4 *val)
+{
+	counters.param_sets++;
+	if (param) {
+		param->value.sets++;
+		memcpy(param->value.value, val->ptr, sizeof(param->value.value));
+	}
+}
+
+void gs_effect_set_texture(gs_eparam_t *param, gs_texture_t *val)
+{
+	UNUSED_PARAMETER(param);
+	UNUSED_PARAMETER(val);
+	counters.param_sets++;
+}
+
+// The transforms are tracked (libobs order: each one applies before the
+// current top) so gs_matrix_get() returns what a device would use
+static void matrix_apply_first(const struct matrix4 &m)
+{
+	const struct matrix4 top = matrix_top;
+	const float *a = &m.x.x;
+	const float *b = &top.x.x;
+	float *out = &matrix_top.x.x;
+	for (int r = 0; r < 4; r++) {
+		for (int c = 0; c < 4; c++) {
+			float sum = 0.0f;
+			for (int k = 0; k < 4; k++)
+				sum += a[r * 4 + k] * b[k * 4 + c];
+			out[r * 4 + c] = sum;
+		}
+	}
+}
+
+void gs_matrix_push(void)
+{
+	matrix_depth++;
+	matrix_stack.push_back(matrix_top);
+}
+
+void gs_matrix_pop(void)
+{
+	matrix_depth--;
+	if (!matrix_stack.empty()) {
+		matrix_top = matrix_stack.back();
+		matrix_stack.pop_back();
+	}
+}
+
+void gs_matrix_identity(void)
+{
+	matrix4_identity(&matrix_top);
+}
+
+void gs_matrix_get(struct matrix4 *dst)
+{
+	*dst = matrix_top;
+}
+
+void gs_matrix_rotaa4f(float x, float y, float z, float angle)
+{
+	float len = sqrtf(x * x + y * y + z * z);
+	if (len <= 0.0f)
+		return;
+	x /= len;
+	y /= len;
+	z /= len;
+	float c = cosf(angle), s = sinf(angle), t = 1.0f - c;
+
+	struct matrix4 m;
+	matrix4_identity(&m);
+	m.x.x = t * x * x + c;
+	m.x.y = t * x * y + s * z;
+	m.x.z = t * x * z - s * y;
+	m.y.x = t * x * y - s * z;
+	m.y.y = t * y * y + c;
+	m.y.z = t * y * z + s * x;
+	m.z.x = t * x * z + s * y;
+	m.z.y = t * y * z - s * x;
+	m.z.z = t * z * z + c;
+	matrix_apply_first(m);
+}
+
+void gs_matrix_translate3f(float x, float y, float z)
+{
+	struct matrix4 m;
+	matrix4_identity(&m);
+	m.t.x = x;
+	m.t.y = y;
+	m.t.z = z;
+	matrix_apply_first(m);
+}
+
+void gs_matrix_scale3f(float x, float y, float z)
+{
+	struct matrix4 m;
+	matrix4_identity(&m);
+	m.x.x = x;
+	m.y.y = y;
+	m.z.z = z;
+	matrix_apply_first(m);
+}
+
+void gs_render_start(bool b_new)
+{
+	UNUSED_PARAMETER(b_new);
+	counters.render_starts++;
+	render_open = true;
+	render_vertices = 0;
+}
+
+void gs_render_stop(enum gs_draw_mode mode)
+{
+	UNUSED_PARAMETER(mode);
+	counters.render_stops++;
+	counters.vertices += render_vertices;
+	render_open = false;
+	render_vertices = 0;
+}
+
+void gs_vertex2f(float x, float y)
+{
+	UNUSED_PARAMETER(x);
+	UNUSED_PARAMETER(y);
+	render_vertices++;
+}
+
+void gs_vertex3f(float x, float y, float z)
+{
+	UNUSED_PARAMETER(x);
+	UNUSED_PARAMETER(y);
+	UNUSED_PARAMETER(z);
+	render_vertices++;
+}
+
+void gs_color(uint32_t color)
+{
+	UNUSED_PARAMETER(color);
+}
+
+void gs_texcoord(float x, float y, int unit)
+{
+	UNUSED_PARAMETER(x);
+	UNUSED_PARAMETER(y);
+	UNUSED_PARAMETER(unit);
+}
+
+void gs_draw_sprite(gs_texture_t *tex, uint32_t flip, uint32_t width, uint32_t height)
+{
+	UNUSED_PARAMETER(tex);
+	UNUSED_PARAMETER(flip);
+	UNUSED_PARAMETER(width);
+	UNUSED_PARAMETER(height);
+	counters.sprite_draws++;
+	counters.vertices += 4;
+}
+
+void gs_draw_sprite_subregion(gs_texture_t *tex, uint32_t flip, uint32_t x, uint32_t y,
+	uint32_t cx, uint32_t cy)
+{
+	UNUSED_PARAMETER(tex);
+	UNUSED_PARAMETER(flip);
+	UNUSED_PARAMETER(x);
+	UNUSED_PARAMETER(y);
+	UNUSED_PARAMETER(cx);
+	UNUSED_PARAMETER(cy);
+	counters.sprite_draws++;
+	counters.vertices += 4;
+}
+
+void gs_set_scissor_rect(const struct gs_rect *rect)
+{
+	UNUSED_PARAMETER(rect);
+}
+
+gs_texture_t *gs_texture_create(uint32_t width, uint32_t height, enum gs_color_format color_format,
+	uint32_t levels, const uint8_t **data, uint32_t flags)
+{
+	UNUSED_PARAMETER(color_format);
+	UNUSED_PARAMETER(data);
+	UNUSED_PARAMETER(flags);
+	counters.texture_creates++;
+	gs_texture_t *tex = new gs_texture_t();
+	tex->width = width;
+	tex->height = height;
+	tex->levels = levels ? levels : 1;
+	return tex;
+}
+
+void gs_texture_set_image(gs_texture_t *tex, const uint8_t *data, uint32_t linesize, bool invert)
+{
+	UNUSED_PARAMETER(tex);
+	UNUSED_PARAMETER(data);
+	UNUSED_PARAMETER(linesize);
+	UNUSED_PARAMETER(invert);
+	counters.texture_updates++;
+}
+
+uint32_t gs_texture_get_width(const gs_texture_t *tex)
+{
+	return tex ? tex->width : 0;
+}
+
+uint32_t gs_texture_get_height(const gs_texture_t *tex)
+{
+	return tex ? tex->height : 0;
+}
+
+void gs_texture_destroy(gs_texture_t *tex)
+{
+	delete tex;
+}
+
+// Readback of an all-zero surface: nothing is rasterized
+gs_stagesurf_t *gs_stagesurface_create(uint32_t width, uint32_t height, enum gs_color_format color_format)
+{
+	gs_stagesurf_t *stage = new gs_stagesurf_t();
+	stage->width = width;
+	stage->height = height;
+	stage->pixel_size = color_format == GS_RGBA16F ? 8 : 4;
+	stage->data.assign((size_t)width * height * stage->pixel_size, 0);
+	return stage;
+}
+
+void gs_stagesurface_destroy(gs_stagesurf_t *stagesurf)
+{
+	delete stagesurf;
+}
+
+void gs_stage_texture(gs_stagesurf_t *dst, gs_texture_t *src)
+{
+	UNUSED_PARAMETER(dst);
+	UNUSED_PARAMETER(src);
+	counters.readbacks++;
+}
+
+bool gs_stagesurface_map(gs_stagesurf_t *stagesurf, uint8_t **data, uint32_t *linesize)
+{
+	if (!stagesurf)
+		return false;
+	*data = stagesurf->data.data();
+	*linesize = stagesurf->width * stagesurf->pixel_size;
+	return true;
+}
+
+void gs_stagesurface_unmap(gs_stagesurf_t *stagesurf)
+{
+	UNUSED_PARAMETER(stagesurf);
+}
+
+gs_texrender_t *gs_texrender_create(enum gs_color_format format, enum gs_zstencil_format zsformat)
+{
+	UNUSED_PARAMETER(format);
+	UNUSED_PARAMETER(zsformat);
+	return new gs_texrender_t();
+}
+
+void gs_texrender_destroy(gs_texrender_t *texrender)
+{
+	delete texrender;
+}
+
+void gs_texrender_reset(gs_texrender_t *texrender)
+{
+	if (texrender)
+		texrender->rendered = false;
+}
+
+// Like libobs: one pass per reset, pushes its own matrix
+bool gs_texrender_begin(gs_texrender_t *texrender, uint32_t cx, uint32_t cy)
+{
+	if (!texrender || texrender->rendered || !cx || !cy)
+		return false;
+	texrender->tex.width = cx;
+	texrender->tex.height = cy;
+	counters.texrender_passes++;
+	gs_matrix_push();
+	gs_matrix_identity();
+	return true;
+}
+
+void gs_texrender_end(gs_texrender_t *texrender)
+{
+	texrender->rendered = true;
+	gs_matrix_pop();
+}
+
+gs_texture_t *gs_texrender_get_texture(const gs_texrender_t *texrender)
+{
+	return texrender ? const_cast<gs_texture_t *>(&texrender->tex) : nullptr;
+}
+
+void gs_clear(uint32_t clear_flags, const struct vec4 *color, float depth, uint8_t stencil)
+{
+	UNUSED_PARAMETER(clear_flags);
+	UNUSED_PARAMETER(color);
+	UNUSED_PARAMETER(depth);
+	UNUSED_PARAMETER(stencil);
+}
+
+void gs_ortho(float left, float right, float top, float bottom, float znear, float zfar)
+{
+	UNUSED_PARAMETER(left);
+	UNUSED_PARAMETER(right);
+	UNUSED_PARAMETER(top);
+	UNUSED_PARAMETER(bottom);
+	UNUSED_PARAMETER(znear);
+	UNUSED_PARAMETER(zfar);
+}
+
+gs_vertbuffer_t *gs_vertexbuffer_create(struct gs_vb_data *data, uint32_t flags)
+{
+	gs_vertbuffer_t *vb = new gs_vertbuffer_t();
+	vb->data = data;
+	vb->flags = flags;
+	return vb;
+}
+
+void gs_vertexbuffer_destroy(gs_vertbuffer_t *vertbuffer)
+{
+	if (!vertbuffer)
+		return;
+	if (loaded_vertexbuffer == vertbuffer)
+		loaded_vertexbuffer = nullptr;
+	gs_vbdata_destroy(vertbuffer->data);
+	delete vertbuffer;
+}
+
+void gs_vertexbuffer_flush(gs_vertbuffer_t *vertbuffer)
+{
+	UNUSED_PARAMETER(vertbuffer);
+}
+
+struct gs_vb_data *gs_vertexbuffer_get_data(const gs_vertbuffer_t *vertbuffer)
+{
+	return vertbuffer ? vertbuffer->data : nullptr;
+}
+
+void gs_load_vertexbuffer(gs_vertbuffer_t *vertbuffer)
+{
+	loaded_vertexbuffer = vertbuffer;
+}
+
+void gs_load_indexbuffer(gs_indexbuffer_t *indexbuffer)
+{
+	UNUSED_PARAMETER(indexbuffer);
+}
+
+void gs_draw(enum gs_draw_mode draw_mode, uint32_t start_vert, uint32_t num_verts)
+{
+	UNUSED_PARAMETER(draw_mode);
+	UNUSED_PARAMETER(start_vert);
+	if (!loaded_vertexbuffer) {
+		blog(LOG_WARNING, "stub: gs_draw without a vertex buffer");
+		return;
+	}
+	if (num_verts == 0)
+		num_verts = (uint32_t)loaded_vertexbuffer->data->num;
+	counters.buffer_draws++;
+	counters.vertices += num_verts;
+}
+
+void gs_blend_state_push(void)
+{
+	blend_depth++;
+}
+
+void gs_blend_state_pop(void)
+{
+	blend_depth--;
+}
+
+void gs_enable_blending(bool enable)
+{
+	UNUSED_PARAMETER(enable);
+}
+
+void gs_enable_color(bool red, bool green, bool blue, bool alpha)
+{
+	UNUSED_PARAMETER(red);
+	UNUSED_PARAMETER(green);
+	UNUSED_PARAMETER(blue);
+	UNUSED_PARAMETER(alpha);
+}
+
+void gs_blend_function(enum gs_blend_type src, enum gs_blend_type dest)
+{
+	UNUSED_PARAMETER(src);
+	UNUSED_PARAMETER(dest);
+}
+
+void gs_blend_function_separate(enum gs_blend_type src_c, enum gs_blend_type dest_c,
+	enum gs_blend_type src_a, enum gs_blend_type dest_a)
+{
+	UNUSED_PARAMETER(src_c);
+	UNUSED_PARAMETER(dest_c);
+	UNUSED_PARAMETER(src_a);
+	UNUSED_PARAMETER(dest_a);
+}
+
+// The bench never reads real images: a non-empty path "decodes" to an RGBA
+// image of stub_set_image_size() (64x64 by default; a premultiplied color
+// ramp with a transparent border, like libobs decodes) after stub_set_image_decode_ms(), an empty one leaves
+// it unset
+void gs_image_file_init(gs_image_file_t *image, const char *file)
+{
+	memset(image, 0, sizeof(*image));
+	if (!file || !*file)
+		return;
+	image_decodes++;
+	if (image_decode_ms)
+		usleep(image_decode_ms * 1000);
+	image->cx = image_cx;
+	image->cy = image_cy;
+	image->format = GS_RGBA;
+	image->texture_data = (uint8_t *)bmalloc((size_t)image_cx * image_cy * 4);
+	for (uint32_t y = 0; y < image_cy; y++) {
+		for (uint32_t x = 0; x < image_cx; x++) {
+			uint8_t *p = image->texture_data + ((size_t)y * image_cx + x) * 4;
+			bool border = x < image_cx / 16 || y < image_cy / 16;
+			uint32_t a = border ? 0 : 128 + (x + y) % 128;
+			p[0] = (uint8_t)(x * 255 / image_cx * a / 255);
+			p[1] = (uint8_t)(y * 255 / image_cy * a / 255);
+			p[2] = (uint8_t)(((x ^ y) & 0xFF) * a / 255);
+			p[3] = (uint8_t)a;
+		}
+	}
+	image->loaded = true;
+}
+
+void gs_image_file_free(gs_image_file_t *image)
+{
+	if (!image)
+		return;
+	if (image->texture) {
+		delete image->texture;
+		image->texture = nullptr;
+	}
+	bfree(image->texture_data);
+	image->texture_data = nullptr;
+}
+
+void gs_image_file_init_texture(gs_image_file_t *image)
+{
+	if (image->loaded && !image->texture)
+		image->texture = gs_texture_create(image->cx, image->cy, image->format, 1,
+			(const uint8_t **)&image->texture_data, 0);
+}
+
+} // extern "C"
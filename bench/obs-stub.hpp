@@ -0,0 +1,79 @@
+#pragma once
+
+/**
+ * Headless libobs stand-in for the Lower Thirds Plus render benchmark.
+ *
+ * Implements the gs_* / obs_* entry points used by the plugin against the
+ * vendored obs-headers/ and records what a real graphics device would have
+ * been asked to do. Nothing is rasterized.
+ */
+
+#include <obs-module.h>
+#include <stdint.h>
+
+// Draw-call counters accumulated since the last stub_reset_counters()
+struct stub_counters {
+	uint64_t render_starts;       // gs_render_start
+	uint64_t render_stops;        // gs_render_stop (one immediate-mode draw each)
+	uint64_t buffer_draws;        // gs_draw with a loaded vertex buffer
+	uint64_t vertices;            // vertices submitted by any draw
+	uint64_t effect_loops;        // passes entered through gs_effect_loop
+	uint64_t param_sets;          // gs_effect_set_* uploads
+	uint64_t sprite_draws;        // gs_draw_sprite
+	uint64_t texrender_passes;    // gs_texrender_begin (render-to-texture passes)
+	uint64_t texture_creates;     // gs_texture_create (uploads from CPU memory)
+	uint64_t texture_updates;     // gs_texture_set_image (re-uploads into a texture)
+	uint64_t readbacks;           // gs_stage_texture (GPU to CPU copies)
+	uint64_t source_renders;      // obs_source_video_render on child sources
+	uint64_t source_updates;      // obs_source_update on child sources
+	uint64_t source_size_queries; // obs_source_get_width/height on child sources
+};
+
+void stub_reset_counters();
+const stub_counters &stub_get_counters();
+
+// Returns false (and logs) if a matrix or blend push was left unbalanced
+bool stub_check_balanced();
+
+// Canvas size reported through obs_get_video_info()
+void stub_set_base_size(uint32_t width, uint32_t height);
+
+// Directory returned by obs_module_config_path(); NULL (the default) makes
+// it return NULL like libobs without a config directory
+void stub_set_config_dir(const char *dir);
+
+// Directory obs_module_file() resolves against (the plugin's data/); NULL
+// (the default) makes it return NULL like a module without data
+void stub_set_data_dir(const char *dir);
+
+// Last value uploaded to an effect parameter through gs_effect_set_*
+struct stub_param {
+	uint64_t sets;
+	float value[4];               // float / vec2 / vec4 components
+	int int_value;
+};
+
+// False if the effect has no such parameter (or it was never looked up)
+bool stub_get_param(gs_effect_t *effect, const char *name, stub_param *out);
+
+// Time gs_image_file_init() takes for a non-empty path (the decode), 0 by
+// default
+void stub_set_image_decode_ms(uint32_t ms);
+
+// Size of the image gs_image_file_init() produces, 64x64 by default
+void stub_set_image_size(uint32_t cx, uint32_t cy);
+
+// Mip levels a texture was created with
+uint32_t stub_texture_levels(gs_texture_t *tex);
+
+// gs_image_file_init() calls for a non-empty path since startup (any thread)
+uint64_t stub_image_decodes();
+
+// Off by default: text sources take their new size at once. On, an update
+// only takes effect at the next stub_tick_sources(), like libobs applying
+// deferred updates in the video tick.
+void stub_set_text_deferred(bool deferred);
+void stub_tick_sources();
+
+// Suppress blog() output below LOG_WARNING
+void stub_set_quiet(bool quiet);
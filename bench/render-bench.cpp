@@ -0,0 +1,1693 @@
+/**
+ * Lower Thirds Plus - headless render benchmark
+ *
+ * Drives lowerthirds_source::tick()/render() against the recording libobs
+ * stand-in for every AnimationStyle x BackgroundArtEffect x GradientType
+ * combination and reports CPU time and draw-call statistics per frame.
+ *
+ * --kernels instead compares the art simulation kernels (scalar vs SSE2 vs
+ * AVX2) at several intensities and checks the vector paths against scalar.
+ * --static renders with art_animate off (the cached pattern path);
+ * --fps and --sim-rate compare art cost per second across canvas frame
+ * rates and fixed art simulation rates. --governor enables the adaptive
+ * quality governor with the given render budget and reports the tier it
+ * settled on. --bake plays light rays (the one effect that repeats exactly)
+ * from baked loop atlases once the settings have held for 30 frames; with
+ * --cache-dir the atlases go to disk, so every combination after the first
+ * per effect loads instead of baking. --particles compares
+ * the classic stateless particles/sparkles with the pooled simulation at
+ * 100, 1k and 10k elements, splitting tick() (simulation) from render().
+ * --shader draws the art effects with the per-pixel effect shader; before
+ * the table it checks that each effect is one sprite draw with the expected
+ * uniforms, and that a missing effect file falls back to CPU geometry.
+ * --tessellation compares the vertices shimmer, energy flow and light rays
+ * emit with screen-space-error tessellation against the fixed 6 px / 8
+ * segment tessellation they used before, at 720p, 1080p and 2160p.
+ * --gradients checks that every gradient style is one draw per frame and
+ * that multi-stop and radial gradients bake their LUT once per change.
+ * --highlight-sdf draws the text highlight boxes with the SDF shader.
+ * --images checks that image changes return from update() without waiting
+ * for the (simulated) decode and that superseded loads are never uploaded.
+ * --resample times the image downscaler (scalar vs SSE2) on 4K and 8K
+ * inputs, checks the paths agree and keep premultiplied edges fringe-free,
+ * and checks that oversized logos and backgrounds are uploaded at their
+ * drawn size (the logo with mipmaps).
+ * --text-updates checks that only settings changes that touch the text
+ * reach the private text sources (and re-rasterize), that profile switches
+ * rasterize nothing and that only non-empty strings keep a source, and
+ * reports the text memory each profile holds.
+ * --glyphs checks the built-in glyph-atlas text with the --font face (found
+ * in --font-dir or the system font directories): layout measurements, one
+ * font and one rasterization per glyph shared by 30 sources, no re-layout
+ * for a color change, all text of a frame in one draw with no text
+ * sources, and that a size drag filling the atlas repacks it and relays
+ * other sources' text.
+ * --shadows checks that text shadows are rendered into cached silhouettes
+ * once (blurred when a radius is set) and drawn as one quad each, for the
+ * text sources and, with a --font that is found, the built-in text.
+ * --text-metrics checks that render() lays text and highlight boxes out
+ * from cached metrics without measuring, that an edit keeps the last size
+ * until the text source has rasterized, and the built-in text's metrics.
+ *
+ * Usage: lowerthirds-render-bench [--frames N] [--intensity X] [--highlight]
+ *                                 [--highlight-sdf] [--shadow] [--summary]
+ *                                 [--kernels] [--static] [--fps N]
+ *                                 [--sim-rate N] [--governor MS] [--bake]
+ *                                 [--cache-dir DIR] [--particles] [--shader]
+ *                                 [--tessellation] [--gradients] [--images]
+ *                                 [--resample] [--text-updates]
+ *                                 [--glyphs] [--font FACE] [--font-dir DIR]
+ *                                 [--shadows] [--text-metrics]
+ */
+
+#include "obs-stub.hpp"
+#include "lowerthirds-source-simple.hpp"
+#include "image-resample.hpp"
+#include "glyph-atlas.hpp"
+#include <util/platform.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+static const char *anim_names[] = {
+	"slide_left", "slide_right", "slide_bottom", "slide_top",
+	"fade", "zoom", "expand_left", "expand_right",
+	"push_left", "push_right", "wipe_left", "wipe_right",
+	"spin", "scroll", "roll", "instant"
+};
+
+static const char *art_names[] = {
+	"none", "particles", "light_rays", "bokeh", "sparkles",
+	"glow_orbs", "light_streaks", "shimmer", "energy_flow"
+};
+
+static const char *gradient_names[] = {
+	"none", "horizontal", "vertical", "diag_tl_br", "diag_bl_tr", "angle", "radial"
+};
+
+static const int num_anims = (int)(sizeof(anim_names) / sizeof(anim_names[0]));
+static const int num_arts = (int)(sizeof(art_names) / sizeof(art_names[0]));
+static const int num_gradients = (int)(sizeof(gradient_names) / sizeof(gradient_names[0]));
+
+struct bench_options {
+	int frames = 120;               // 2 s at 60 fps: full entrance + settled frames
+	double intensity = 1.0;
+	bool highlight = false;
+	bool shadow = false;
+	bool highlight_sdf = false;     // text_highlight_sdf
+	bool summary_only = false;
+	bool kernels = false;
+	bool static_art = false;        // art_animate off (cached pattern)
+	int fps = 60;                   // Canvas frame rate driving tick()
+	int sim_rate = 0;               // art_sim_rate (0 = every frame)
+	double budget_ms = 0.0;         // art_render_budget (0 = governor off)
+	bool bake = false;              // art_loop_bake
+	const char *cache_dir = nullptr; // obs_module_config_path() root
+	bool particles = false;         // Classic vs pooled particle comparison
+	bool shader = false;            // art_use_shader
+	bool tessellation = false;      // Adaptive vs fixed ribbon tessellation
+	bool gradients = false;         // Multi-stop gradient LUT checks
+	bool images = false;            // Asynchronous image loading checks
+	bool resample = false;          // Load-time image downscaling checks
+	bool text_updates = false;      // Dirty-tracked text source updates
+	bool glyphs = false;            // Built-in glyph-atlas text checks
+	bool shadows = false;           // Cached text shadow checks
+	bool text_metrics = false;      // Cached text metrics checks
+	const char *font = "DejaVu Sans"; // Face for --glyphs
+	const char *font_dir = nullptr; // Searched before the system fonts
+};
+
+struct frame_stats {
+	double ns;
+	double draws;
+	double vertices;
+	double effect_loops;
+	double param_sets;
+	double source_renders;
+	double tier;                    // Governor tier after the last frame
+	double bakes;                   // Totals, not per frame
+	double loads;
+};
+
+static bool parse_options(int argc, char **argv, bench_options &opts)
+{
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			opts.frames = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--intensity") == 0 && i + 1 < argc) {
+			opts.intensity = atof(argv[++i]);
+		} else if (strcmp(argv[i], "--highlight") == 0) {
+			opts.highlight = true;
+		} else if (strcmp(argv[i], "--highlight-sdf") == 0) {
+			opts.highlight = true;
+			opts.highlight_sdf = true;
+		} else if (strcmp(argv[i], "--shadow") == 0) {
+			opts.shadow = true;
+		} else if (strcmp(argv[i], "--summary") == 0) {
+			opts.summary_only = true;
+		} else if (strcmp(argv[i], "--kernels") == 0) {
+			opts.kernels = true;
+		} else if (strcmp(argv[i], "--static") == 0) {
+			opts.static_art = true;
+		} else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+			opts.fps = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--sim-rate") == 0 && i + 1 < argc) {
+			opts.sim_rate = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--governor") == 0 && i + 1 < argc) {
+			opts.budget_ms = atof(argv[++i]);
+		} else if (strcmp(argv[i], "--bake") == 0) {
+			opts.bake = true;
+		} else if (strcmp(argv[i], "--cache-dir") == 0 && i + 1 < argc) {
+			opts.cache_dir = argv[++i];
+		} else if (strcmp(argv[i], "--particles") == 0) {
+			opts.particles = true;
+		} else if (strcmp(argv[i], "--shader") == 0) {
+			opts.shader = true;
+		} else if (strcmp(argv[i], "--gradients") == 0) {
+			opts.gradients = true;
+		} else if (strcmp(argv[i], "--images") == 0) {
+			opts.images = true;
+		} else if (strcmp(argv[i], "--resample") == 0) {
+			opts.resample = true;
+		} else if (strcmp(argv[i], "--text-updates") == 0) {
+			opts.text_updates = true;
+		} else if (strcmp(argv[i], "--glyphs") == 0) {
+			opts.glyphs = true;
+		} else if (strcmp(argv[i], "--shadows") == 0) {
+			opts.shadows = true;
+		} else if (strcmp(argv[i], "--text-metrics") == 0) {
+			opts.text_metrics = true;
+		} else if (strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+			opts.font = argv[++i];
+		} else if (strcmp(argv[i], "--font-dir") == 0 && i + 1 < argc) {
+			opts.font_dir = argv[++i];
+		} else if (strcmp(argv[i], "--tessellation") == 0) {
+			opts.tessellation = true;
+		} else {
+			fprintf(stderr, "usage: %s [--frames N] [--intensity X] [--highlight] [--highlight-sdf] [--shadow] [--summary] [--kernels] [--static] [--fps N] [--sim-rate N] [--governor MS] [--bake] [--cache-dir DIR] [--particles] [--shader] [--tessellation] [--gradients] [--images] [--resample] [--text-updates] [--glyphs] [--font FACE] [--font-dir DIR] [--shadows] [--text-metrics]\n",
+				argv[0]);
+			return false;
+		}
+	}
+	if (opts.frames < 1)
+		opts.frames = 1;
+	if (opts.fps < 1)
+		opts.fps = 1;
+	return true;
+}
+
+static obs_data_t *make_settings(const bench_options &opts, int anim, int art, int gradient)
+{
+	obs_data_t *settings = obs_data_create();
+	obs_data_set_int(settings, "animation_style", anim);
+	obs_data_set_int(settings, "logo_animation_style", anim);
+	obs_data_set_int(settings, "text_animation_style", anim);
+	obs_data_set_int(settings, "art_effect", art);
+	obs_data_set_int(settings, "gradient_type", gradient);
+	obs_data_set_double(settings, "art_intensity", opts.intensity);
+	obs_data_set_bool(settings, "text_highlight_enabled", opts.highlight);
+	obs_data_set_bool(settings, "text_highlight_sdf", opts.highlight_sdf);
+	obs_data_set_bool(settings, "text_shadow_enabled", opts.shadow);
+	obs_data_set_string(settings, "profile1_title_right", "LIVE");
+	obs_data_set_string(settings, "profile1_subtitle_right", "Studio A");
+	obs_data_set_bool(settings, "art_animate", !opts.static_art);
+	obs_data_set_int(settings, "art_sim_rate", opts.sim_rate);
+	obs_data_set_bool(settings, "art_adaptive_quality", opts.budget_ms > 0.0);
+	if (opts.budget_ms > 0.0)
+		obs_data_set_double(settings, "art_render_budget", opts.budget_ms);
+	obs_data_set_bool(settings, "art_loop_bake", opts.bake);
+	obs_data_set_bool(settings, "art_use_shader", opts.shader);
+	obs_data_set_bool(settings, "auto_hide", false);
+	obs_data_set_bool(settings, "visible", true);
+	return settings;
+}
+
+// Returns false if the render path left graphics state unbalanced
+static bool run_combination(const bench_options &opts, int anim, int art, int gradient, frame_stats &out)
+{
+	obs_data_t *settings = make_settings(opts, anim, art, gradient);
+	obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", "bench", settings);
+	obs_data_release(settings);
+
+	lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+	const float frame_time = 1.0f / (float)opts.fps;
+
+	stub_check_balanced();
+	stub_reset_counters();
+
+	uint64_t elapsed = 0;
+	for (int frame = 0; frame < opts.frames; frame++) {
+		uint64_t start = os_gettime_ns();
+		context->tick(frame_time);
+		context->render();
+		elapsed += os_gettime_ns() - start;
+	}
+
+	bool balanced = stub_check_balanced();
+	const stub_counters &c = stub_get_counters();
+	double frames = (double)opts.frames;
+
+	out.ns = (double)elapsed / frames;
+	out.draws = (double)(c.render_stops + c.buffer_draws + c.sprite_draws) / frames;
+	out.vertices = (double)c.vertices / frames;
+	out.effect_loops = (double)c.effect_loops / frames;
+	out.param_sets = (double)c.param_sets / frames;
+	out.source_renders = (double)c.source_renders / frames;
+	out.tier = (double)context->art_gov.tier;
+	out.bakes = (double)c.readbacks;
+	out.loads = (double)c.texture_creates;
+
+	obs_source_release(source);
+	return balanced;
+}
+
+typedef void (*art_kernel_fn)(const art_kernel_input *, float, art_kernel_output *);
+
+struct kernel_case {
+	const char *name;
+	BackgroundArtEffect effect;
+	art_kernel_fn fn;
+};
+
+static const kernel_case kernel_cases[] = {
+	{"particles", ART_PARTICLES, art_kernel_particles},
+	{"bokeh", ART_BOKEH, art_kernel_bokeh},
+	{"glow_orbs", ART_GLOW_ORBS, art_kernel_glow_orbs},
+};
+
+// Largest difference against the scalar path over a spread of animation
+// times. Particle y wraps at height, so a wrap landing on the other side of
+// the boundary is not an error.
+static double kernel_max_error(const kernel_case &kc, const art_element_table &t, art_kernel_isa isa)
+{
+	int n = art_kernel_padded(t.count);
+	float *ref = (float *)bzalloc(sizeof(float) * n * 3);
+	float *got = (float *)bzalloc(sizeof(float) * n * 3);
+	art_kernel_output ref_out = {ref, ref + n, ref + n * 2};
+	art_kernel_output got_out = {got, got + n, got + n * 2};
+
+	double max_err = 0.0;
+	for (float time = 0.0f; time < 10000.0f; time += 97.3f) {
+		art_kernel_input in = {t.count, t.x, t.y, t.speed, t.phase, t.phase2, time, t.height};
+		art_kernel_set_isa(ART_KERNEL_SCALAR);
+		kc.fn(&in, 1.0f, &ref_out);
+		art_kernel_set_isa(isa);
+		kc.fn(&in, 1.0f, &got_out);
+
+		for (int i = 0; i < t.count; i++) {
+			double dx = fabs(ref_out.x[i] - got_out.x[i]);
+			double dy = fabs(ref_out.y[i] - got_out.y[i]);
+			if (kc.effect == ART_PARTICLES)
+				dy = fmin(dy, fabs(dy - t.height));
+			double da = fabs(ref_out.alpha[i] - got_out.alpha[i]) * 100.0; // alpha in percent
+			max_err = fmax(max_err, fmax(dx, fmax(dy, da)));
+		}
+	}
+
+	bfree(ref);
+	bfree(got);
+	return max_err;
+}
+
+static double kernel_ns_per_call(const kernel_case &kc, const art_element_table &t, art_kernel_isa isa)
+{
+	const int iterations = 20000;
+	art_kernel_set_isa(isa);
+	art_kernel_output out = {t.sim_x, t.sim_y, t.sim_alpha};
+
+	uint64_t start = os_gettime_ns();
+	for (int it = 0; it < iterations; it++) {
+		art_kernel_input in = {t.count, t.x, t.y, t.speed, t.phase, t.phase2, (float)it / 60.0f, t.height};
+		kc.fn(&in, 1.0f, &out);
+	}
+	return (double)(os_gettime_ns() - start) / iterations;
+}
+
+// Returns the number of vector paths that disagreed with scalar
+static int run_kernel_bench()
+{
+	const double intensities[] = {0.5, 1.0, 2.0, 3.0};
+	const double tolerance = 0.05; // px, or alpha percent
+	art_kernel_isa best = art_kernel_detect_isa();
+	int failures = 0;
+
+	printf("# art simulation kernels, best ISA: %s\n", art_kernel_isa_name(best));
+	printf("%-10s %9s %8s %-7s %12s %9s %10s\n",
+		"art", "intensity", "elements", "isa", "ns/call", "speedup", "max err");
+
+	for (const kernel_case &kc : kernel_cases) {
+		for (double intensity : intensities) {
+			bench_options opts;
+			opts.intensity = intensity;
+			obs_data_t *settings = make_settings(opts, ANIM_INSTANT, kc.effect, GRADIENT_NONE);
+			obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", "kernels", settings);
+			obs_data_release(settings);
+			const art_element_table &t = ((lowerthirds_source *)obs_obj_get_data(source))->art_table;
+
+			double scalar_ns = kernel_ns_per_call(kc, t, ART_KERNEL_SCALAR);
+			for (int isa = ART_KERNEL_SCALAR; isa <= (int)best; isa++) {
+				double ns = isa == ART_KERNEL_SCALAR ? scalar_ns : kernel_ns_per_call(kc, t, (art_kernel_isa)isa);
+				double err = isa == ART_KERNEL_SCALAR ? 0.0 : kernel_max_error(kc, t, (art_kernel_isa)isa);
+				bool ok = err <= tolerance;
+				printf("%-10s %9.1f %8d %-7s %12.1f %8.2fx %10.5f%s\n", kc.name, intensity, t.count,
+					art_kernel_isa_name((art_kernel_isa)isa), ns, scalar_ns / ns, err, ok ? "" : "  FAIL");
+				if (!ok)
+					failures++;
+			}
+
+			obs_source_release(source);
+		}
+	}
+
+	art_kernel_set_isa(best);
+	return failures;
+}
+
+// Classic elements per unit of art_intensity (see update_art_table)
+static const int classic_per_intensity[] = {0, 60, 10, 20, 50, 12, 8, 15, 6};
+
+static void run_particle_bench(const bench_options &base)
+{
+	const int counts[] = {100, 1000, 10000};
+	const BackgroundArtEffect effects[] = {ART_PARTICLES, ART_SPARKLES};
+	const float lifetime = 4.0f;
+	const float frame_time = 1.0f / (float)base.fps;
+
+	printf("# classic (stateless) vs pooled particles, %d frames at %d fps\n", base.frames, base.fps);
+	printf("%-10s %8s %-8s %10s %12s %12s %12s\n",
+		"art", "target", "mode", "live", "tick ns", "render ns", "vertices");
+
+	for (BackgroundArtEffect effect : effects) {
+		for (int count : counts) {
+			for (int pooled = 0; pooled < 2; pooled++) {
+				// Same intensity both ways, so element sizes (and draw cost
+				// per element) match; only the population source differs
+				bench_options opts = base;
+				opts.intensity = (double)count / classic_per_intensity[effect];
+				obs_data_t *settings = make_settings(opts, ANIM_INSTANT, effect, GRADIENT_NONE);
+				obs_data_set_bool(settings, "art_particle_sim", pooled != 0);
+				obs_data_set_double(settings, "art_emit_rate", (double)count / lifetime);
+				obs_data_set_double(settings, "art_particle_life", lifetime);
+				obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", "particles", settings);
+				obs_data_release(settings);
+				lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+
+				stub_reset_counters();
+				uint64_t tick_ns = 0;
+				uint64_t render_ns = 0;
+				for (int frame = 0; frame < opts.frames; frame++) {
+					uint64_t start = os_gettime_ns();
+					context->tick(frame_time);
+					uint64_t mid = os_gettime_ns();
+					context->render();
+					render_ns += os_gettime_ns() - mid;
+					tick_ns += mid - start;
+				}
+				stub_check_balanced();
+
+				int live = pooled ? context->art_pool.live : context->art_table.count;
+				printf("%-10s %8d %-8s %10d %12.0f %12.0f %12.1f\n", art_names[effect], count,
+					pooled ? "pooled" : "classic", live,
+					(double)tick_ns / opts.frames, (double)render_ns / opts.frames,
+					(double)stub_get_counters().vertices / opts.frames);
+				obs_source_release(source);
+			}
+		}
+	}
+}
+
+static bool check_param(gs_effect_t *effect, const char *name, const float *expect, int components)
+{
+	stub_param p;
+	if (!stub_get_param(effect, name, &p) || p.sets != 1) {
+		printf("  %s: expected one upload\n", name);
+		return false;
+	}
+	for (int i = 0; i < components; i++) {
+		if (fabsf(p.value[i] - expect[i]) > 1e-5f) {
+			printf("  %s[%d]: %f, expected %f\n", name, i, p.value[i], expect[i]);
+			return false;
+		}
+	}
+	return true;
+}
+
+// Returns the number of failed checks
+static int run_shader_check(const bench_options &base)
+{
+	const uint32_t color = 0xFF2080C0; // ABGR
+	const float width = 1920.0f, height = 120.0f;
+	const float opacity = 0.6f, offset = 123.25f;
+	int failures = 0;
+
+	printf("# shader path: one sprite draw per art layer, uniforms from the settings\n");
+	printf("%-14s %8s %8s %8s %8s %-6s\n", "art", "elements", "draws", "loops", "params", "result");
+
+	for (int art = ART_PARTICLES; art < num_arts; art++) {
+		bench_options opts = base;
+		opts.shader = true;
+		obs_data_t *settings = make_settings(opts, ANIM_INSTANT, art, GRADIENT_NONE);
+		obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", "shader", settings);
+		obs_data_release(settings);
+		lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+		const float intensity = (float)opts.intensity;
+
+		stub_reset_counters();
+		context->draw_art_effect(0.0f, 0.0f, width, height, (BackgroundArtEffect)art,
+			color, opacity, intensity, offset);
+		bool ok = stub_check_balanced();
+		const stub_counters &c = stub_get_counters();
+		ok = ok && c.sprite_draws == 1 && c.render_stops == 0 && c.buffer_draws == 0 &&
+			c.effect_loops == 1;
+
+		gs_effect_t *effect = context->art_gpu.effect;
+		const float color_expect[4] = {0xC0 / 255.0f, 0x80 / 255.0f, 0x20 / 255.0f, opacity};
+		const float size_expect[2] = {width, height};
+		stub_param count;
+		ok = ok && effect &&
+			check_param(effect, "art_color", color_expect, 4) &&
+			check_param(effect, "bar_size", size_expect, 2) &&
+			check_param(effect, "intensity", &intensity, 1) &&
+			check_param(effect, "animation_offset", &offset, 1) &&
+			stub_get_param(effect, "element_count", &count) &&
+			count.sets == 1 && count.int_value == context->art_table.count;
+
+		printf("%-14s %8d %8llu %8llu %8llu %-6s\n", art_names[art], context->art_table.count,
+			(unsigned long long)(c.sprite_draws + c.render_stops + c.buffer_draws),
+			(unsigned long long)c.effect_loops, (unsigned long long)c.param_sets,
+			ok ? "ok" : "FAIL");
+		if (!ok)
+			failures++;
+		obs_source_release(source);
+	}
+
+	// Without the effect file the CPU geometry must still draw
+	stub_set_data_dir(nullptr);
+	bench_options opts = base;
+	opts.shader = true;
+	obs_data_t *settings = make_settings(opts, ANIM_INSTANT, ART_PARTICLES, GRADIENT_NONE);
+	obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", "fallback", settings);
+	obs_data_release(settings);
+	lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+	stub_reset_counters();
+	context->draw_art_effect(0.0f, 0.0f, width, height, ART_PARTICLES, color, opacity, 1.0f, offset);
+	const stub_counters &c = stub_get_counters();
+	bool ok = stub_check_balanced() && c.sprite_draws == 0 && c.render_stops + c.buffer_draws > 0;
+	printf("%-14s %8s %8llu %8s %8s %-6s\n", "cpu_fallback", "",
+		(unsigned long long)(c.render_stops + c.buffer_draws), "", "", ok ? "ok" : "FAIL");
+	if (!ok)
+		failures++;
+	obs_source_release(source);
+	stub_set_data_dir(LOWERTHIRDS_DATA_DIR);
+
+	printf("\n");
+	return failures;
+}
+
+// Vertices per frame the fixed tessellation emitted at full quality: shimmer
+// every 6 px up to the last column before the bar edge, rays and pulses in
+// 8 segments (rays: core + 2 glow edges, pulses: 4 per segment x 3 layers)
+static double fixed_vertices(BackgroundArtEffect effect, int count, float width)
+{
+	switch (effect) {
+		case ART_SHIMMER: {
+			int columns = (int)(ceilf(width / 6.0f) - 1.0f) + 1;
+			return (double)count * 3 * columns * 2;
+		}
+		case ART_LIGHT_RAYS:    return (double)count * 8 * 6;
+		case ART_ENERGY_FLOW:   return (double)count * 8 * 3 * 4;
+		default:                return 0.0;
+	}
+}
+
+static void run_tessellation_bench(const bench_options &base)
+{
+	const BackgroundArtEffect effects[] = {ART_SHIMMER, ART_ENERGY_FLOW, ART_LIGHT_RAYS};
+	const double intensities[] = {0.5, 1.0, 2.0};
+	const uint32_t canvas_heights[] = {720, 1080, 2160};
+
+	printf("# screen-space-error tessellation vs fixed, art vertices per frame over %d frames\n", base.frames);
+	printf("%-12s %9s %7s %8s %12s %12s %10s\n",
+		"art", "intensity", "canvas", "elements", "fixed", "adaptive", "reduction");
+
+	for (BackgroundArtEffect effect : effects) {
+		double fixed_total = 0.0, adaptive_total = 0.0;
+		for (double intensity : intensities) {
+			for (uint32_t canvas : canvas_heights) {
+				bench_options opts = base;
+				opts.intensity = intensity;
+				stub_set_base_size(canvas * 16 / 9, canvas);
+				obs_data_t *settings = make_settings(opts, ANIM_INSTANT, effect, GRADIENT_NONE);
+				obs_data_set_bool(settings, "auto_scale", true);
+				obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", "tessellation", settings);
+				obs_data_release(settings);
+				lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+
+				// One frame picks up the canvas scale factor
+				context->tick(1.0f / 60.0f);
+				context->render();
+				const float width = 1920.0f;
+				const float height = (float)context->bar_height_pixels * context->scale_factor;
+
+				stub_reset_counters();
+				for (int frame = 0; frame < opts.frames; frame++) {
+					float offset = (float)frame / 60.0f * 30.0f;
+					context->draw_art_effect(0.0f, 0.0f, width, height, effect, 0xFFFFFFFF,
+						0.6f, (float)intensity, offset);
+				}
+				stub_check_balanced();
+
+				double adaptive = (double)stub_get_counters().vertices / opts.frames;
+				double fixed = fixed_vertices(effect, context->art_table.count, width);
+				printf("%-12s %9.1f %6up %8d %12.0f %12.1f %9.1f%%\n", art_names[effect], intensity,
+					canvas, context->art_table.count, fixed, adaptive,
+					fixed > 0.0 ? (1.0 - adaptive / fixed) * 100.0 : 0.0);
+				fixed_total += fixed;
+				adaptive_total += adaptive;
+				obs_source_release(source);
+			}
+		}
+		printf("%-12s %9s %7s %8s %12.0f %12.1f %9.1f%%\n", art_names[effect], "all", "", "",
+			fixed_total, adaptive_total, (1.0 - adaptive_total / fixed_total) * 100.0);
+	}
+	stub_set_base_size(1920, 1080);
+}
+
+// Background only, the way render() picks the path
+static bool draw_background(lowerthirds_source *context, float width, float height)
+{
+	if (context->draw_gradient_lut(width, height, 1.0f))
+		return true;
+	struct vec4 first, last;
+	vec4_from_rgba(&first, context->gradient_stops[0]);
+	vec4_from_rgba(&last, context->gradient_stops[context->gradient_stop_count - 1]);
+	context->draw_gradient_rect(0.0f, 0.0f, width, height, first, last, context->gradient_type);
+	return false;
+}
+
+// Returns the number of failed checks
+static int run_gradient_check(const bench_options &base)
+{
+	static const int stop_counts[] = {2, 3, 5, 8};
+	static const GradientType types[] = {
+		GRADIENT_HORIZONTAL, GRADIENT_DIAGONAL_TL_BR, GRADIENT_ANGLE, GRADIENT_RADIAL
+	};
+	const float width = 1920.0f, height = 120.0f;
+	int failures = 0;
+
+	printf("# gradients: one draw per frame, stops baked once per settings change\n");
+	printf("%-11s %5s %-6s %8s %8s %8s %8s %-6s\n",
+		"gradient", "stops", "path", "draws", "params", "bakes", "rebakes", "result");
+
+	for (GradientType type : types) {
+		for (int stops : stop_counts) {
+			obs_data_t *settings = make_settings(base, ANIM_INSTANT, ART_NONE, type);
+			obs_data_set_int(settings, "gradient_stop_count", stops);
+			obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", "gradient", settings);
+			obs_data_release(settings);
+			lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+
+			stub_reset_counters();
+			bool lut = false;
+			for (int frame = 0; frame < base.frames; frame++)
+				lut = draw_background(context, width, height);
+			bool ok = stub_check_balanced();
+			stub_counters c = stub_get_counters();
+			const uint64_t draws = c.sprite_draws + c.render_stops + c.buffer_draws;
+			const uint64_t bakes = c.texture_creates;
+			ok = ok && draws == (uint64_t)base.frames && c.effect_loops == (uint64_t)base.frames;
+			ok = ok && lut == (stops > 2 || type == GRADIENT_RADIAL) && bakes == (lut ? 1u : 0u);
+
+			// A stop color change rebakes exactly once
+			obs_data_t *change = obs_data_create();
+			obs_data_set_int(change, "gradient_color2", 0xFF00FF00);
+			obs_source_update(source, change);
+			obs_data_release(change);
+			stub_reset_counters();
+			for (int frame = 0; frame < base.frames; frame++)
+				draw_background(context, width, height);
+			const uint64_t rebakes = stub_get_counters().texture_creates;
+			ok = ok && rebakes == (lut ? 1u : 0u);
+
+			printf("%-11s %5d %-6s %8.1f %8.1f %8llu %8llu %-6s\n", gradient_names[type], stops,
+				lut ? "lut" : "vertex", (double)draws / base.frames,
+				(double)c.param_sets / base.frames, (unsigned long long)bakes,
+				(unsigned long long)rebakes, ok ? "ok" : "FAIL");
+			if (!ok)
+				failures++;
+			obs_source_release(source);
+		}
+	}
+
+	// Without the effect file a multi-stop gradient still draws (two colors)
+	stub_set_data_dir(nullptr);
+	obs_data_t *settings = make_settings(base, ANIM_INSTANT, ART_NONE, GRADIENT_RADIAL);
+	obs_data_set_int(settings, "gradient_stop_count", 5);
+	obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", "fallback", settings);
+	obs_data_release(settings);
+	lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+	stub_reset_counters();
+	bool lut = draw_background(context, width, height);
+	const stub_counters &c = stub_get_counters();
+	bool ok = stub_check_balanced() && !lut && c.render_stops == 1 && c.texture_creates == 0;
+	printf("%-11s %5d %-6s %8llu %8s %8s %8s %-6s\n", "fallback", 5, "vertex",
+		(unsigned long long)c.render_stops, "", "", "", ok ? "ok" : "FAIL");
+	if (!ok)
+		failures++;
+	obs_source_release(source);
+	stub_set_data_dir(LOWERTHIRDS_DATA_DIR);
+
+	printf("\n");
+	return failures;
+}
+
+static double update_path_ms(obs_source_t *source, const char *key, const char *path)
+{
+	obs_data_t *change = obs_data_create();
+	obs_data_set_string(change, key, path);
+	uint64_t start = os_gettime_ns();
+	obs_source_update(source, change);
+	double ms = (double)(os_gettime_ns() - start) / 1000000.0;
+	obs_data_release(change);
+	return ms;
+}
+
+// Renders until the background image pointer changes; returns ms waited
+static double wait_for_swap(lowerthirds_source *context, double timeout_ms)
+{
+	shared_image *before = context->bg_image;
+	uint64_t start = os_gettime_ns();
+	double waited = 0.0;
+	while (context->bg_image == before && waited < timeout_ms) {
+		context->render();
+		os_sleep_ms(1);
+		waited = (double)(os_gettime_ns() - start) / 1000000.0;
+	}
+	return waited;
+}
+
+// The stub never reads pixels, but the cache keys on a real file's stat
+static std::string write_image_file(const std::string &dir, const char *name, size_t bytes)
+{
+	std::string path = dir + "/" + name;
+	FILE *file = fopen(path.c_str(), "wb");
+	if (file) {
+		for (size_t i = 0; i < bytes; i++)
+			fputc((int)(i & 0xFF), file);
+		fclose(file);
+	}
+	return path;
+}
+
+// Returns the number of failed checks
+static int run_image_check(const bench_options &base)
+{
+	const uint32_t decode_ms = 50;
+	int failures = 0;
+	stub_set_image_decode_ms(decode_ms);
+
+	char dir_template[] = "/tmp/lowerthirds-images-XXXXXX";
+	const char *dir_name = mkdtemp(dir_template);
+	if (!dir_name) {
+		printf("images: could not create a temporary directory\n");
+		return 1;
+	}
+	const std::string dir = dir_name;
+	const std::string image_a = write_image_file(dir, "a.png", 100);
+	const std::string image_b = write_image_file(dir, "b.png", 200);
+	const std::string image_c = write_image_file(dir, "c.png", 300);
+	const std::string image_d = write_image_file(dir, "d.png", 400);
+	const std::string logo = write_image_file(dir, "logo.png", 500);
+
+	obs_data_t *settings = make_settings(base, ANIM_INSTANT, ART_NONE, GRADIENT_NONE);
+	obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", "images", settings);
+	obs_data_release(settings);
+	lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+	wait_for_swap(context, 100.0);          // The initial empty path
+
+	printf("# images: %u ms simulated decode, off the update thread\n", decode_ms);
+	printf("%-22s %10s %10s %8s %8s %-6s\n", "case", "update ms", "swap ms", "decodes", "uploads", "result");
+
+	// One change: update() returns at once, the image arrives a decode later
+	stub_reset_counters();
+	uint64_t decodes = stub_image_decodes();
+	double update_ms = update_path_ms(source, "bg_image", image_a.c_str());
+	bool kept_old = context->bg_image == nullptr;
+	double swap_ms = wait_for_swap(context, 2000.0);
+	decodes = stub_image_decodes() - decodes;
+	uint64_t uploads = stub_get_counters().texture_creates;
+	bool ok = update_ms < decode_ms / 5.0 && kept_old && context->bg_image &&
+		context->bg_image->texture() && decodes == 1 && uploads == 1;
+	printf("%-22s %10.3f %10.1f %8llu %8llu %-6s\n", "single change", update_ms, swap_ms,
+		(unsigned long long)decodes, (unsigned long long)uploads, ok ? "ok" : "FAIL");
+	failures += ok ? 0 : 1;
+
+	// Three changes mid-decode: only the last path is ever uploaded, and
+	// the previous image stays until it is
+	stub_reset_counters();
+	decodes = stub_image_decodes();
+	shared_image *previous = context->bg_image;
+	update_ms = update_path_ms(source, "bg_image", image_b.c_str());
+	os_sleep_ms(decode_ms / 5);
+	update_ms += update_path_ms(source, "bg_image", image_c.c_str());
+	update_ms += update_path_ms(source, "bg_image", image_d.c_str());
+	context->render();
+	kept_old = context->bg_image == previous;
+	swap_ms = wait_for_swap(context, 2000.0);
+	for (int i = 0; i < 10; i++) {          // A stale upload would show up here
+		context->render();
+		os_sleep_ms(decode_ms / 5);
+	}
+	decodes = stub_image_decodes() - decodes;
+	uploads = stub_get_counters().texture_creates;
+	ok = update_ms < decode_ms / 5.0 && kept_old && context->bg_image && decodes == 2 && uploads == 1;
+	printf("%-22s %10.3f %10.1f %8llu %8llu %-6s\n", "superseded changes", update_ms, swap_ms,
+		(unsigned long long)decodes, (unsigned long long)uploads, ok ? "ok" : "FAIL");
+	failures += ok ? 0 : 1;
+
+	// Clearing the path removes the image on the next frame
+	update_ms = update_path_ms(source, "bg_image", "");
+	context->render();
+	ok = context->bg_image == nullptr;
+	printf("%-22s %10.3f %10s %8s %8s %-6s\n", "cleared", update_ms, "", "", "", ok ? "ok" : "FAIL");
+	failures += ok ? 0 : 1;
+
+	// Destroying mid-decode waits for the worker and leaks nothing
+	update_path_ms(source, "logo_image", logo.c_str());
+	uint64_t start = os_gettime_ns();
+	obs_source_release(source);
+	size_t entries, textures;
+	image_cache_stats(&entries, &textures);
+	ok = entries == 0;
+	printf("%-22s %10.3f %10s %8s %8s %-6s\n", "destroy mid-decode",
+		(double)(os_gettime_ns() - start) / 1000000.0, "", "", "", ok ? "ok" : "FAIL");
+	failures += ok ? 0 : 1;
+
+	// Many sources with the same plate and logo share one decode and one
+	// texture each; the cache empties with the last source
+	const int num_sources = 30;
+	obs_source_t *sources[num_sources];
+	stub_reset_counters();
+	decodes = stub_image_decodes();
+	for (int i = 0; i < num_sources; i++) {
+		settings = make_settings(base, ANIM_INSTANT, ART_NONE, GRADIENT_NONE);
+		obs_data_set_string(settings, "bg_image", image_a.c_str());
+		obs_data_set_string(settings, "logo_image", logo.c_str());
+		sources[i] = obs_source_create_private("lowerthirds_plus_source", "shared", settings);
+		obs_data_release(settings);
+	}
+	for (int i = 0; i < num_sources; i++) {
+		lowerthirds_source *ctx = (lowerthirds_source *)obs_obj_get_data(sources[i]);
+		for (int tries = 0; tries < 2000 && (!ctx->bg_image || !ctx->logo_image); tries++) {
+			ctx->render();
+			os_sleep_ms(1);
+		}
+	}
+	decodes = stub_image_decodes() - decodes;
+	uploads = stub_get_counters().texture_creates;
+	image_cache_stats(&entries, &textures);
+	ok = decodes == 2 && uploads == 2 && entries == 2 && textures == 2;
+
+	// An edited file (new size) is a new entry for sources that reload it
+	write_image_file(dir, "a.png", 150);
+	update_path_ms(sources[0], "bg_image", "");
+	update_path_ms(sources[0], "bg_image", image_a.c_str());
+	lowerthirds_source *first = (lowerthirds_source *)obs_obj_get_data(sources[0]);
+	first->render();
+	wait_for_swap(first, 2000.0);
+	size_t edited_entries;
+	image_cache_stats(&edited_entries, &textures);
+	ok = ok && edited_entries == 3;
+
+	for (int i = 0; i < num_sources; i++)
+		obs_source_release(sources[i]);
+	size_t left;
+	image_cache_stats(&left, &textures);
+	ok = ok && left == 0;
+	printf("%-22s %10s %10s %8llu %8llu %-6s\n", "30 sources, 2 images", "", "",
+		(unsigned long long)decodes, (unsigned long long)uploads, ok ? "ok" : "FAIL");
+	failures += ok ? 0 : 1;
+
+	for (const std::string &path : {image_a, image_b, image_c, image_d, logo})
+		unlink(path.c_str());
+	rmdir(dir.c_str());
+	stub_set_image_decode_ms(0);
+	printf("\n");
+	return failures;
+}
+
+// RGBA ramp with a transparent border, like the stub's decode
+static std::vector<uint8_t> make_test_image(uint32_t cx, uint32_t cy)
+{
+	std::vector<uint8_t> pixels((size_t)cx * cy * 4);
+	for (uint32_t y = 0; y < cy; y++) {
+		for (uint32_t x = 0; x < cx; x++) {
+			uint8_t *p = &pixels[((size_t)y * cx + x) * 4];
+			// Premultiplied, as gs_image_file_init() decodes
+			uint32_t a = x < cx / 16 || y < cy / 16 ? 0 : 128 + (x + y) % 128;
+			p[0] = (uint8_t)(x * 255 / cx * a / 255);
+			p[1] = (uint8_t)(y * 255 / cy * a / 255);
+			p[2] = (uint8_t)(((x ^ y) & 0xFF) * a / 255);
+			p[3] = (uint8_t)a;
+		}
+	}
+	return pixels;
+}
+
+static double downscale_ms(const std::vector<uint8_t> &src, uint32_t sw, uint32_t sh, std::vector<uint8_t> &dst,
+	uint32_t dw, uint32_t dh, art_kernel_isa isa)
+{
+	art_kernel_set_isa(isa);
+	dst.assign((size_t)dw * dh * 4, 0);
+	uint64_t start = os_gettime_ns();
+	image_downscale(src.data(), sw, sh, dst.data(), dw, dh);
+	return (double)(os_gettime_ns() - start) / 1000000.0;
+}
+
+// Texture bytes including the mip chain
+static double texture_mb(gs_texture_t *tex)
+{
+	uint32_t cx = gs_texture_get_width(tex), cy = gs_texture_get_height(tex);
+	double bytes = 0.0;
+	for (uint32_t l = 0; l < stub_texture_levels(tex); l++) {
+		bytes += (double)cx * cy * 4.0;
+		cx = cx > 1 ? cx / 2 : 1;
+		cy = cy > 1 ? cy / 2 : 1;
+	}
+	return bytes / (1024.0 * 1024.0);
+}
+
+// Returns the number of failed checks
+static int run_resample_check(const bench_options &base)
+{
+	int failures = 0;
+	const art_kernel_isa best = art_kernel_get_isa();
+
+	struct resample_case {
+		const char *name;
+		uint32_t sw, sh, dw, dh;
+	};
+	const resample_case cases[] = {
+		{"8K plate -> 1080p", 7680, 4320, 1920, 1080},
+		{"4K plate -> bar", 3840, 2160, 1920, 200},
+		{"4K logo -> 140", 4096, 4096, 140, 140},
+		{"odd ratio", 1001, 777, 333, 259},
+	};
+
+	printf("# resample: area filter, scalar vs %s\n", best >= ART_KERNEL_SSE2 ? "sse2" : "scalar");
+	printf("%-20s %12s %10s %10s %8s %-6s\n", "case", "output", "scalar ms", "simd ms", "max err", "result");
+	for (const resample_case &rc : cases) {
+		std::vector<uint8_t> src = make_test_image(rc.sw, rc.sh), ref, out;
+		double scalar_ms = downscale_ms(src, rc.sw, rc.sh, ref, rc.dw, rc.dh, ART_KERNEL_SCALAR);
+		double simd_ms = downscale_ms(src, rc.sw, rc.sh, out, rc.dw, rc.dh, best);
+		int max_err = 0;
+		for (size_t i = 0; i < ref.size(); i++)
+			max_err = std::max(max_err, std::abs((int)ref[i] - (int)out[i]));
+
+		// The transparent border stays transparent, without dark fringes
+		bool border_clear = out[3] == 0 && out[0] == 0;
+		char size[32];
+		snprintf(size, sizeof(size), "%ux%u", rc.dw, rc.dh);
+		bool ok = max_err <= 1 && border_clear;
+		printf("%-20s %12s %10.2f %10.2f %8d %-6s\n", rc.name, size, scalar_ms, simd_ms, max_err,
+			ok ? "ok" : "FAIL");
+		failures += ok ? 0 : 1;
+	}
+	art_kernel_set_isa(best);
+
+	// A flat opaque image keeps its exact color at any ratio
+	std::vector<uint8_t> flat((size_t)997 * 613 * 4), flat_out((size_t)101 * 67 * 4);
+	for (size_t i = 0; i < flat.size(); i += 4) {
+		flat[i] = 200;
+		flat[i + 1] = 100;
+		flat[i + 2] = 50;
+		flat[i + 3] = 255;
+	}
+	image_downscale(flat.data(), 997, 613, flat_out.data(), 101, 67);
+	bool flat_ok = true;
+	for (size_t i = 0; i < flat_out.size(); i += 4)
+		flat_ok = flat_ok && flat_out[i] == 200 && flat_out[i + 1] == 100 && flat_out[i + 2] == 50 &&
+			flat_out[i + 3] == 255;
+	printf("%-20s %12s %10s %10s %8s %-6s\n", "flat color", "101x67", "", "", "", flat_ok ? "ok" : "FAIL");
+	failures += flat_ok ? 0 : 1;
+
+	// Opaque red against half-transparent red: premultiplied pixels that
+	// straddle the edge keep rgb == alpha (no bright fringe), on every path
+	std::vector<uint8_t> edge((size_t)64 * 64 * 4), edge_out((size_t)3 * 3 * 4);
+	for (size_t i = 0; i < edge.size(); i += 4) {
+		uint8_t a = (i / 4) % 64 < 32 ? 255 : 128;
+		edge[i] = a;
+		edge[i + 1] = 0;
+		edge[i + 2] = 0;
+		edge[i + 3] = a;
+	}
+	bool edge_ok = true;
+	for (int isa = ART_KERNEL_SCALAR; isa <= (int)best; isa++) {
+		art_kernel_set_isa((art_kernel_isa)isa);
+		image_downscale(edge.data(), 64, 64, edge_out.data(), 3, 3);
+		for (size_t i = 0; i < edge_out.size(); i += 4)
+			edge_ok = edge_ok && std::abs((int)edge_out[i] - (int)edge_out[i + 3]) <= 1 &&
+				edge_out[i + 1] == 0 && edge_out[i + 2] == 0;
+	}
+	art_kernel_set_isa(best);
+	std::vector<uint8_t> edge_mips(image_mip_size(64, 64, image_mip_levels(64, 64)));
+	image_build_mips(edge.data(), 64, 64, image_mip_levels(64, 64), edge_mips.data());
+	for (size_t i = 0; i < edge_mips.size(); i += 4)
+		edge_ok = edge_ok && std::abs((int)edge_mips[i] - (int)edge_mips[i + 3]) <= 1;
+	printf("%-20s %12s %10s %10s %8s %-6s\n", "transparent edge", "3x3", "", "", "", edge_ok ? "ok" : "FAIL");
+	failures += edge_ok ? 0 : 1;
+
+	// Source end to end: 8K background and 4K logo on a 1080p and a 2160p
+	// canvas (headroom 2)
+	char dir_template[] = "/tmp/lowerthirds-resample-XXXXXX";
+	const char *dir_name = mkdtemp(dir_template);
+	if (!dir_name) {
+		printf("resample: could not create a temporary directory\n");
+		return failures + 1;
+	}
+	const std::string dir = dir_name;
+	const std::string plate = write_image_file(dir, "plate.png", 100);
+	const std::string logo = write_image_file(dir, "logo.png", 200);
+
+	printf("\n%-20s %12s %12s %7s %10s %-6s\n", "canvas", "background", "logo", "levels", "VRAM MB", "result");
+	const uint32_t canvas_heights[] = {1080, 2160};
+	for (uint32_t canvas_cy : canvas_heights) {
+		stub_set_base_size(canvas_cy * 16 / 9, canvas_cy);
+		obs_data_t *settings = make_settings(base, ANIM_INSTANT, ART_NONE, GRADIENT_NONE);
+		obs_data_set_int(settings, "bar_height", 200);
+		obs_data_set_int(settings, "logo_size", 140);
+		obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", "resample", settings);
+		obs_data_release(settings);
+		lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+
+		stub_set_image_size(7680, 4320);
+		update_path_ms(source, "bg_image", plate.c_str());
+		wait_for_swap(context, 5000.0);
+		stub_set_image_size(4096, 4096);
+		update_path_ms(source, "logo_image", logo.c_str());
+		for (int tries = 0; tries < 5000 && !context->logo_image; tries++) {
+			context->render();
+			os_sleep_ms(1);
+		}
+
+		gs_texture_t *bg = context->bg_image ? context->bg_image->texture() : nullptr;
+		gs_texture_t *lg = context->logo_image ? context->logo_image->texture() : nullptr;
+		uint32_t headroom = canvas_cy / 1080;
+		bool ok = bg && lg && gs_texture_get_width(bg) == 1920 * headroom &&
+			gs_texture_get_height(bg) == 200 * headroom && stub_texture_levels(bg) == 1 &&
+			gs_texture_get_width(lg) == 140 * headroom && gs_texture_get_height(lg) == 140 * headroom &&
+			stub_texture_levels(lg) == image_mip_levels(140 * headroom, 140 * headroom) &&
+			!context->bg_image->image.texture_data && !context->logo_image->image.texture_data;
+
+		// Full-resolution uploads would have been 8K + 4K without mips
+		double fitted_mb = bg && lg ? texture_mb(bg) + texture_mb(lg) : 0.0;
+		double full_mb = (7680.0 * 4320.0 + 4096.0 * 4096.0) * 4.0 / (1024.0 * 1024.0);
+		char canvas[32], bg_size[32], logo_size[32], vram[32];
+		snprintf(canvas, sizeof(canvas), "%up", canvas_cy);
+		snprintf(bg_size, sizeof(bg_size), "%ux%u", gs_texture_get_width(bg), gs_texture_get_height(bg));
+		snprintf(logo_size, sizeof(logo_size), "%ux%u", gs_texture_get_width(lg), gs_texture_get_height(lg));
+		snprintf(vram, sizeof(vram), "%.1f/%.0f", fitted_mb, full_mb);
+		printf("%-20s %12s %12s %7u %10s %-6s\n", canvas, bg_size, logo_size, stub_texture_levels(lg), vram,
+			ok ? "ok" : "FAIL");
+		failures += ok ? 0 : 1;
+		obs_source_release(source);
+	}
+	stub_set_base_size(1920, 1080);
+	stub_set_image_size(64, 64);
+
+	unlink(plate.c_str());
+	unlink(logo.c_str());
+	rmdir(dir.c_str());
+	printf("\n");
+	return failures;
+}
+
+// Applies `count` setting changes of one kind, as the properties view does
+// on every slider step or checkbox
+static void apply_changes(obs_source_t *source, const char *name, int count)
+{
+	for (int i = 0; i < count; i++) {
+		obs_data_t *change = obs_data_create();
+		if (strcmp(name, "art_speed drag") == 0) {
+			obs_data_set_double(change, "art_speed", 10.0 + i);
+		} else if (strcmp(name, "hide/show") == 0) {
+			obs_data_set_bool(change, "visible", i % 2 != 0);
+		} else if (strcmp(name, "title edit") == 0) {
+			obs_data_set_string(change, "profile1_title", "Breaking News");
+		} else if (strcmp(name, "title size") == 0) {
+			obs_data_set_int(change, "title_size", 80);
+		} else if (strcmp(name, "text color") == 0) {
+			obs_data_set_int(change, "text_color", 0xFF00FFFF);
+		} else if (strcmp(name, "right title") == 0) {
+			obs_data_set_string(change, "profile1_title_right", "Studio B");
+		} else if (strcmp(name, "right title clear") == 0) {
+			obs_data_set_string(change, "profile1_title_right", "");
+		} else if (strcmp(name, "profile switch") == 0) {
+			// What the Play Profile buttons do
+			lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+			context->select_profile((i + 1) % 5);
+			obs_data_release(change);
+			continue;
+		}
+		obs_source_update(source, change);
+		obs_data_release(change);
+	}
+}
+
+// Returns the number of failed checks
+static int run_text_update_check(const bench_options &base)
+{
+	int failures = 0;
+	stub_reset_counters();
+	obs_data_t *settings = make_settings(base, ANIM_INSTANT, ART_PARTICLES, GRADIENT_NONE);
+	obs_data_set_string(settings, "profile1_title", "John Doe");
+	obs_data_set_string(settings, "profile1_subtitle", "Senior Producer");
+	obs_data_set_string(settings, "profile2_title", "Jane Smith");
+	obs_data_set_string(settings, "profile2_subtitle", "Weather");
+	obs_data_set_string(settings, "profile3_title", "Breaking News");
+	obs_data_set_string(settings, "profile3_subtitle", "Live from the city hall press conference");
+	obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", "text", settings);
+	obs_data_release(settings);
+	lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+
+	printf("# text updates: obs_source_update calls reaching the text sources of non-empty slots\n");
+	printf("%-20s %8s %8s %8s %-6s\n", "change", "changes", "sent", "skipped", "result");
+
+	struct text_case {
+		const char *name;
+		int changes;
+		uint64_t expect_sent;       // Text sources whose settings differ
+	};
+	const text_case cases[] = {
+		{"create", 0, 12},         // Only profile 1 has right-side strings
+		{"art_speed drag", 20, 0},
+		{"hide/show", 10, 0},
+		{"title edit", 1, 1},
+		{"title size", 1, 6},      // Left and right titles that are set
+		{"text color", 1, 12},
+		{"right title", 1, 1},     // Gets a source
+		{"right title clear", 1, 0}, // Loses it
+		{"auto-hide", 0, 0},
+		{"profile switch", 5, 0},
+	};
+	for (const text_case &tc : cases) {
+		uint64_t sent = stub_get_counters().source_updates;
+		uint64_t skipped = context->text_updates_skipped;
+		if (strcmp(tc.name, "create") == 0) {
+			sent = 0;
+			skipped = 0;
+		} else if (strcmp(tc.name, "auto-hide") == 0) {
+			// tick() writes visible = false back through update()
+			obs_data_t *change = obs_data_create();
+			obs_data_set_bool(change, "auto_hide", true);
+			obs_data_set_double(change, "duration", 0.5);
+			obs_data_set_bool(change, "visible", true);
+			obs_source_update(source, change);
+			obs_data_release(change);
+			sent = stub_get_counters().source_updates;
+			for (int frame = 0; frame < 60 && context->is_visible; frame++)
+				context->tick(1.0f / 60.0f);
+		} else {
+			apply_changes(source, tc.name, tc.changes);
+		}
+		sent = stub_get_counters().source_updates - sent;
+		skipped = context->text_updates_skipped - skipped;
+		bool ok = sent == tc.expect_sent;
+		if (strcmp(tc.name, "auto-hide") == 0)
+			ok = ok && !context->is_visible;
+		if (strcmp(tc.name, "right title") == 0)
+			ok = ok && context->profile_text_sources[0][2] != nullptr;
+		if (strcmp(tc.name, "right title clear") == 0)
+			ok = ok && context->profile_text_sources[0][2] == nullptr && context->slot_metrics(2).width == 0;
+		if (strcmp(tc.name, "profile switch") == 0)
+			ok = ok && context->current_profile == 0 && context->title_text_source == context->profile_text_sources[0][0];
+		printf("%-20s %8d %8llu %8llu %-6s\n", tc.name, tc.changes, (unsigned long long)sent,
+			(unsigned long long)skipped, ok ? "ok" : "FAIL");
+		failures += ok ? 0 : 1;
+	}
+
+	bool ok = context->text_updates_performed == stub_get_counters().source_updates;
+	printf("%-20s %8s %8llu %8llu %-6s\n", "total", "", (unsigned long long)context->text_updates_performed,
+		(unsigned long long)context->text_updates_skipped, ok ? "ok" : "FAIL");
+	failures += ok ? 0 : 1;
+
+	// Each profile's strings are measured before it is ever shown
+	printf("\n%-10s %12s %12s %10s %-6s\n", "profile", "title", "subtitle", "text KB", "result");
+	size_t total_bytes = 0;
+	for (int p = 0; p < 5; p++) {
+		context->select_profile(p);
+		uint32_t title_cx = obs_source_get_width(context->title_text_source);
+		uint32_t subtitle_cx = obs_source_get_width(context->subtitle_text_source);
+		size_t bytes = context->profile_text_bytes(p);
+		total_bytes += bytes;
+		// Profiles 4 and 5 show the defaults; only non-empty strings have a
+		// source, each with its own glyph cache
+		const char *strings[4] = {context->title[p], context->subtitle[p], context->title_right[p],
+			context->subtitle_right[p]};
+		size_t sources = 0;
+		for (const char *text : strings)
+			sources += text && *text ? 1 : 0;
+		ok = title_cx > 0 && subtitle_cx > 0 && bytes == sources * TEXT_FT2_TEXBUF_SIZE * TEXT_FT2_TEXBUF_SIZE * 2;
+		char name[16], title_size[16], subtitle_size[16];
+		snprintf(name, sizeof(name), "%d", p + 1);
+		snprintf(title_size, sizeof(title_size), "%ux%u", title_cx, obs_source_get_height(context->title_text_source));
+		snprintf(subtitle_size, sizeof(subtitle_size), "%ux%u", subtitle_cx,
+			obs_source_get_height(context->subtitle_text_source));
+		printf("%-10s %12s %12s %10.1f %-6s\n", name, title_size, subtitle_size, bytes / 1024.0, ok ? "ok" : "FAIL");
+		failures += ok ? 0 : 1;
+	}
+	printf("%-10s %12s %12s %10.1f\n", "all", "", "", total_bytes / 1024.0);
+	obs_source_release(source);
+	printf("\n");
+	return failures;
+}
+
+static obs_source_t *make_text_source(const bench_options &opts, const char *name, bool glyph_text)
+{
+	obs_data_t *settings = make_settings(opts, ANIM_INSTANT, ART_NONE, GRADIENT_NONE);
+	obs_data_t *font = obs_data_create();
+	obs_data_set_string(font, "face", opts.font);
+	obs_data_set_obj(settings, "font_face", font);
+	obs_data_release(font);
+	obs_data_set_bool(settings, "glyph_text", glyph_text);
+	obs_data_set_string(settings, "profile1_title", "John Doe");
+	obs_data_set_string(settings, "profile1_subtitle", "Senior Producer");
+	obs_source_t *source = obs_source_create_private("lowerthirds_plus_source", name, settings);
+	obs_data_release(settings);
+	return source;
+}
+
+static uint32_t layout_width(glyph_font *font, const char *text)
+{
+	text_layout layout;
+	glyph_layout(font, text, layout);
+	return layout.width;
+}
+
+static void update_setting(obs_source_t *source, const char *name, long long value)
+{
+	obs_data_t *change = obs_data_create();
+	obs_data_set_int(change, name, value);
+	obs_source_update(source, change);
+	obs_data_release(change);
+}
+
+// Returns the number of failed checks
+static int run_glyph_check(const bench_options &base)
+{
+	int failures = 0;
+	glyph_atlas_add_font_dir(base.font_dir);
+	glyph_font *font = glyph_font_acquire(base.font, 48, 0);
+	if (!font) {
+		printf("# glyphs: no font file for \"%s\" (FreeType missing, or pass --font and --font-dir)\nFAIL\n",
+			base.font);
+		return 1;
+	}
+
+	printf("# glyph layout: %s 48px\n", base.font);
+	printf("%-34s %10s %10s %-6s\n", "check", "got", "expected", "result");
+	auto report = [&failures](const char *name, double got, double expected, bool ok) {
+		printf("%-34s %10.0f %10.0f %-6s\n", name, got, expected, ok ? "ok" : "FAIL");
+		failures += ok ? 0 : 1;
+	};
+	// Pass/fail rows and bounds: no single expected value to print
+	auto check = [&failures](const char *name, const char *got, const char *expected, bool ok) {
+		printf("%-34s %10s %10s %-6s\n", name, got, expected, ok ? "ok" : "FAIL");
+		failures += ok ? 0 : 1;
+	};
+
+	text_layout one, two, empty;
+	glyph_layout(font, "Hello", one);
+	glyph_layout(font, "Hello\nHello", two);
+	glyph_layout(font, "", empty);
+	report("quads for \"Hello\"", (double)one.quads.size(), 5, one.quads.size() == 5);
+	report("second line doubles the height", two.height, one.height * 2.0, two.height == one.height * 2);
+	report("second line keeps the width", two.width, one.width, two.width == one.width);
+	report("empty string is empty", empty.width + empty.height, 0,
+		empty.width == 0 && empty.height == 0 && empty.quads.empty());
+	uint32_t word = layout_width(font, "Hello");
+	uint32_t longer = layout_width(font, "Hello, World");
+	report("longer string is wider", longer, word, longer > word);
+	uint32_t pair = layout_width(font, "AV");
+	uint32_t apart = layout_width(font, "A") + layout_width(font, "V");
+	report("kerned pair no wider than apart", pair, apart, pair <= apart);
+
+	glyph_atlas_stats before, after;
+	glyph_atlas_get_stats(&before);
+	glyph_layout(font, "Hello, World", one);
+	glyph_atlas_get_stats(&after);
+	report("relayout rasterizes nothing", (double)(after.rasterized - before.rasterized), 0,
+		after.rasterized == before.rasterized);
+	glyph_font_release(font);
+
+	// 30 sources with the same fonts: one glyph_font per key and each glyph
+	// rasterized once, by whichever source laid it out first
+	stub_check_balanced();
+	stub_reset_counters();
+	std::vector<obs_source_t *> sources;
+	sources.push_back(make_text_source(base, "glyphs 1", true));
+	glyph_atlas_get_stats(&before);
+	for (int i = 1; i < 30; i++) {
+		char name[32];
+		snprintf(name, sizeof(name), "glyphs %d", i + 1);
+		sources.push_back(make_text_source(base, name, true));
+	}
+	glyph_atlas_get_stats(&after);
+	lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(sources[0]);
+
+	printf("\n# 30 sources sharing the atlas\n");
+	printf("%-34s %10s %10s %-6s\n", "check", "got", "expected", "result");
+	check("built-in text in use", context->use_glyph_text ? "yes" : "no", "", context->use_glyph_text);
+	report("fonts (bold title, subtitle)", (double)after.fonts, 2, after.fonts == 2);
+	report("glyphs rasterized by 29 more", (double)(after.rasterized - before.rasterized), 0,
+		after.rasterized == before.rasterized);
+	report("text sources updated", (double)stub_get_counters().source_updates, 0,
+		stub_get_counters().source_updates == 0);
+
+	// Color is per vertex: a color-only change lays nothing out again
+	uint64_t performed = context->text_updates_performed;
+	glyph_atlas_get_stats(&before);
+	apply_changes(sources[0], "text color", 1);
+	glyph_atlas_get_stats(&after);
+	report("re-layouts for a color change", (double)(context->text_updates_performed - performed), 0,
+		context->text_updates_performed == performed && after.rasterized == before.rasterized);
+
+	// One settled frame's text: every string and shadow in one buffer draw,
+	// against a render per string plus a cached shadow quad each for the
+	// text sources
+	obs_source_t *fallback = make_text_source(base, "glyphs fallback", false);
+	lowerthirds_source *fallback_context = (lowerthirds_source *)obs_obj_get_data(fallback);
+	uint64_t draws[2], renders[2];
+	lowerthirds_source *contexts[2] = {context, fallback_context};
+	for (int m = 0; m < 2; m++) {
+		contexts[m]->text_shadow_enabled = true;
+		contexts[m]->tick(1.0f);
+		contexts[m]->render();
+		contexts[m]->tick(1.0f);
+		stub_reset_counters();
+		contexts[m]->render();
+		const stub_counters &c = stub_get_counters();
+		draws[m] = c.render_stops + c.buffer_draws + c.sprite_draws;
+		renders[m] = c.source_renders;
+	}
+	const uint64_t fallback_shadows = 4;
+	report("text draws with shadows", (double)draws[0] - (double)(draws[1] - fallback_shadows), 1,
+		draws[0] + fallback_shadows == draws[1] + 1);
+	report("text source renders", (double)renders[0], 0, renders[0] == 0);
+	report("text source renders (fallback)", (double)renders[1], 4, renders[1] == 4);
+	bool balanced = stub_check_balanced();
+	check("balanced graphics state", balanced ? "yes" : "no", "", balanced);
+
+	glyph_atlas_get_stats(&before);
+	stub_reset_counters();
+	context->render();
+	glyph_atlas_get_stats(&after);
+	report("atlas uploads on a settled frame", (double)(after.uploads - before.uploads), 0,
+		after.uploads == before.uploads && stub_get_counters().texture_creates == 0);
+
+	// A title size drag rasterizes every size it passes through; once the
+	// atlas is full it is repacked and every source lays its text out again.
+	// Sizes past the slider's range fill the atlas in one drag.
+	lowerthirds_source *other = (lowerthirds_source *)obs_obj_get_data(sources[1]);
+	size_t title_quads = context->glyph_layouts[0][0].quads.size();
+	glyph_atlas_get_stats(&before);
+	for (int size = 100; size <= 400; size += 4)
+		update_setting(sources[0], "title_size", size);
+	other->tick(1.0f);
+	other->render();
+	glyph_atlas_get_stats(&after);
+	char got[32];
+	snprintf(got, sizeof(got), "%llu", (unsigned long long)(after.repacks - before.repacks));
+	check("atlas repacks during a size drag", got, "> 0", after.repacks > before.repacks);
+	report("title glyphs drawn after the drag", (double)context->glyph_layouts[0][0].quads.size(),
+		(double)title_quads, context->glyph_layouts[0][0].quads.size() == title_quads);
+	text_layout fresh;
+	glyph_layout(other->glyph_fonts[0], other->title[0], fresh);
+	const text_layout &kept = other->glyph_layouts[0][0];
+	bool relaid = kept.quads.size() == fresh.quads.size();
+	for (size_t i = 0; relaid && i < fresh.quads.size(); i++)
+		relaid = kept.quads[i].tx == fresh.quads[i].tx && kept.quads[i].ty == fresh.quads[i].ty;
+	check("other sources relaid", relaid ? "yes" : "no", "", relaid);
+
+	size_t fallback_bytes = 0;
+	for (int p = 0; p < 5; p++)
+		fallback_bytes += fallback_context->profile_text_bytes(p);
+	printf("\n# atlas %ux%u (%.1f KB shared), %zu glyphs, %llu rasterized; text sources: %.1f KB per source\n",
+		after.cx, after.cy, after.cx * after.cy / 1024.0, after.glyphs, (unsigned long long)after.rasterized,
+		fallback_bytes / 1024.0);
+
+	obs_source_release(fallback);
+	for (obs_source_t *source : sources)
+		obs_source_release(source);
+	glyph_atlas_get_stats(&after);
+	report("fonts after the last source", (double)after.fonts, 0, after.fonts == 0);
+	printf("\n");
+	return failures;
+}
+
+static void enable_shadows(obs_source_t *source, int blur)
+{
+	obs_data_t *change = obs_data_create();
+	obs_data_set_bool(change, "text_shadow_enabled", true);
+	obs_data_set_int(change, "text_shadow_blur", blur);
+	obs_source_update(source, change);
+	obs_data_release(change);
+}
+
+// Silhouette render passes (texrender_passes) one frame's render() takes
+static uint64_t shadow_passes(lowerthirds_source *context)
+{
+	context->tick(1.0f / 60.0f);
+	uint64_t passes = stub_get_counters().texrender_passes;
+	context->render();
+	return stub_get_counters().texrender_passes - passes;
+}
+
+// Returns the number of failed checks
+static int run_shadow_check(const bench_options &base)
+{
+	int failures = 0;
+	glyph_atlas_add_font_dir(base.font_dir);
+	glyph_font *font = glyph_font_acquire(base.font, 48, 0);
+	const bool have_font = font != nullptr;
+	glyph_font_release(font);
+
+	printf("# text shadows: 4 strings; passes are silhouette renders (3 per blurred string)\n");
+	printf("%-14s %5s %6s %8s %9s %7s %8s %5s %7s %-6s\n", "text", "blur", "first", "settled",
+		"sources", "draws", "recolor", "edit", "reblur", "result");
+
+	for (int glyph = 0; glyph < 2; glyph++) {
+		if (glyph && !have_font) {
+			printf("%-14s (no font file for \"%s\", pass --font and --font-dir)\n", "built-in", base.font);
+			continue;
+		}
+		for (int blur = 0; blur <= 6; blur += 6) {
+			obs_source_t *source = make_text_source(base, "shadows", glyph != 0);
+			lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+			enable_shadows(source, blur);
+			context->tick(1.0f);
+			stub_check_balanced();
+			stub_reset_counters();
+
+			// Hard shadows on built-in text batch with it and need no cache
+			const bool cached = !glyph || blur > 0;
+			const uint64_t per_string = blur ? 3 : 1;
+			uint64_t first = shadow_passes(context);
+
+			const int frames = 10;
+			stub_reset_counters();
+			uint64_t settled = 0;
+			for (int frame = 0; frame < frames; frame++)
+				settled += shadow_passes(context);
+			const stub_counters &c = stub_get_counters();
+			double sources = (double)c.source_renders / frames;
+			double draws = (double)(c.render_stops + c.buffer_draws + c.sprite_draws) / frames;
+
+			update_setting(source, "text_shadow_color", 0xFF402010);
+			update_setting(source, "text_shadow_offset_x", 6);
+			uint64_t recolor = shadow_passes(context);
+			obs_data_t *change = obs_data_create();
+			obs_data_set_string(change, "profile1_title", "Breaking News");
+			obs_source_update(source, change);
+			obs_data_release(change);
+			uint64_t edit = shadow_passes(context);
+			update_setting(source, "text_shadow_blur", 3);
+			uint64_t reblur = shadow_passes(context);
+
+			bool ok = first == (cached ? 4 * per_string : 0) && settled == 0 && recolor == 0 &&
+				edit == (cached ? per_string : 0) && reblur == 4 * 3 &&
+				sources == (glyph ? 0.0 : 4.0) && stub_check_balanced();
+			printf("%-14s %5d %6llu %8llu %9.1f %7.1f %8llu %5llu %7llu %-6s\n",
+				glyph ? "built-in" : "text sources", blur, (unsigned long long)first,
+				(unsigned long long)settled, sources, draws, (unsigned long long)recolor,
+				(unsigned long long)edit, (unsigned long long)reblur, ok ? "ok" : "FAIL");
+			failures += ok ? 0 : 1;
+			obs_source_release(source);
+		}
+	}
+
+	// Without the effect file the shadows render from the text, as before
+	stub_set_data_dir(nullptr);
+	obs_source_t *source = make_text_source(base, "shadows", false);
+	lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+	enable_shadows(source, 6);
+	context->tick(1.0f);
+	stub_reset_counters();
+	uint64_t passes = shadow_passes(context);
+	bool ok = passes == 0 && stub_get_counters().source_renders == 8 && stub_check_balanced();
+	printf("%-14s %5d %6llu %8s %9llu %7s %8s %5s %7s %-6s\n", "no effect", 6, (unsigned long long)passes,
+		"", (unsigned long long)stub_get_counters().source_renders, "", "", "", "", ok ? "ok" : "FAIL");
+	failures += ok ? 0 : 1;
+	obs_source_release(source);
+	stub_set_data_dir(LOWERTHIRDS_DATA_DIR);
+	printf("\n");
+	return failures;
+}
+
+// Text source size queries one frame's render() makes
+static uint64_t render_size_queries(lowerthirds_source *context)
+{
+	context->tick(1.0f / 60.0f);
+	uint64_t queries = stub_get_counters().source_size_queries;
+	context->render();
+	return stub_get_counters().source_size_queries - queries;
+}
+
+// Returns the number of failed checks
+static int run_text_metrics_check(const bench_options &base)
+{
+	int failures = 0;
+	printf("# text metrics: title, subtitle and highlight boxes from the cache\n");
+	printf("%-38s %10s %10s %-6s\n", "check", "got", "expected", "result");
+	auto report = [&failures](const char *name, double got, double expected, bool ok) {
+		printf("%-38s %10.0f %10.0f %-6s\n", name, got, expected, ok ? "ok" : "FAIL");
+		failures += ok ? 0 : 1;
+	};
+	// Pass/fail rows and bounds: no single expected value to print
+	auto check = [&failures](const char *name, double got, const char *expected, bool ok) {
+		printf("%-38s %10.0f %10s %-6s\n", name, got, expected, ok ? "ok" : "FAIL");
+		failures += ok ? 0 : 1;
+	};
+	auto check_bool = [&failures](const char *name, bool ok) {
+		printf("%-38s %10s %10s %-6s\n", name, ok ? "yes" : "no", "", ok ? "ok" : "FAIL");
+		failures += ok ? 0 : 1;
+	};
+	char bound[32];
+
+	// Text sources that only take a new string at the next source tick, as
+	// in libobs
+	stub_set_text_deferred(true);
+	obs_source_t *source = make_text_source(base, "metrics", false);
+	lowerthirds_source *context = (lowerthirds_source *)obs_obj_get_data(source);
+	obs_data_t *change = obs_data_create();
+	obs_data_set_bool(change, "text_highlight_enabled", true);
+	obs_data_set_bool(change, "text_shadow_enabled", true);
+	obs_source_update(source, change);
+	obs_data_release(change);
+	stub_tick_sources();
+	context->tick(1.0f);
+	context->tick(1.0f);
+	stub_check_balanced();
+
+	const text_metrics &title = context->slot_metrics(0);
+	check("title measured", title.width, "> 0", title.width > 0 && title.height > 0);
+	report("highlight box is the padded title", title.box_width,
+		title.width + 2.0 * context->text_highlight_padding_horizontal,
+		title.box_width == title.width + 2.0f * context->text_highlight_padding_horizontal &&
+		title.box_x == -(float)context->text_highlight_padding_horizontal);
+
+	stub_reset_counters();
+	uint64_t settled = 0;
+	for (int frame = 0; frame < 10; frame++)
+		settled += render_size_queries(context);
+	report("size queries on settled frames", (double)settled, 0, settled == 0);
+
+	// An edit re-measures in tick() only; until the source has rasterized
+	// the last size stays in use
+	uint32_t old_width = title.width;
+	change = obs_data_create();
+	obs_data_set_string(change, "profile1_title", "Senior Correspondent at Large");
+	obs_source_update(source, change);
+	obs_data_release(change);
+	report("width while rasterizing", title.width, old_width, title.width == old_width);
+	stub_reset_counters();
+	uint64_t edit = render_size_queries(context);
+	report("size queries in render() after an edit", (double)edit, 0, edit == 0);
+	report("width while rasterizing (ticked)", title.width, old_width, title.width == old_width);
+	stub_tick_sources();
+	render_size_queries(context);
+	snprintf(bound, sizeof(bound), "> %u", old_width);
+	check("width once rasterized", title.width, bound, title.width > old_width);
+	report("highlight box follows", title.box_width,
+		title.width + 2.0 * context->text_highlight_padding_horizontal,
+		title.box_width == title.width + 2.0f * context->text_highlight_padding_horizontal);
+	render_size_queries(context);
+	stub_reset_counters();
+	render_size_queries(context);
+	report("re-measures stop after settling", (double)stub_get_counters().source_size_queries, 0,
+		stub_get_counters().source_size_queries == 0);
+
+	// Padding only moves the boxes
+	update_setting(source, "text_highlight_padding_horizontal", 30);
+	render_size_queries(context);
+	report("padding change updates the box", title.box_width, title.width + 60.0,
+		title.box_width == title.width + 60.0f && title.box_x == -30.0f);
+	report("size queries for a padding change", (double)stub_get_counters().source_size_queries, 0,
+		stub_get_counters().source_size_queries == 0);
+	check_bool("balanced graphics state", stub_check_balanced());
+	obs_source_release(source);
+	stub_set_text_deferred(false);
+
+	// Built-in text is measured when it is laid out
+	glyph_atlas_add_font_dir(base.font_dir);
+	glyph_font *font = glyph_font_acquire(base.font, 48, 0);
+	glyph_font_release(font);
+	if (!font) {
+		printf("%-38s (no font file for \"%s\", pass --font and --font-dir)\n", "built-in text", base.font);
+	} else {
+		source = make_text_source(base, "metrics glyphs", true);
+		context = (lowerthirds_source *)obs_obj_get_data(source);
+		const text_metrics &glyph_title = context->slot_metrics(0);
+		const text_layout &layout = context->glyph_layouts[context->current_profile][0];
+		report("built-in width is the layout's", glyph_title.width, layout.width,
+			glyph_title.width == layout.width && glyph_title.height == layout.height);
+		snprintf(bound, sizeof(bound), "< %u", glyph_title.height);
+		check("built-in baseline inside the line", glyph_title.baseline, bound,
+			glyph_title.baseline > 0.0f && glyph_title.baseline < (float)glyph_title.height);
+		report("built-in needs no re-measure", glyph_title.pending_ticks, 0, glyph_title.pending_ticks == 0);
+		stub_reset_counters();
+		render_size_queries(context);
+		report("built-in size queries", (double)stub_get_counters().source_size_queries, 0,
+			stub_get_counters().source_size_queries == 0);
+		obs_source_release(source);
+	}
+	printf("\n");
+	return failures;
+}
+
+int main(int argc, char **argv)
+{
+	bench_options opts;
+	if (!parse_options(argc, argv, opts))
+		return 2;
+
+	stub_set_quiet(true);
+	stub_set_config_dir(opts.cache_dir);
+	stub_set_data_dir(LOWERTHIRDS_DATA_DIR);
+	register_lowerthirds_source();
+
+	if (opts.kernels)
+		return run_kernel_bench() ? 1 : 0;
+	if (opts.particles) {
+		run_particle_bench(opts);
+		return 0;
+	}
+	if (opts.tessellation) {
+		run_tessellation_bench(opts);
+		return 0;
+	}
+	if (opts.gradients)
+		return run_gradient_check(opts) ? 1 : 0;
+	if (opts.images)
+		return run_image_check(opts) ? 1 : 0;
+	if (opts.resample)
+		return run_resample_check(opts) ? 1 : 0;
+	if (opts.text_updates)
+		return run_text_update_check(opts) ? 1 : 0;
+	if (opts.glyphs)
+		return run_glyph_check(opts) ? 1 : 0;
+	if (opts.shadows)
+		return run_shadow_check(opts) ? 1 : 0;
+	if (opts.text_metrics)
+		return run_text_metrics_check(opts) ? 1 : 0;
+
+	printf("# lowerthirds render bench: %d frames/combination at %d fps, art sim %s%d Hz, intensity %.2f%s%s%s\n",
+		opts.frames, opts.fps, opts.sim_rate ? "" : "every frame, ", opts.sim_rate ? opts.sim_rate : opts.fps,
+		opts.intensity,
+		opts.highlight_sdf ? ", highlight (sdf)" : opts.highlight ? ", highlight" : "",
+		opts.shadow ? ", shadow" : "",
+		opts.static_art ? ", static art" : "");
+	if (opts.budget_ms > 0.0)
+		printf("# adaptive quality on, render budget %.3f ms\n", opts.budget_ms);
+	if (opts.shader)
+		printf("# art effects from the per-pixel shader\n");
+
+	if (!opts.summary_only) {
+		printf("%-13s %-14s %-11s %12s %10s %12s %10s %10s %8s\n",
+			"animation", "art", "gradient", "ns/frame", "draws", "vertices",
+			"loops", "params", "sources");
+	}
+
+	frame_stats art_totals[num_arts] = {};
+	frame_stats grand = {};
+	int failures = opts.shader ? run_shader_check(opts) : 0;
+	int combos = 0;
+
+	for (int art = 0; art < num_arts; art++) {
+		for (int anim = 0; anim < num_anims; anim++) {
+			for (int gradient = 0; gradient < num_gradients; gradient++) {
+				frame_stats s;
+				if (!run_combination(opts, anim, art, gradient, s)) {
+					fprintf(stderr, "unbalanced graphics state: %s/%s/%s\n",
+						anim_names[anim], art_names[art], gradient_names[gradient]);
+					failures++;
+				}
+
+				if (!opts.summary_only) {
+					printf("%-13s %-14s %-11s %12.0f %10.1f %12.1f %10.1f %10.1f %8.1f\n",
+						anim_names[anim], art_names[art], gradient_names[gradient],
+						s.ns, s.draws, s.vertices, s.effect_loops, s.param_sets,
+						s.source_renders);
+				}
+
+				frame_stats &t = art_totals[art];
+				t.ns += s.ns;
+				t.draws += s.draws;
+				t.vertices += s.vertices;
+				t.effect_loops += s.effect_loops;
+				t.param_sets += s.param_sets;
+				t.source_renders += s.source_renders;
+				t.tier += s.tier;
+				t.bakes += s.bakes;
+				t.loads += s.loads;
+				combos++;
+			}
+		}
+	}
+
+	printf("\n# per art effect (mean over %d animation x gradient combinations)\n",
+		num_anims * num_gradients);
+	printf("%-14s %12s %10s %10s %12s %10s %10s %6s\n",
+		"art", "ns/frame", "us/sec", "draws", "vertices", "loops", "params", "tier");
+
+	const double per_art = (double)(num_anims * num_gradients);
+	for (int art = 0; art < num_arts; art++) {
+		const frame_stats &t = art_totals[art];
+		printf("%-14s %12.0f %10.1f %10.1f %12.1f %10.1f %10.1f %6.2f\n", art_names[art],
+			t.ns / per_art, t.ns / per_art * opts.fps / 1000.0, t.draws / per_art, t.vertices / per_art,
+			t.effect_loops / per_art, t.param_sets / per_art, t.tier / per_art);
+
+		grand.ns += t.ns;
+		grand.draws += t.draws;
+		grand.vertices += t.vertices;
+		grand.effect_loops += t.effect_loops;
+		grand.param_sets += t.param_sets;
+		grand.tier += t.tier;
+		grand.bakes += t.bakes;
+		grand.loads += t.loads;
+	}
+
+	printf("%-14s %12.0f %10.1f %10.1f %12.1f %10.1f %10.1f %6.2f\n", "ALL",
+		grand.ns / combos, grand.ns / combos * opts.fps / 1000.0, grand.draws / combos, grand.vertices / combos,
+		grand.effect_loops / combos, grand.param_sets / combos, grand.tier / combos);
+	if (opts.bake)
+		printf("\n# baked loops: %.0f bakes written, %.0f loaded from disk\n", grand.bakes, grand.loads);
+
+	return failures ? 1 : 0;
+}
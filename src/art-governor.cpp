@@ -0,0 +1,107 @@
+/**
+ * Lower Thirds Plus - adaptive art effect quality
+ *
+ * See art-governor.hpp.
+ */
+
+#include "art-governor.hpp"
+#include <obs-module.h>
+
+// Tiers trade the least visible detail first: faceting on the soft outer
+// layers, then the outer layers themselves, then elements
+static const art_quality art_quality_tiers[ART_QUALITY_TIERS] = {
+	{"Full", 1, 0, 1.0f},
+	{"High", 1, 1, 2.0f},
+	{"Medium", 2, 2, 4.0f},
+	{"Low", 3, 3, 8.0f},
+};
+
+static const float governor_smoothing = 0.1f;     // EMA weight of a new sample
+static const float governor_step_down = 0.5f;     // Seconds over budget before stepping down
+static const float governor_headroom = 0.6f;      // Fraction of budget that counts as headroom
+static const float governor_restore_min = 3.0f;   // Seconds of headroom before stepping up
+static const float governor_restore_max = 48.0f;
+static const float governor_relapse = 5.0f;       // A step down this soon after a restore is a relapse
+
+const art_quality &art_quality_for_tier(int tier)
+{
+	if (tier < 0)
+		tier = 0;
+	if (tier >= ART_QUALITY_TIERS)
+		tier = ART_QUALITY_TIERS - 1;
+	return art_quality_tiers[tier];
+}
+
+art_governor::art_governor()
+	: enabled(false)
+	, budget_ms(2.0f)
+{
+	reset();
+}
+
+void art_governor::reset()
+{
+	tier = ART_QUALITY_FULL;
+	avg_ms = 0.0f;
+	has_sample = false;
+	over_time = 0.0f;
+	under_time = 0.0f;
+	since_restore = governor_restore_max;
+	restore_wait = governor_restore_min;
+}
+
+void art_governor::sample(uint64_t render_ns)
+{
+	float ms = (float)render_ns / 1000000.0f;
+	if (!has_sample) {
+		avg_ms = ms;
+		has_sample = true;
+	} else {
+		avg_ms += (ms - avg_ms) * governor_smoothing;
+	}
+}
+
+bool art_governor::update(float seconds)
+{
+	if (!enabled || !has_sample)
+		return false;
+
+	since_restore += seconds;
+
+	if (avg_ms > budget_ms) {
+		over_time += seconds;
+		under_time = 0.0f;
+	} else if (avg_ms < budget_ms * governor_headroom) {
+		under_time += seconds;
+		over_time = 0.0f;
+	} else {
+		over_time = 0.0f;
+		under_time = 0.0f;
+	}
+
+	int old_tier = tier;
+	if (over_time >= governor_step_down && tier < ART_QUALITY_LOW) {
+		// Restored tier could not hold: wait longer before the next try
+		if (since_restore < governor_relapse) {
+			restore_wait *= 2.0f;
+			if (restore_wait > governor_restore_max)
+				restore_wait = governor_restore_max;
+		} else {
+			restore_wait = governor_restore_min;
+		}
+		tier++;
+	} else if (under_time >= restore_wait && tier > ART_QUALITY_FULL) {
+		tier--;
+		since_restore = 0.0f;
+	}
+
+	if (tier == old_tier)
+		return false;
+
+	blog(LOG_INFO, "Art effect quality: %s -> %s (render %.2f ms, budget %.2f ms)",
+		art_quality_for_tier(old_tier).name, art_quality_for_tier(tier).name,
+		avg_ms, budget_ms);
+	over_time = 0.0f;
+	under_time = 0.0f;
+	return true;
+}
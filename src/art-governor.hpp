@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdint.h>
+
+// Adaptive quality for the art effects. render() reports its CPU time, tick()
+// advances the governor, and draw_art_effect() scales element, glow layer and
+// segment counts by the current tier.
+//
+// Under budget pressure the governor steps down one tier at a time. It steps
+// back up only after a long stretch of clear headroom. If the restored tier
+// is over budget again right away, the wait before the next restore doubles,
+// so a load that hovers around the budget does not make the art flicker
+// between tiers.
+
+enum art_quality_tier {
+	ART_QUALITY_FULL = 0,
+	ART_QUALITY_HIGH = 1,
+	ART_QUALITY_MEDIUM = 2,
+	ART_QUALITY_LOW = 3,
+	ART_QUALITY_TIERS
+};
+
+struct art_quality {
+	const char *name;
+	int element_stride;         // Draw every Nth element
+	int layer_drop;             // Outer glow layers skipped
+	float error_scale;          // Circle and curve tessellation error budget multiplier
+};
+
+const art_quality &art_quality_for_tier(int tier);
+
+// Glow layers left of `layers` at this quality (never fewer than one)
+static inline int art_quality_layers(const art_quality &q, int layers)
+{
+	return layers - q.layer_drop > 1 ? layers - q.layer_drop : 1;
+}
+
+struct art_governor {
+	bool enabled;
+	float budget_ms;            // Target render() CPU time per frame
+	int tier;
+	float avg_ms;               // Smoothed render() time
+	bool has_sample;
+	float over_time;            // Continuous time above budget
+	float under_time;           // Continuous time with headroom
+	float since_restore;        // Time since the last step up
+	float restore_wait;         // Headroom required before stepping up
+
+	art_governor();
+
+	// Back to full quality and a clean history (settings changed)
+	void reset();
+
+	// Records one render() pass
+	void sample(uint64_t render_ns);
+
+	// Advances the governor by a frame; returns true when the tier changed
+	bool update(float seconds);
+
+	const art_quality &quality() const
+	{
+		return art_quality_for_tier(enabled ? tier : ART_QUALITY_FULL);
+	}
+};
@@ -0,0 +1,418 @@
+/**
+ * Lower Thirds Plus - vectorized art effect simulation
+ *
+ * See art-kernel.hpp. The vector paths use a Cody-Waite range reduction to
+ * [-pi/4, pi/4] and the Cephes single-precision sin/cos polynomials, which
+ * stay within a few ulp of sinf()/cosf() for the phase range the effects
+ * reach (art_animation_offset wraps at 10000).
+ */
+
+#include "art-kernel.hpp"
+#include <util/sse-intrin.h>
+#include <math.h>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(__GNUC__)
+#define ART_KERNEL_HAVE_AVX2 1
+#include <immintrin.h>
+#if defined(__clang__)
+#define ART_KERNEL_AVX2_TARGET __attribute__((target("avx2,fma")))
+#else
+// GCC would otherwise contract the separate mul + add below into FMAs
+#define ART_KERNEL_AVX2_TARGET __attribute__((target("avx2,fma"), optimize("fp-contract=off")))
+#endif
+#else
+#define ART_KERNEL_HAVE_AVX2 0
+#endif
+
+// pi/2 split into three parts for the Cody-Waite reduction
+#define PIO2_1 1.5703125f
+#define PIO2_2 4.837512969970703125e-4f
+#define PIO2_3 7.54978995489188216e-8f
+#define TWO_OVER_PI 0.636619772367581343f
+
+// Cephes sinf/cosf minimax coefficients on [-pi/4, pi/4]
+#define SIN_C1 -1.9515295891e-4f
+#define SIN_C2 8.3321608736e-3f
+#define SIN_C3 -1.6666654611e-1f
+#define COS_C1 2.443315711809948e-5f
+#define COS_C2 -1.388731625493765e-3f
+#define COS_C3 4.166664568298827e-2f
+
+// ---------------------------------------------------------------------------
+// Scalar (reference) path
+
+static void particles_scalar(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	const float t = in->time;
+	for (int i = 0; i < in->count; i++) {
+		float drift_phase = t * 0.3f + in->phase[i];
+		float drift = sinf(drift_phase) * 25.0f * cosf(drift_phase * 0.7f);
+		out->y[i] = fmodf(in->y[i] - t * in->speed[i] + in->height, in->height);
+		out->x[i] = in->x[i] + drift;
+
+		float pulse_phase = t * 1.5f + in->phase2[i];
+		out->alpha[i] = (sinf(pulse_phase) * 0.4f + 0.6f) * alpha_scale;
+	}
+}
+
+static void bokeh_scalar(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	const float t = in->time;
+	for (int i = 0; i < in->count; i++) {
+		float drift_phase_x = t * 0.2f + in->phase[i];
+		float drift_phase_y = t * 0.15f + in->phase2[i];
+		out->x[i] = in->x[i] + sinf(drift_phase_x) * 35.0f * cosf(drift_phase_x * 0.5f);
+		out->y[i] = in->y[i] + cosf(drift_phase_y) * 25.0f * sinf(drift_phase_y * 0.7f);
+
+		float pulse_phase = t * 0.8f + in->phase[i];
+		out->alpha[i] = (sinf(pulse_phase) * 0.25f + 0.75f) * alpha_scale;
+	}
+}
+
+static void glow_orbs_scalar(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	const float t = in->time;
+	const float orbit_radius = 35.0f;
+	for (int i = 0; i < in->count; i++) {
+		float phase = t * in->speed[i] + in->phase[i];
+		out->x[i] = in->x[i] + cosf(phase) * orbit_radius + sinf(phase * 2.0f) * 15.0f;
+		out->y[i] = in->y[i] + sinf(phase * 1.3f) * orbit_radius * 0.8f;
+
+		float pulse_phase = t * 1.0f + in->phase2[i];
+		out->alpha[i] = (sinf(pulse_phase) * 0.2f + 0.8f) * alpha_scale;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// SSE2 path (4 lanes)
+
+static inline void sincos_sse2(__m128 x, __m128 *s, __m128 *c)
+{
+	__m128i j = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(TWO_OVER_PI)));
+	__m128 jf = _mm_cvtepi32_ps(j);
+
+	__m128 r = _mm_sub_ps(x, _mm_mul_ps(jf, _mm_set1_ps(PIO2_1)));
+	r = _mm_sub_ps(r, _mm_mul_ps(jf, _mm_set1_ps(PIO2_2)));
+	r = _mm_sub_ps(r, _mm_mul_ps(jf, _mm_set1_ps(PIO2_3)));
+	__m128 r2 = _mm_mul_ps(r, r);
+
+	__m128 sp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_C1), r2), _mm_set1_ps(SIN_C2));
+	sp = _mm_add_ps(_mm_mul_ps(sp, r2), _mm_set1_ps(SIN_C3));
+	sp = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sp, r2), r), r);
+
+	__m128 cp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_C1), r2), _mm_set1_ps(COS_C2));
+	cp = _mm_add_ps(_mm_mul_ps(cp, r2), _mm_set1_ps(COS_C3));
+	cp = _mm_mul_ps(_mm_mul_ps(cp, r2), r2);
+	cp = _mm_add_ps(_mm_sub_ps(cp, _mm_mul_ps(_mm_set1_ps(0.5f), r2)), _mm_set1_ps(1.0f));
+
+	// Odd quadrants swap sin and cos; bit 1 of j (j + 1 for cos) flips the sign
+	const __m128i one = _mm_set1_epi32(1);
+	const __m128i two = _mm_set1_epi32(2);
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, one), one));
+	__m128 sin_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, two), 30));
+	__m128 cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(j, one), two), 30));
+
+	__m128 sv = _mm_or_ps(_mm_and_ps(swap, cp), _mm_andnot_ps(swap, sp));
+	__m128 cv = _mm_or_ps(_mm_and_ps(swap, sp), _mm_andnot_ps(swap, cp));
+	*s = _mm_xor_ps(sv, sin_sign);
+	*c = _mm_xor_ps(cv, cos_sign);
+}
+
+static inline __m128 sin_sse2(__m128 x)
+{
+	__m128 s, c;
+	sincos_sse2(x, &s, &c);
+	return s;
+}
+
+static inline __m128 cos_sse2(__m128 x)
+{
+	__m128 s, c;
+	sincos_sse2(x, &s, &c);
+	return c;
+}
+
+// Same truncating semantics as fmodf()
+static inline __m128 fmod_sse2(__m128 x, __m128 y)
+{
+	__m128 q = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(x, y)));
+	return _mm_sub_ps(x, _mm_mul_ps(q, y));
+}
+
+static void particles_sse2(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	const __m128 t = _mm_set1_ps(in->time);
+	const __m128 height = _mm_set1_ps(in->height);
+	const __m128 scale = _mm_set1_ps(alpha_scale);
+	const int n = art_kernel_padded(in->count);
+
+	for (int i = 0; i < n; i += 4) {
+		__m128 drift_phase = _mm_add_ps(_mm_mul_ps(t, _mm_set1_ps(0.3f)), _mm_loadu_ps(in->phase + i));
+		__m128 drift = _mm_mul_ps(_mm_mul_ps(sin_sse2(drift_phase), _mm_set1_ps(25.0f)),
+			cos_sse2(_mm_mul_ps(drift_phase, _mm_set1_ps(0.7f))));
+
+		__m128 y = _mm_sub_ps(_mm_loadu_ps(in->y + i), _mm_mul_ps(t, _mm_loadu_ps(in->speed + i)));
+		_mm_storeu_ps(out->y + i, fmod_sse2(_mm_add_ps(y, height), height));
+		_mm_storeu_ps(out->x + i, _mm_add_ps(_mm_loadu_ps(in->x + i), drift));
+
+		__m128 pulse_phase = _mm_add_ps(_mm_mul_ps(t, _mm_set1_ps(1.5f)), _mm_loadu_ps(in->phase2 + i));
+		__m128 pulse = _mm_add_ps(_mm_mul_ps(sin_sse2(pulse_phase), _mm_set1_ps(0.4f)), _mm_set1_ps(0.6f));
+		_mm_storeu_ps(out->alpha + i, _mm_mul_ps(pulse, scale));
+	}
+}
+
+static void bokeh_sse2(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	const __m128 t = _mm_set1_ps(in->time);
+	const __m128 scale = _mm_set1_ps(alpha_scale);
+	const int n = art_kernel_padded(in->count);
+
+	for (int i = 0; i < n; i += 4) {
+		__m128 phase = _mm_loadu_ps(in->phase + i);
+		__m128 drift_phase_x = _mm_add_ps(_mm_mul_ps(t, _mm_set1_ps(0.2f)), phase);
+		__m128 drift_phase_y = _mm_add_ps(_mm_mul_ps(t, _mm_set1_ps(0.15f)), _mm_loadu_ps(in->phase2 + i));
+
+		__m128 dx = _mm_mul_ps(_mm_mul_ps(sin_sse2(drift_phase_x), _mm_set1_ps(35.0f)),
+			cos_sse2(_mm_mul_ps(drift_phase_x, _mm_set1_ps(0.5f))));
+		__m128 dy = _mm_mul_ps(_mm_mul_ps(cos_sse2(drift_phase_y), _mm_set1_ps(25.0f)),
+			sin_sse2(_mm_mul_ps(drift_phase_y, _mm_set1_ps(0.7f))));
+		_mm_storeu_ps(out->x + i, _mm_add_ps(_mm_loadu_ps(in->x + i), dx));
+		_mm_storeu_ps(out->y + i, _mm_add_ps(_mm_loadu_ps(in->y + i), dy));
+
+		__m128 pulse_phase = _mm_add_ps(_mm_mul_ps(t, _mm_set1_ps(0.8f)), phase);
+		__m128 pulse = _mm_add_ps(_mm_mul_ps(sin_sse2(pulse_phase), _mm_set1_ps(0.25f)), _mm_set1_ps(0.75f));
+		_mm_storeu_ps(out->alpha + i, _mm_mul_ps(pulse, scale));
+	}
+}
+
+static void glow_orbs_sse2(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	const __m128 t = _mm_set1_ps(in->time);
+	const __m128 scale = _mm_set1_ps(alpha_scale);
+	const int n = art_kernel_padded(in->count);
+
+	for (int i = 0; i < n; i += 4) {
+		__m128 phase = _mm_add_ps(_mm_mul_ps(t, _mm_loadu_ps(in->speed + i)), _mm_loadu_ps(in->phase + i));
+		__m128 s, c;
+		sincos_sse2(phase, &s, &c);
+
+		__m128 dx = _mm_add_ps(_mm_mul_ps(c, _mm_set1_ps(35.0f)),
+			_mm_mul_ps(sin_sse2(_mm_mul_ps(phase, _mm_set1_ps(2.0f))), _mm_set1_ps(15.0f)));
+		__m128 dy = _mm_mul_ps(sin_sse2(_mm_mul_ps(phase, _mm_set1_ps(1.3f))), _mm_set1_ps(35.0f * 0.8f));
+		_mm_storeu_ps(out->x + i, _mm_add_ps(_mm_loadu_ps(in->x + i), dx));
+		_mm_storeu_ps(out->y + i, _mm_add_ps(_mm_loadu_ps(in->y + i), dy));
+
+		__m128 pulse_phase = _mm_add_ps(t, _mm_loadu_ps(in->phase2 + i));
+		__m128 pulse = _mm_add_ps(_mm_mul_ps(sin_sse2(pulse_phase), _mm_set1_ps(0.2f)), _mm_set1_ps(0.8f));
+		_mm_storeu_ps(out->alpha + i, _mm_mul_ps(pulse, scale));
+	}
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 + FMA path (8 lanes)
+
+#if ART_KERNEL_HAVE_AVX2
+
+// Phases, offsets and pulses are formed with separate mul + add like the
+// scalar and SSE2 paths: at the magnitudes the animation offset reaches, a
+// fused multiply-add rounds differently enough to move elements by a visible
+// fraction of a pixel. FMA is only used inside the sin/cos range reduction
+// and polynomials, which keeps this path as close to scalar as SSE2.
+
+ART_KERNEL_AVX2_TARGET
+static inline void sincos_avx2(__m256 x, __m256 *s, __m256 *c)
+{
+	__m256i j = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(TWO_OVER_PI)));
+	__m256 jf = _mm256_cvtepi32_ps(j);
+
+	__m256 r = _mm256_fnmadd_ps(jf, _mm256_set1_ps(PIO2_1), x);
+	r = _mm256_fnmadd_ps(jf, _mm256_set1_ps(PIO2_2), r);
+	r = _mm256_fnmadd_ps(jf, _mm256_set1_ps(PIO2_3), r);
+	__m256 r2 = _mm256_mul_ps(r, r);
+
+	__m256 sp = _mm256_fmadd_ps(_mm256_set1_ps(SIN_C1), r2, _mm256_set1_ps(SIN_C2));
+	sp = _mm256_fmadd_ps(sp, r2, _mm256_set1_ps(SIN_C3));
+	sp = _mm256_fmadd_ps(_mm256_mul_ps(sp, r2), r, r);
+
+	__m256 cp = _mm256_fmadd_ps(_mm256_set1_ps(COS_C1), r2, _mm256_set1_ps(COS_C2));
+	cp = _mm256_fmadd_ps(cp, r2, _mm256_set1_ps(COS_C3));
+	cp = _mm256_mul_ps(_mm256_mul_ps(cp, r2), r2);
+	cp = _mm256_add_ps(_mm256_fnmadd_ps(_mm256_set1_ps(0.5f), r2, cp), _mm256_set1_ps(1.0f));
+
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i two = _mm256_set1_epi32(2);
+	__m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, one), one));
+	__m256 sin_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, two), 30));
+	__m256 cos_sign = _mm256_castsi256_ps(
+		_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(j, one), two), 30));
+
+	*s = _mm256_xor_ps(_mm256_blendv_ps(sp, cp, swap), sin_sign);
+	*c = _mm256_xor_ps(_mm256_blendv_ps(cp, sp, swap), cos_sign);
+}
+
+ART_KERNEL_AVX2_TARGET
+static inline __m256 sin_avx2(__m256 x)
+{
+	__m256 s, c;
+	sincos_avx2(x, &s, &c);
+	return s;
+}
+
+ART_KERNEL_AVX2_TARGET
+static inline __m256 cos_avx2(__m256 x)
+{
+	__m256 s, c;
+	sincos_avx2(x, &s, &c);
+	return c;
+}
+
+ART_KERNEL_AVX2_TARGET
+static inline __m256 fmod_avx2(__m256 x, __m256 y)
+{
+	__m256 q = _mm256_round_ps(_mm256_div_ps(x, y), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+	return _mm256_sub_ps(x, _mm256_mul_ps(q, y));
+}
+
+ART_KERNEL_AVX2_TARGET
+static void particles_avx2(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	const __m256 t = _mm256_set1_ps(in->time);
+	const __m256 height = _mm256_set1_ps(in->height);
+	const __m256 scale = _mm256_set1_ps(alpha_scale);
+	const int n = art_kernel_padded(in->count);
+
+	for (int i = 0; i < n; i += 8) {
+		__m256 drift_phase = _mm256_add_ps(_mm256_mul_ps(t, _mm256_set1_ps(0.3f)), _mm256_loadu_ps(in->phase + i));
+		__m256 drift = _mm256_mul_ps(_mm256_mul_ps(sin_avx2(drift_phase), _mm256_set1_ps(25.0f)),
+			cos_avx2(_mm256_mul_ps(drift_phase, _mm256_set1_ps(0.7f))));
+
+		__m256 y = _mm256_sub_ps(_mm256_loadu_ps(in->y + i), _mm256_mul_ps(t, _mm256_loadu_ps(in->speed + i)));
+		_mm256_storeu_ps(out->y + i, fmod_avx2(_mm256_add_ps(y, height), height));
+		_mm256_storeu_ps(out->x + i, _mm256_add_ps(_mm256_loadu_ps(in->x + i), drift));
+
+		__m256 pulse_phase = _mm256_add_ps(_mm256_mul_ps(t, _mm256_set1_ps(1.5f)), _mm256_loadu_ps(in->phase2 + i));
+		__m256 pulse = _mm256_add_ps(_mm256_mul_ps(sin_avx2(pulse_phase), _mm256_set1_ps(0.4f)), _mm256_set1_ps(0.6f));
+		_mm256_storeu_ps(out->alpha + i, _mm256_mul_ps(pulse, scale));
+	}
+}
+
+ART_KERNEL_AVX2_TARGET
+static void bokeh_avx2(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	const __m256 t = _mm256_set1_ps(in->time);
+	const __m256 scale = _mm256_set1_ps(alpha_scale);
+	const int n = art_kernel_padded(in->count);
+
+	for (int i = 0; i < n; i += 8) {
+		__m256 phase = _mm256_loadu_ps(in->phase + i);
+		__m256 drift_phase_x = _mm256_add_ps(_mm256_mul_ps(t, _mm256_set1_ps(0.2f)), phase);
+		__m256 drift_phase_y = _mm256_add_ps(_mm256_mul_ps(t, _mm256_set1_ps(0.15f)), _mm256_loadu_ps(in->phase2 + i));
+
+		__m256 dx = _mm256_mul_ps(_mm256_mul_ps(sin_avx2(drift_phase_x), _mm256_set1_ps(35.0f)),
+			cos_avx2(_mm256_mul_ps(drift_phase_x, _mm256_set1_ps(0.5f))));
+		__m256 dy = _mm256_mul_ps(_mm256_mul_ps(cos_avx2(drift_phase_y), _mm256_set1_ps(25.0f)),
+			sin_avx2(_mm256_mul_ps(drift_phase_y, _mm256_set1_ps(0.7f))));
+		_mm256_storeu_ps(out->x + i, _mm256_add_ps(_mm256_loadu_ps(in->x + i), dx));
+		_mm256_storeu_ps(out->y + i, _mm256_add_ps(_mm256_loadu_ps(in->y + i), dy));
+
+		__m256 pulse_phase = _mm256_add_ps(_mm256_mul_ps(t, _mm256_set1_ps(0.8f)), phase);
+		__m256 pulse = _mm256_add_ps(_mm256_mul_ps(sin_avx2(pulse_phase), _mm256_set1_ps(0.25f)), _mm256_set1_ps(0.75f));
+		_mm256_storeu_ps(out->alpha + i, _mm256_mul_ps(pulse, scale));
+	}
+}
+
+ART_KERNEL_AVX2_TARGET
+static void glow_orbs_avx2(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	const __m256 t = _mm256_set1_ps(in->time);
+	const __m256 scale = _mm256_set1_ps(alpha_scale);
+	const int n = art_kernel_padded(in->count);
+
+	for (int i = 0; i < n; i += 8) {
+		__m256 phase = _mm256_add_ps(_mm256_mul_ps(t, _mm256_loadu_ps(in->speed + i)), _mm256_loadu_ps(in->phase + i));
+		__m256 s, c;
+		sincos_avx2(phase, &s, &c);
+
+		__m256 dx = _mm256_add_ps(_mm256_mul_ps(c, _mm256_set1_ps(35.0f)),
+			_mm256_mul_ps(sin_avx2(_mm256_mul_ps(phase, _mm256_set1_ps(2.0f))), _mm256_set1_ps(15.0f)));
+		__m256 dy = _mm256_mul_ps(sin_avx2(_mm256_mul_ps(phase, _mm256_set1_ps(1.3f))),
+			_mm256_set1_ps(35.0f * 0.8f));
+		_mm256_storeu_ps(out->x + i, _mm256_add_ps(_mm256_loadu_ps(in->x + i), dx));
+		_mm256_storeu_ps(out->y + i, _mm256_add_ps(_mm256_loadu_ps(in->y + i), dy));
+
+		__m256 pulse_phase = _mm256_add_ps(t, _mm256_loadu_ps(in->phase2 + i));
+		__m256 pulse = _mm256_add_ps(_mm256_mul_ps(sin_avx2(pulse_phase), _mm256_set1_ps(0.2f)), _mm256_set1_ps(0.8f));
+		_mm256_storeu_ps(out->alpha + i, _mm256_mul_ps(pulse, scale));
+	}
+}
+
+#endif
+
+// ---------------------------------------------------------------------------
+// Dispatch
+
+art_kernel_isa art_kernel_detect_isa()
+{
+#if ART_KERNEL_HAVE_AVX2
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		return ART_KERNEL_AVX2;
+#endif
+	return ART_KERNEL_SSE2;
+}
+
+static art_kernel_isa current_isa = art_kernel_detect_isa();
+
+art_kernel_isa art_kernel_get_isa()
+{
+	return current_isa;
+}
+
+void art_kernel_set_isa(art_kernel_isa isa)
+{
+	art_kernel_isa best = art_kernel_detect_isa();
+	current_isa = isa > best ? best : isa;
+}
+
+const char *art_kernel_isa_name(art_kernel_isa isa)
+{
+	switch (isa) {
+		case ART_KERNEL_SCALAR: return "scalar";
+		case ART_KERNEL_SSE2:   return "sse2";
+		case ART_KERNEL_AVX2:   return "avx2";
+	}
+	return "unknown";
+}
+
+void art_kernel_particles(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	switch (current_isa) {
+#if ART_KERNEL_HAVE_AVX2
+		case ART_KERNEL_AVX2: particles_avx2(in, alpha_scale, out); return;
+#endif
+		case ART_KERNEL_SSE2: particles_sse2(in, alpha_scale, out); return;
+		default:              particles_scalar(in, alpha_scale, out); return;
+	}
+}
+
+void art_kernel_bokeh(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	switch (current_isa) {
+#if ART_KERNEL_HAVE_AVX2
+		case ART_KERNEL_AVX2: bokeh_avx2(in, alpha_scale, out); return;
+#endif
+		case ART_KERNEL_SSE2: bokeh_sse2(in, alpha_scale, out); return;
+		default:              bokeh_scalar(in, alpha_scale, out); return;
+	}
+}
+
+void art_kernel_glow_orbs(const art_kernel_input *in, float alpha_scale, art_kernel_output *out)
+{
+	switch (current_isa) {
+#if ART_KERNEL_HAVE_AVX2
+		case ART_KERNEL_AVX2: glow_orbs_avx2(in, alpha_scale, out); return;
+#endif
+		case ART_KERNEL_SSE2: glow_orbs_sse2(in, alpha_scale, out); return;
+		default:              glow_orbs_scalar(in, alpha_scale, out); return;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+
+// Vectorized per-frame simulation for the circle-based art effects
+// (particles, bokeh, glow orbs). Each kernel evaluates drift, pulse and
+// wrap-around for every element at once and writes positions and alphas
+// into contiguous float arrays; sizes are static and stay in the
+// precomputed art table.
+//
+// All input and output arrays must be padded to ART_KERNEL_PAD floats so
+// the vector paths can process whole registers without a scalar tail.
+
+#define ART_KERNEL_PAD 8
+
+static inline int art_kernel_padded(int count)
+{
+	return (count + ART_KERNEL_PAD - 1) & ~(ART_KERNEL_PAD - 1);
+}
+
+enum art_kernel_isa {
+	ART_KERNEL_SCALAR = 0,      // sinf/cosf/fmodf, the original render path
+	ART_KERNEL_SSE2 = 1,        // 4-wide (NEON through util/sse-intrin.h on ARM)
+	ART_KERNEL_AVX2 = 2         // 8-wide, x86-64 only, runtime detected
+};
+
+struct art_kernel_input {
+	int count;
+	const float *x;             // Base position
+	const float *y;
+	const float *speed;
+	const float *phase;
+	const float *phase2;
+	float time;                 // art_animation_offset
+	float height;               // Wrap-around height (particles)
+};
+
+struct art_kernel_output {
+	float *x;
+	float *y;
+	float *alpha;               // Pulse already multiplied by alpha_scale
+};
+
+// Best instruction set this CPU supports
+art_kernel_isa art_kernel_detect_isa();
+
+// Current dispatch target; defaults to art_kernel_detect_isa(). Setting an
+// unsupported level falls back to the best supported one below it.
+art_kernel_isa art_kernel_get_isa();
+void art_kernel_set_isa(art_kernel_isa isa);
+const char *art_kernel_isa_name(art_kernel_isa isa);
+
+void art_kernel_particles(const art_kernel_input *in, float alpha_scale, art_kernel_output *out);
+void art_kernel_bokeh(const art_kernel_input *in, float alpha_scale, art_kernel_output *out);
+void art_kernel_glow_orbs(const art_kernel_input *in, float alpha_scale, art_kernel_output *out);
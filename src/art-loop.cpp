@@ -0,0 +1,360 @@
+/**
+ * Lower Thirds Plus - baked art effect loops
+ *
+ * See art-loop.hpp.
+ */
+
+#include "art-loop.hpp"
+#include <graphics/vec4.h>
+#include <util/bmem.h>
+#include <util/dstr.h>
+#include <util/platform.h>
+#include <sys/stat.h>
+#include <utime.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#define ART_LOOP_MAGIC "LTAL"
+#define ART_LOOP_VERSION 4
+
+static const uint32_t atlas_pixel_size = 8;     // GS_RGBA16F
+static const int stage_delay = 2;               // Frames before mapping a readback
+static const uint32_t atlas_max_size = 8192;    // Safe on every OBS renderer
+static const uint32_t atlas_gutter = 2;         // Keeps linear filtering inside a cell
+
+struct art_loop_file_header {
+	char magic[4];
+	uint32_t version;
+	uint64_t hash;
+	uint32_t frames;
+	uint32_t cols;
+	uint32_t cell_cx;
+	uint32_t cell_cy;
+	uint32_t cx;
+	uint32_t cy;
+};
+
+// FNV-1a over the key fields; the file version is mixed in so a format
+// change never picks up an old atlas
+static inline void hash_bytes(uint64_t &h, const void *data, size_t size)
+{
+	const uint8_t *p = (const uint8_t *)data;
+	for (size_t i = 0; i < size; i++) {
+		h ^= p[i];
+		h *= 0x100000001b3ULL;
+	}
+}
+
+uint64_t art_loop_hash(const art_loop_key &key)
+{
+	uint64_t h = 0xcbf29ce484222325ULL;
+	const uint32_t version = ART_LOOP_VERSION;
+	hash_bytes(h, &version, sizeof(version));
+	hash_bytes(h, &key.effect, sizeof(key.effect));
+	hash_bytes(h, &key.color, sizeof(key.color));
+	hash_bytes(h, &key.opacity, sizeof(key.opacity));
+	hash_bytes(h, &key.intensity, sizeof(key.intensity));
+	hash_bytes(h, &key.width, sizeof(key.width));
+	hash_bytes(h, &key.height, sizeof(key.height));
+	hash_bytes(h, &key.scale_factor, sizeof(key.scale_factor));
+	hash_bytes(h, &key.period, sizeof(key.period));
+	hash_bytes(h, &key.frames, sizeof(key.frames));
+	hash_bytes(h, &key.resolution, sizeof(key.resolution));
+	return h;
+}
+
+art_loop_atlas::art_loop_atlas()
+	: render(nullptr)
+	, texture(nullptr)
+	, owns_texture(false)
+	, hash(0)
+	, frames(0)
+	, cols(0)
+	, cell_cx(0)
+	, cell_cy(0)
+	, cx(0)
+	, cy(0)
+	, settle_hash(0)
+	, settle_frames(0)
+	, stage(nullptr)
+	, stage_hash(0)
+	, stage_age(0)
+	, writer()
+{
+}
+
+bool art_loop_atlas::settled(uint64_t key_hash)
+{
+	if (settle_hash != key_hash) {
+		settle_hash = key_hash;
+		settle_frames = 0;
+	}
+	if (settle_frames < ART_LOOP_SETTLE_FRAMES)
+		settle_frames++;
+	return settle_frames >= ART_LOOP_SETTLE_FRAMES;
+}
+
+bool art_loop_atlas::layout(int num_frames, uint32_t width, uint32_t height)
+{
+	if (num_frames < 1 || !width || !height ||
+		width + atlas_gutter > atlas_max_size || height + atlas_gutter > atlas_max_size)
+		return false;
+
+	int max_cols = (int)(atlas_max_size / (width + atlas_gutter));
+	int max_rows = (int)(atlas_max_size / (height + atlas_gutter));
+	if (num_frames > max_cols * max_rows)
+		num_frames = max_cols * max_rows;
+
+	frames = num_frames;
+	cols = frames < max_cols ? frames : max_cols;
+	int rows = (frames + cols - 1) / cols;
+	cell_cx = width;
+	cell_cy = height;
+	cx = (uint32_t)cols * (width + atlas_gutter);
+	cy = (uint32_t)rows * (height + atlas_gutter);
+	return true;
+}
+
+void art_loop_atlas::cell_origin(int frame, uint32_t *x, uint32_t *y) const
+{
+	*x = (uint32_t)(frame % cols) * (cell_cx + atlas_gutter);
+	*y = (uint32_t)(frame / cols) * (cell_cy + atlas_gutter);
+}
+
+bool art_loop_atlas::bake_begin()
+{
+	release_texture();
+	if (!render)
+		render = gs_texrender_create(GS_RGBA16F, GS_ZS_NONE);
+	if (!render)
+		return false;
+
+	gs_texrender_reset(render);
+	if (!gs_texrender_begin(render, cx, cy))
+		return false;
+
+	struct vec4 clear_color;
+	vec4_zero(&clear_color);
+	gs_clear(GS_CLEAR_COLOR, &clear_color, 0.0f, 0);
+	gs_ortho(0.0f, (float)cx, 0.0f, (float)cy, -100.0f, 100.0f);
+	return true;
+}
+
+void art_loop_atlas::bake_end()
+{
+	gs_set_scissor_rect(NULL);
+	gs_texrender_end(render);
+	texture = gs_texrender_get_texture(render);
+	owns_texture = false;
+}
+
+static char *atlas_path(uint64_t hash)
+{
+	char *dir = obs_module_config_path("art-loops");
+	if (!dir)
+		return NULL;
+
+	struct dstr path;
+	dstr_init(&path);
+	dstr_printf(&path, "%s/%016llx.bin", dir, (unsigned long long)hash);
+	bfree(dir);
+	return path.array;
+}
+
+bool art_loop_atlas::load(uint64_t key_hash)
+{
+	char *path = atlas_path(key_hash);
+	if (!path)
+		return false;
+
+	FILE *file = os_fopen(path, "rb");
+	if (!file) {
+		bfree(path);
+		return false;
+	}
+
+	// Marks the atlas as recently used for the cache cap
+	utime(path, NULL);
+	bfree(path);
+
+	// The caller has already laid out the grid for this key; anything else
+	// in the file means a stale or foreign atlas
+	art_loop_file_header header;
+	bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+		memcmp(header.magic, ART_LOOP_MAGIC, 4) == 0 &&
+		header.version == ART_LOOP_VERSION && header.hash == key_hash &&
+		header.frames == (uint32_t)frames && header.cols == (uint32_t)cols &&
+		header.cell_cx == cell_cx && header.cell_cy == cell_cy &&
+		header.cx == cx && header.cy == cy;
+
+	uint8_t *pixels = NULL;
+	if (ok) {
+		size_t size = (size_t)cx * cy * atlas_pixel_size;
+		pixels = (uint8_t *)bmalloc(size);
+		ok = fread(pixels, 1, size, file) == size;
+	}
+	fclose(file);
+
+	if (ok) {
+		release_texture();
+		const uint8_t *data = pixels;
+		texture = gs_texture_create(cx, cy, GS_RGBA16F, 1, &data, 0);
+		owns_texture = texture != nullptr;
+		ok = owns_texture;
+	}
+	bfree(pixels);
+
+	if (ok)
+		hash = key_hash;
+	return ok;
+}
+
+struct cached_atlas {
+	std::string path;
+	int64_t size;
+	time_t used;
+};
+
+// Drops the least recently used atlases until the directory fits the cap
+static void trim_cache(const std::string &dir)
+{
+	std::vector<cached_atlas> atlases;
+	int64_t total = 0;
+	os_dir_t *listing = os_opendir(dir.c_str());
+	if (!listing)
+		return;
+	struct os_dirent *entry;
+	while ((entry = os_readdir(listing)) != NULL) {
+		const char *ext = strrchr(entry->d_name, '.');
+		if (entry->directory || !ext || strcmp(ext, ".bin") != 0)
+			continue;
+		std::string path = dir + "/" + entry->d_name;
+		struct stat st;
+		if (os_stat(path.c_str(), &st) != 0)
+			continue;
+		atlases.push_back({path, (int64_t)st.st_size, st.st_mtime});
+		total += (int64_t)st.st_size;
+	}
+	os_closedir(listing);
+
+	const int64_t cap = (int64_t)ART_LOOP_CACHE_MAX_MB * 1024 * 1024;
+	std::sort(atlases.begin(), atlases.end(),
+		[](const cached_atlas &a, const cached_atlas &b) { return a.used < b.used; });
+	for (const cached_atlas &atlas : atlases) {
+		if (total <= cap)
+			break;
+		if (os_unlink(atlas.path.c_str()) == 0) {
+			total -= atlas.size;
+			blog(LOG_INFO, "Evicted art loop cache: %s", atlas.path.c_str());
+		}
+	}
+}
+
+// Writer thread: header and pixels to a temporary name, renamed over the
+// real one so a crash never leaves a truncated atlas behind
+static void write_atlas(std::string dir, std::string path, art_loop_file_header header,
+	std::vector<uint8_t> pixels)
+{
+	std::string temp = path + ".tmp";
+	FILE *file = os_fopen(temp.c_str(), "wb");
+	bool ok = file != NULL;
+	if (ok) {
+		ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+			fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+		ok = fclose(file) == 0 && ok;
+	}
+
+	if (ok) {
+		os_unlink(path.c_str());
+		ok = os_rename(temp.c_str(), path.c_str()) == 0;
+	}
+	if (!ok) {
+		os_unlink(temp.c_str());
+		blog(LOG_WARNING, "Could not write art loop cache: %s", path.c_str());
+		return;
+	}
+	trim_cache(dir);
+}
+
+void art_loop_atlas::save()
+{
+	if (!render || !texture || owns_texture)
+		return;
+
+	// Only the newest bake is worth keeping
+	gs_stagesurface_destroy(stage);
+	stage = gs_stagesurface_create(cx, cy, GS_RGBA16F);
+	if (!stage)
+		return;
+	gs_stage_texture(stage, texture);
+	stage_hash = hash;
+	stage_age = 0;
+}
+
+void art_loop_atlas::poll_save()
+{
+	if (!stage || ++stage_age < stage_delay)
+		return;
+
+	// A newer key replaced the bake before its copy landed
+	gs_stagesurf_t *done = stage;
+	stage = nullptr;
+	if (stage_hash != hash) {
+		gs_stagesurface_destroy(done);
+		return;
+	}
+
+	char *dir = obs_module_config_path("art-loops");
+	char *path = atlas_path(hash);
+	uint8_t *data;
+	uint32_t linesize;
+	if (dir && path && os_mkdirs(dir) != MKDIR_ERROR && gs_stagesurface_map(done, &data, &linesize)) {
+		const size_t row = (size_t)cx * atlas_pixel_size;
+		std::vector<uint8_t> pixels(row * cy);
+		for (uint32_t y = 0; y < cy; y++)
+			memcpy(pixels.data() + (size_t)y * row, data + (size_t)y * linesize, row);
+		gs_stagesurface_unmap(done);
+
+		art_loop_file_header header;
+		memcpy(header.magic, ART_LOOP_MAGIC, 4);
+		header.version = ART_LOOP_VERSION;
+		header.hash = hash;
+		header.frames = (uint32_t)frames;
+		header.cols = (uint32_t)cols;
+		header.cell_cx = cell_cx;
+		header.cell_cy = cell_cy;
+		header.cx = cx;
+		header.cy = cy;
+
+		if (writer.joinable())
+			writer.join();
+		writer = std::thread(write_atlas, std::string(dir), std::string(path), header, std::move(pixels));
+	}
+	gs_stagesurface_destroy(done);
+	bfree(path);
+	bfree(dir);
+}
+
+void art_loop_atlas::release_texture()
+{
+	if (owns_texture)
+		gs_texture_destroy(texture);
+	texture = nullptr;
+	owns_texture = false;
+	hash = 0;
+}
+
+void art_loop_atlas::destroy()
+{
+	// A bake whose copy has not landed yet is simply baked again next time
+	gs_stagesurface_destroy(stage);
+	stage = nullptr;
+	if (writer.joinable())
+		writer.join();
+	release_texture();
+	gs_texrender_destroy(render);
+	render = nullptr;
+}
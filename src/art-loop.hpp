@@ -0,0 +1,84 @@
+#pragma once
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+#include <stdint.h>
+#include <thread>
+
+// Sprite-sheet playback for looping art effects. One loop period is rendered
+// once into a grid of cells (one RGBA16F texrender pass, like the static
+// pattern cache), and each frame then draws the current cell as a single
+// textured quad. Atlases are written to the module config directory
+// (art-loops/<hash>.bin) so the bake only runs the first time a parameter set
+// is seen. Bakes wait for the settings to settle, the readback is mapped a
+// few frames after it was queued, and the file is written on a worker thread;
+// the directory is capped at ART_LOOP_CACHE_MAX_MB, least recently used
+// atlases first.
+//
+// Must only be used from the graphics thread.
+
+#define ART_LOOP_SETTLE_FRAMES 30       // Unchanged frames before a bake or load
+#define ART_LOOP_CACHE_MAX_MB 256
+
+// Everything that changes the baked pixels. Playback speed is not part of
+// it: art_speed only changes how fast the cells are stepped through.
+struct art_loop_key {
+	int effect;
+	uint32_t color;
+	int opacity;
+	float intensity;
+	float width;                // Bar size in layout pixels
+	float height;
+	float scale_factor;         // Drives circle tessellation
+	float period;               // Loop length in animation offset units
+	int frames;
+	int resolution;             // Percent of the bar size
+};
+
+uint64_t art_loop_hash(const art_loop_key &key);
+
+struct art_loop_atlas {
+	gs_texrender_t *render;     // Bake target
+	gs_texture_t *texture;      // Playback texture (the bake or a disk load)
+	bool owns_texture;          // Loaded from disk, destroyed with the atlas
+	uint64_t hash;
+	int frames;
+	int cols;
+	uint32_t cell_cx;
+	uint32_t cell_cy;
+	uint32_t cx;                // Atlas size
+	uint32_t cy;
+	uint64_t settle_hash;       // Key seen on the last frames
+	int settle_frames;
+	gs_stagesurf_t *stage;      // Queued readback of the last bake
+	uint64_t stage_hash;
+	int stage_age;              // Frames since the readback was queued
+	std::thread writer;         // Writes the last readback to disk
+
+	art_loop_atlas();
+
+	// Counts the frames `key_hash` has been asked for in a row; true once it
+	// held for ART_LOOP_SETTLE_FRAMES, so slider drags keep drawing live
+	bool settled(uint64_t key_hash);
+
+	// Grid for `frames` cells, dropping frames that do not fit the maximum
+	// texture size. Returns false if not even one cell fits.
+	bool layout(int frames, uint32_t cell_cx, uint32_t cell_cy);
+
+	void cell_origin(int frame, uint32_t *x, uint32_t *y) const;
+
+	// Begins the bake pass into `render` (cleared, ortho over the atlas).
+	// Draw each cell inside a scissor from cell_origin().
+	bool bake_begin();
+	void bake_end();
+
+	// Disk cache under obs_module_config_path("art-loops"). save() queues a
+	// readback of the bake; poll_save() (every frame) maps it once the copy
+	// has landed and hands the pixels to the writer thread.
+	bool load(uint64_t hash);
+	void save();
+	void poll_save();
+
+	void release_texture();
+	void destroy();
+};
@@ -0,0 +1,106 @@
+/**
+ * Lower Thirds Plus - procedural art effect shader
+ *
+ * See art-shader.hpp.
+ */
+
+#include "art-shader.hpp"
+#include <graphics/vec2.h>
+#include <graphics/vec4.h>
+#include <util/bmem.h>
+
+art_shader::art_shader()
+	: effect(nullptr)
+	, color(nullptr)
+	, size(nullptr)
+	, intensity(nullptr)
+	, offset(nullptr)
+	, count(nullptr)
+	, load_failed(false)
+{
+}
+
+bool art_shader::load()
+{
+	if (effect)
+		return true;
+	if (load_failed)
+		return false;
+
+	char *path = obs_module_file("effects/art-procedural.effect");
+	char *errors = nullptr;
+	if (path)
+		effect = gs_effect_create_from_file(path, &errors);
+
+	if (effect) {
+		color = gs_effect_get_param_by_name(effect, "art_color");
+		size = gs_effect_get_param_by_name(effect, "bar_size");
+		intensity = gs_effect_get_param_by_name(effect, "intensity");
+		offset = gs_effect_get_param_by_name(effect, "animation_offset");
+		count = gs_effect_get_param_by_name(effect, "element_count");
+		if (!color || !size || !intensity || !offset || !count) {
+			gs_effect_destroy(effect);
+			effect = nullptr;
+		}
+	}
+
+	if (!effect) {
+		load_failed = true;
+		blog(LOG_WARNING, "Art effect shader unavailable (%s), using CPU geometry%s%s",
+			path ? path : "effects/art-procedural.effect", errors ? ": " : "",
+			errors ? errors : "");
+	}
+	bfree(errors);
+	bfree(path);
+	return effect != nullptr;
+}
+
+void art_shader::destroy()
+{
+	gs_effect_destroy(effect);
+	effect = nullptr;
+	color = size = intensity = offset = count = nullptr;
+	load_failed = false;
+}
+
+bool art_shader::draw(const char *technique, float width, float height, uint32_t rgba,
+	float opacity, float art_intensity, float animation_offset, int elements)
+{
+	if (elements <= 0 || elements > ART_SHADER_MAX_ELEMENTS || !load())
+		return false;
+
+	// ABGR to RGBA, opacity in w like the CPU path's art_color_vec
+	struct vec4 color_vec;
+	vec4_set(&color_vec,
+		((rgba >> 0) & 0xFF) / 255.0f,
+		((rgba >> 8) & 0xFF) / 255.0f,
+		((rgba >> 16) & 0xFF) / 255.0f,
+		opacity);
+	struct vec2 size_vec;
+	vec2_set(&size_vec, width, height);
+
+	gs_effect_set_vec4(color, &color_vec);
+	gs_effect_set_vec2(size, &size_vec);
+	gs_effect_set_float(intensity, art_intensity);
+	gs_effect_set_float(offset, animation_offset);
+	gs_effect_set_int(count, elements);
+
+	// The shader returns rgb already multiplied by the summed coverage
+	gs_blend_state_push();
+	gs_enable_color(true, true, true, true);
+	gs_enable_blending(true);
+	gs_blend_function_separate(
+		GS_BLEND_ONE, GS_BLEND_ONE,
+		GS_BLEND_ZERO, GS_BLEND_ONE
+	);
+
+	// Unit sprite scaled to the bar so uv * bar_size is exact layout pixels
+	gs_matrix_push();
+	gs_matrix_scale3f(width, height, 1.0f);
+	while (gs_effect_loop(effect, technique))
+		gs_draw_sprite(nullptr, 0, 1, 1);
+	gs_matrix_pop();
+
+	gs_blend_state_pop();
+	return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+#include <stdint.h>
+
+// Per-pixel art effects (data/effects/art-procedural.effect). Each technique
+// evaluates every element of one effect in the pixel shader, so an art layer
+// is a single quad instead of thousands of tessellated vertices. The CPU
+// geometry path stays the reference and the fallback when the effect file is
+// missing or does not compile.
+//
+// Must only be used from the graphics thread.
+
+#define ART_SHADER_MAX_ELEMENTS 128     // Loop bound in the effect file
+
+struct art_shader {
+	gs_effect_t *effect;
+	gs_eparam_t *color;
+	gs_eparam_t *size;
+	gs_eparam_t *intensity;
+	gs_eparam_t *offset;
+	gs_eparam_t *count;
+	bool load_failed;                   // Only try (and log) once
+
+	art_shader();
+
+	// Compiles the effect on first use; false if it is unavailable
+	bool load();
+	void destroy();
+
+	// One quad over (0, 0)-(width, height) in the current transform, blended
+	// additively like the CPU path. False (nothing drawn) if the shader is
+	// unavailable or the effect has more elements than the loop bound.
+	bool draw(const char *technique, float width, float height, uint32_t color,
+		float opacity, float intensity, float animation_offset, int elements);
+};
@@ -0,0 +1,619 @@
+/**
+ * Lower Thirds Plus - shared glyph atlas
+ *
+ * See glyph-atlas.hpp.
+ */
+
+#include "glyph-atlas.hpp"
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#ifdef LOWERTHIRDS_HAVE_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_OUTLINE_H
+#endif
+
+static const uint32_t atlas_initial = 512;      // Texels per side at first
+static const uint32_t atlas_max = 4096;
+static const uint32_t glyph_padding = 1;        // Empty texels between glyphs
+
+struct glyph_info {
+	uint32_t index;             // FreeType glyph index (kerning)
+	uint16_t tx, ty, tw, th;    // Atlas rect, empty for blanks
+	float left;                 // Bitmap offset from the pen
+	float top;                  // Bitmap top above the baseline
+	float advance;
+};
+
+struct glyph_font {
+	std::string key;
+	int refs;
+	int size;
+	float ascender;
+	float line_height;
+	bool embolden;              // No bold file: thicken the outlines
+	std::unordered_map<uint32_t, glyph_info> glyphs;
+#ifdef LOWERTHIRDS_HAVE_FREETYPE
+	FT_Face face;
+#endif
+};
+
+// Shelf packer rows: glyphs of similar height share a row
+struct atlas_shelf {
+	uint32_t y;
+	uint32_t height;
+	uint32_t x;                 // Next free column
+};
+
+static std::mutex atlas_mutex;
+static std::map<std::string, glyph_font *> atlas_fonts;
+static std::vector<uint8_t> atlas_pixels;
+static std::vector<atlas_shelf> atlas_shelves;
+static uint32_t atlas_cx = 0, atlas_cy = 0;
+static bool atlas_dirty = false;
+static bool atlas_full_logged = false;
+static uint64_t atlas_generation = 0;          // Bumped when packed glyphs move
+static gs_texture_t *atlas_texture = nullptr;
+static uint32_t texture_cx = 0, texture_cy = 0;
+static uint64_t glyphs_rasterized = 0;
+static uint64_t atlas_uploads = 0;
+static uint64_t atlas_repacks = 0;
+
+static std::vector<std::string> font_dirs;
+static std::map<std::string, std::string> font_files;  // Normalized stem -> path
+static bool font_files_scanned = false;
+
+// Lowercase letters and digits only: "Source Code Pro" and
+// "SourceCodePro-Regular" compare on "sourcecodepro"
+static std::string normalize_name(const std::string &name)
+{
+	std::string out;
+	for (char c : name) {
+		if (isalnum((unsigned char)c))
+			out += (char)tolower((unsigned char)c);
+	}
+	return out;
+}
+
+static void scan_font_dir(const std::filesystem::path &dir)
+{
+	std::error_code ec;
+	std::filesystem::recursive_directory_iterator it(dir,
+		std::filesystem::directory_options::skip_permission_denied, ec);
+	for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+		if (!it->is_regular_file(ec))
+			continue;
+		std::string ext = it->path().extension().string();
+		for (char &c : ext)
+			c = (char)tolower((unsigned char)c);
+		if (ext != ".ttf" && ext != ".otf" && ext != ".ttc")
+			continue;
+
+		// First directory wins: extra directories are scanned first
+		std::string stem = normalize_name(it->path().stem().string());
+		if (font_files.find(stem) == font_files.end())
+			font_files[stem] = it->path().string();
+	}
+}
+
+static void scan_font_files()
+{
+	if (font_files_scanned)
+		return;
+	font_files_scanned = true;
+
+	for (const std::string &dir : font_dirs)
+		scan_font_dir(dir);
+
+	const char *home = getenv("HOME");
+	std::string home_dir = home ? home : "";
+#if defined(_WIN32)
+	scan_font_dir("C:/Windows/Fonts");
+#elif defined(__APPLE__)
+	if (!home_dir.empty())
+		scan_font_dir(home_dir + "/Library/Fonts");
+	scan_font_dir("/Library/Fonts");
+	scan_font_dir("/System/Library/Fonts");
+#else
+	if (!home_dir.empty()) {
+		scan_font_dir(home_dir + "/.local/share/fonts");
+		scan_font_dir(home_dir + "/.fonts");
+	}
+	scan_font_dir("/usr/local/share/fonts");
+	scan_font_dir("/usr/share/fonts");
+#endif
+	blog(LOG_INFO, "Glyph atlas: %zu font files found", font_files.size());
+}
+
+// File for the face and style, else the regular file (a collection may
+// still hold the style; open_face() picks it, or the style is synthesized)
+static std::string find_font_file(const char *face, bool bold, bool italic)
+{
+	scan_font_files();
+	const std::string base = normalize_name(face);
+	static const char *bold_italic[] = {"bolditalic", "boldoblique", "bi", "z"};
+	static const char *bold_only[] = {"bold", "bd", "b"};
+	static const char *italic_only[] = {"italic", "oblique", "it", "i"};
+	static const char *regular[] = {"", "regular", "book", "roman"};
+
+	auto lookup = [&](const char *const *suffixes, size_t count) -> std::string {
+		for (size_t i = 0; i < count; i++) {
+			auto it = font_files.find(base + suffixes[i]);
+			if (it != font_files.end())
+				return it->second;
+		}
+		return std::string();
+	};
+
+	std::string path;
+	if (bold && italic)
+		path = lookup(bold_italic, 4);
+	else if (bold)
+		path = lookup(bold_only, 3);
+	else if (italic)
+		path = lookup(italic_only, 4);
+	if (path.empty())
+		path = lookup(regular, 4);
+	return path;
+}
+
+static void reset_atlas()
+{
+	atlas_cx = atlas_cy = atlas_initial;
+	atlas_pixels.assign((size_t)atlas_cx * atlas_cy, 0);
+	atlas_shelves.clear();
+	atlas_dirty = true;
+	atlas_full_logged = false;
+	atlas_generation++;
+}
+
+// Doubles the shorter side; glyphs keep their texel positions
+static bool grow_atlas()
+{
+	uint32_t new_cx = atlas_cx, new_cy = atlas_cy;
+	if (new_cy < new_cx)
+		new_cy *= 2;
+	else
+		new_cx *= 2;
+	if (new_cx > atlas_max || new_cy > atlas_max)
+		return false;
+
+	std::vector<uint8_t> pixels((size_t)new_cx * new_cy, 0);
+	for (uint32_t y = 0; y < atlas_cy; y++)
+		memcpy(&pixels[(size_t)y * new_cx], &atlas_pixels[(size_t)y * atlas_cx], atlas_cx);
+	atlas_pixels.swap(pixels);
+	atlas_cx = new_cx;
+	atlas_cy = new_cy;
+	atlas_dirty = true;
+	return true;
+}
+
+static bool pack_glyph(uint32_t w, uint32_t h, uint32_t *x, uint32_t *y)
+{
+	uint32_t pw = w + glyph_padding, ph = h + glyph_padding;
+	for (;;) {
+		// Tightest shelf that fits, without wasting over a third of it
+		atlas_shelf *best = nullptr;
+		for (atlas_shelf &shelf : atlas_shelves) {
+			if (shelf.height >= ph && shelf.height * 2 <= ph * 3 && shelf.x + pw <= atlas_cx &&
+				(!best || shelf.height < best->height))
+				best = &shelf;
+		}
+		if (!best) {
+			uint32_t top = atlas_shelves.empty() ? 0 :
+				atlas_shelves.back().y + atlas_shelves.back().height;
+			if (top + ph <= atlas_cy && pw <= atlas_cx) {
+				atlas_shelves.push_back({top, ph, 0});
+				best = &atlas_shelves.back();
+			}
+		}
+		if (best) {
+			*x = best->x;
+			*y = best->y;
+			best->x += pw;
+			return true;
+		}
+		if (!grow_atlas())
+			return false;
+	}
+}
+
+#ifdef LOWERTHIRDS_HAVE_FREETYPE
+
+static FT_Library ft_library = nullptr;
+
+// The atlas is at its largest and full: packs the live fonts' glyphs again
+// from scratch, tallest first, which frees the texels of fonts released
+// since (a font size drag leaves one per step). If they still do not fit
+// every font starts over and rasterizes its glyphs again on demand. Either
+// way the glyphs move, so layouts made before are stale; their owners
+// check glyph_atlas_generation().
+static void repack_atlas()
+{
+	std::vector<glyph_info *> packed;
+	for (auto &kv : atlas_fonts) {
+		for (auto &glyph : kv.second->glyphs) {
+			if (glyph.second.tw && glyph.second.th)
+				packed.push_back(&glyph.second);
+		}
+	}
+	std::sort(packed.begin(), packed.end(), [](const glyph_info *a, const glyph_info *b) {
+		return a->th > b->th;
+	});
+
+	std::vector<uint8_t> old_pixels((size_t)atlas_cx * atlas_cy, 0);
+	old_pixels.swap(atlas_pixels);
+	atlas_shelves.clear();
+	bool fits = true;
+	for (glyph_info *glyph : packed) {
+		uint32_t x, y;
+		if (!pack_glyph(glyph->tw, glyph->th, &x, &y)) {
+			fits = false;
+			break;
+		}
+		for (uint32_t row = 0; row < glyph->th; row++)
+			memcpy(&atlas_pixels[(size_t)(y + row) * atlas_cx + x],
+				&old_pixels[(size_t)(glyph->ty + row) * atlas_cx + glyph->tx], glyph->tw);
+		glyph->tx = (uint16_t)x;
+		glyph->ty = (uint16_t)y;
+	}
+	if (!fits) {
+		for (auto &kv : atlas_fonts)
+			kv.second->glyphs.clear();
+		std::fill(atlas_pixels.begin(), atlas_pixels.end(), 0);
+		atlas_shelves.clear();
+	}
+	blog(LOG_INFO, "Glyph atlas full (%ux%u): %s %zu glyphs of %zu fonts", atlas_cx, atlas_cy,
+		fits ? "repacked" : "cleared", packed.size(), atlas_fonts.size());
+	atlas_dirty = true;
+	atlas_generation++;
+	atlas_repacks++;
+}
+
+
+// Face of a file matching the style best (collections hold several)
+static FT_Face open_face(const std::string &path, bool bold, bool italic)
+{
+	FT_Face face = nullptr;
+	if (FT_New_Face(ft_library, path.c_str(), 0, &face) != 0)
+		return nullptr;
+
+	FT_Long faces = face->num_faces;
+	for (FT_Long i = 0; i < faces; i++) {
+		FT_Face candidate = face;
+		if (i > 0 && FT_New_Face(ft_library, path.c_str(), i, &candidate) != 0)
+			continue;
+		bool is_bold = (candidate->style_flags & FT_STYLE_FLAG_BOLD) != 0;
+		bool is_italic = (candidate->style_flags & FT_STYLE_FLAG_ITALIC) != 0;
+		if (is_bold == bold && is_italic == italic) {
+			if (candidate != face)
+				FT_Done_Face(face);
+			return candidate;
+		}
+		if (candidate != face)
+			FT_Done_Face(candidate);
+	}
+	return face;
+}
+
+static glyph_info *get_glyph(glyph_font *font, uint32_t codepoint)
+{
+	auto it = font->glyphs.find(codepoint);
+	if (it != font->glyphs.end())
+		return &it->second;
+
+	glyph_info glyph = {};
+	FT_Face face = font->face;
+	glyph.index = FT_Get_Char_Index(face, codepoint);
+	if (FT_Load_Glyph(face, glyph.index, FT_LOAD_DEFAULT | FT_LOAD_NO_BITMAP) == 0) {
+		FT_GlyphSlot slot = face->glyph;
+		FT_Pos strength = 0;
+		if (font->embolden && slot->format == FT_GLYPH_FORMAT_OUTLINE) {
+			strength = FT_MulFix(face->units_per_EM, face->size->metrics.y_scale) / 24;
+			FT_Outline_Embolden(&slot->outline, strength);
+		}
+		glyph.advance = (float)(slot->advance.x + strength) / 64.0f;
+
+		if (FT_Render_Glyph(slot, FT_RENDER_MODE_NORMAL) == 0 && slot->bitmap.width && slot->bitmap.rows) {
+			const FT_Bitmap &bitmap = slot->bitmap;
+			uint32_t x, y;
+			bool packed = pack_glyph(bitmap.width, bitmap.rows, &x, &y);
+			if (!packed && bitmap.width < atlas_max && bitmap.rows < atlas_max) {
+				repack_atlas();
+				packed = pack_glyph(bitmap.width, bitmap.rows, &x, &y);
+			}
+			if (packed) {
+				for (uint32_t row = 0; row < bitmap.rows; row++)
+					memcpy(&atlas_pixels[(size_t)(y + row) * atlas_cx + x],
+						bitmap.buffer + (ptrdiff_t)row * bitmap.pitch, bitmap.width);
+				glyph.tx = (uint16_t)x;
+				glyph.ty = (uint16_t)y;
+				glyph.tw = (uint16_t)bitmap.width;
+				glyph.th = (uint16_t)bitmap.rows;
+				atlas_dirty = true;
+			} else if (!atlas_full_logged) {
+				atlas_full_logged = true;
+				blog(LOG_WARNING, "Glyph atlas full (%ux%u), a glyph too large is not drawn", atlas_cx, atlas_cy);
+			}
+			glyph.left = (float)slot->bitmap_left;
+			glyph.top = (float)slot->bitmap_top;
+			glyphs_rasterized++;
+		}
+	}
+	return &font->glyphs.emplace(codepoint, glyph).first->second;
+}
+
+#endif
+
+glyph_font *glyph_font_acquire(const char *face, int size, uint32_t flags)
+{
+#ifdef LOWERTHIRDS_HAVE_FREETYPE
+	if (!face || !*face || size <= 0)
+		return nullptr;
+	flags &= OBS_FONT_BOLD | OBS_FONT_ITALIC;
+	char suffix[32];
+	snprintf(suffix, sizeof(suffix), "|%d|%u", size, flags);
+	std::string key = normalize_name(face) + suffix;
+
+	std::lock_guard<std::mutex> guard(atlas_mutex);
+	auto it = atlas_fonts.find(key);
+	if (it != atlas_fonts.end()) {
+		it->second->refs++;
+		return it->second;
+	}
+
+	bool bold = (flags & OBS_FONT_BOLD) != 0, italic = (flags & OBS_FONT_ITALIC) != 0;
+	std::string path = find_font_file(face, bold, italic);
+	if (path.empty())
+		return nullptr;
+	if (!ft_library && FT_Init_FreeType(&ft_library) != 0) {
+		ft_library = nullptr;
+		return nullptr;
+	}
+
+	FT_Face ft_face = open_face(path, bold, italic);
+	if (!ft_face || FT_Set_Pixel_Sizes(ft_face, 0, (FT_UInt)size) != 0) {
+		blog(LOG_WARNING, "Glyph atlas: could not load %s", path.c_str());
+		if (ft_face)
+			FT_Done_Face(ft_face);
+		if (atlas_fonts.empty()) {
+			FT_Done_FreeType(ft_library);
+			ft_library = nullptr;
+		}
+		return nullptr;
+	}
+
+	// A regular file standing in for a missing style: thicken for bold,
+	// shear for italic like FreeType's synthetic styles
+	bool face_bold = (ft_face->style_flags & FT_STYLE_FLAG_BOLD) != 0;
+	bool face_italic = (ft_face->style_flags & FT_STYLE_FLAG_ITALIC) != 0;
+	if (italic && !face_italic) {
+		FT_Matrix shear = {0x10000, 0x0366A, 0, 0x10000};
+		FT_Set_Transform(ft_face, &shear, nullptr);
+	}
+
+	if (atlas_fonts.empty())
+		reset_atlas();
+
+	glyph_font *font = new glyph_font();
+	font->key = key;
+	font->refs = 1;
+	font->size = size;
+	font->face = ft_face;
+	font->embolden = bold && !face_bold;
+	font->ascender = ceilf((float)ft_face->size->metrics.ascender / 64.0f);
+	font->line_height = ceilf((float)ft_face->size->metrics.height / 64.0f);
+	atlas_fonts[key] = font;
+	bool synthesized = (bold && !face_bold) || (italic && !face_italic);
+	blog(LOG_INFO, "Glyph atlas: %s %dpx%s%s from %s%s", face, size, bold ? " bold" : "",
+		italic ? " italic" : "", path.c_str(), synthesized ? " (synthesized style)" : "");
+	return font;
+#else
+	UNUSED_PARAMETER(face);
+	UNUSED_PARAMETER(size);
+	UNUSED_PARAMETER(flags);
+	return nullptr;
+#endif
+}
+
+void glyph_font_release(glyph_font *font)
+{
+	if (!font)
+		return;
+	std::lock_guard<std::mutex> guard(atlas_mutex);
+	if (--font->refs > 0)
+		return;
+	atlas_fonts.erase(font->key);
+#ifdef LOWERTHIRDS_HAVE_FREETYPE
+	FT_Done_Face(font->face);
+
+	// Glyphs of other fonts stay packed (the texels are reclaimed when the
+	// atlas fills up and is repacked); the atlas starts over once none is
+	// left
+	if (atlas_fonts.empty()) {
+		FT_Done_FreeType(ft_library);
+		ft_library = nullptr;
+		reset_atlas();
+	}
+#endif
+	delete font;
+}
+
+// Next code point of UTF-8 `s`; invalid bytes decode as U+FFFD
+static uint32_t next_codepoint(const unsigned char *&s)
+{
+	uint32_t c = *s++;
+	int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+	if (c >= 0x80 && extra == 0)
+		return 0xFFFD;
+	if (extra)
+		c &= 0x3F >> extra;
+	for (int i = 0; i < extra; i++) {
+		if ((*s & 0xC0) != 0x80)
+			return 0xFFFD;
+		c = (c << 6) | (*s++ & 0x3F);
+	}
+	return c;
+}
+
+void glyph_layout(glyph_font *font, const char *text, text_layout &out)
+{
+	out.quads.clear();
+	out.width = 0;
+	out.height = 0;
+	out.baseline = 0.0f;
+	if (!font || !text || !*text)
+		return;
+
+#ifdef LOWERTHIRDS_HAVE_FREETYPE
+	std::lock_guard<std::mutex> guard(atlas_mutex);
+	const bool kerning = FT_HAS_KERNING(font->face);
+	float pen = 0.0f, widest = 0.0f;
+	float baseline = font->ascender;
+	int lines = 1;
+	uint32_t previous = 0;
+
+	// A glyph that repacks the atlas moves the ones laid out before it:
+	// start over once with the string's glyphs already in
+	uint64_t generation = atlas_generation;
+	bool restarted = false;
+	const unsigned char *s = (const unsigned char *)text;
+	while (*s) {
+		uint32_t c = next_codepoint(s);
+		if (c == '\r')
+			continue;
+		if (c == '\n') {
+			widest = fmaxf(widest, pen);
+			pen = 0.0f;
+			baseline += font->line_height;
+			lines++;
+			previous = 0;
+			continue;
+		}
+
+		glyph_info *glyph = get_glyph(font, c);
+		if (atlas_generation != generation && !restarted) {
+			restarted = true;
+			generation = atlas_generation;
+			out.quads.clear();
+			pen = widest = 0.0f;
+			baseline = font->ascender;
+			lines = 1;
+			previous = 0;
+			s = (const unsigned char *)text;
+			continue;
+		}
+		if (kerning && previous && glyph->index) {
+			FT_Vector delta;
+			if (FT_Get_Kerning(font->face, previous, glyph->index, FT_KERNING_DEFAULT, &delta) == 0)
+				pen += (float)delta.x / 64.0f;
+		}
+		if (glyph->tw && glyph->th) {
+			glyph_quad quad;
+			quad.x0 = roundf(pen + glyph->left);
+			quad.y0 = baseline - glyph->top;
+			quad.x1 = quad.x0 + glyph->tw;
+			quad.y1 = quad.y0 + glyph->th;
+			quad.tx = glyph->tx;
+			quad.ty = glyph->ty;
+			quad.tw = glyph->tw;
+			quad.th = glyph->th;
+			out.quads.push_back(quad);
+		}
+		pen += glyph->advance;
+		previous = glyph->index;
+	}
+
+	out.width = (uint32_t)ceilf(fmaxf(widest, pen));
+	out.height = (uint32_t)(font->line_height * lines);
+	out.baseline = font->ascender;
+#endif
+}
+
+gs_texture_t *glyph_atlas_texture()
+{
+	std::lock_guard<std::mutex> guard(atlas_mutex);
+	if (atlas_pixels.empty())
+		return atlas_texture;
+
+	if (atlas_texture && (texture_cx != atlas_cx || texture_cy != atlas_cy)) {
+		gs_texture_destroy(atlas_texture);
+		atlas_texture = nullptr;
+	}
+	if (!atlas_texture) {
+		const uint8_t *planes = atlas_pixels.data();
+		atlas_texture = gs_texture_create(atlas_cx, atlas_cy, GS_R8, 1, &planes, GS_DYNAMIC);
+		texture_cx = atlas_cx;
+		texture_cy = atlas_cy;
+		atlas_dirty = false;
+		atlas_uploads++;
+	} else if (atlas_dirty) {
+		gs_texture_set_image(atlas_texture, atlas_pixels.data(), atlas_cx, false);
+		atlas_dirty = false;
+		atlas_uploads++;
+	}
+	return atlas_texture;
+}
+
+uint64_t glyph_atlas_generation()
+{
+	std::lock_guard<std::mutex> guard(atlas_mutex);
+	return atlas_generation;
+}
+
+void glyph_atlas_size(uint32_t *cx, uint32_t *cy)
+{
+	std::lock_guard<std::mutex> guard(atlas_mutex);
+	*cx = atlas_cx;
+	*cy = atlas_cy;
+}
+
+void glyph_atlas_trim()
+{
+	std::lock_guard<std::mutex> guard(atlas_mutex);
+	if (!atlas_fonts.empty())
+		return;
+	if (atlas_texture)
+		gs_texture_destroy(atlas_texture);
+	atlas_texture = nullptr;
+	texture_cx = texture_cy = 0;
+	atlas_pixels.clear();
+	atlas_pixels.shrink_to_fit();
+	atlas_shelves.clear();
+	atlas_cx = atlas_cy = 0;
+}
+
+void glyph_atlas_add_font_dir(const char *dir)
+{
+	if (!dir || !*dir)
+		return;
+	std::lock_guard<std::mutex> guard(atlas_mutex);
+	font_dirs.push_back(dir);
+	font_files.clear();
+	font_files_scanned = false;
+}
+
+void glyph_atlas_get_stats(glyph_atlas_stats *stats)
+{
+	std::lock_guard<std::mutex> guard(atlas_mutex);
+	stats->fonts = atlas_fonts.size();
+	stats->glyphs = 0;
+	for (const auto &kv : atlas_fonts)
+		stats->glyphs += kv.second->glyphs.size();
+	stats->rasterized = glyphs_rasterized;
+	stats->uploads = atlas_uploads;
+	stats->repacks = atlas_repacks;
+	stats->cx = atlas_cx;
+	stats->cy = atlas_cy;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+#include <stdint.h>
+#include <vector>
+
+// Built-in text rasterization: FreeType glyphs packed into one process-wide
+// single-channel atlas that every lower-third source shares. Fonts are
+// refcounted and keyed by face name + pixel size + OBS_FONT_* flags, so
+// thirty sources with the same title font rasterize each glyph once.
+//
+// Layout is plain CPU work (no graphics context), which is what keeps it
+// testable headlessly; only glyph_atlas_texture() touches the GPU.
+// Without FreeType (LOWERTHIRDS_HAVE_FREETYPE unset) or without a matching
+// font file every acquire returns null and callers keep the text sources.
+
+struct glyph_font;
+
+// Positioned glyph, in pixels with the layout's top-left at (0, 0); the
+// atlas rect is in texels (the atlas may grow, see glyph_atlas_size())
+struct glyph_quad {
+	float x0, y0, x1, y1;
+	uint16_t tx, ty, tw, th;
+};
+
+struct text_layout {
+	std::vector<glyph_quad> quads;
+	uint32_t width;             // Widest line's advance, like the text sources
+	uint32_t height;            // Line height times lines
+	float baseline;             // Top to the first line's baseline
+};
+
+// Any thread. Null if the face has no font file in the search path or the
+// file does not load. `flags` are OBS_FONT_BOLD / OBS_FONT_ITALIC.
+glyph_font *glyph_font_acquire(const char *face, int size, uint32_t flags);
+void glyph_font_release(glyph_font *font);
+
+// Any thread. Lays out UTF-8 `text` (newlines start a new line), rasterizing
+// glyphs the atlas does not have yet.
+void glyph_layout(glyph_font *font, const char *text, text_layout &out);
+
+// Any thread. Changes whenever glyphs move in the atlas (it filled up and
+// was repacked): layouts made under an older generation point at the wrong
+// texels and must be laid out again.
+uint64_t glyph_atlas_generation();
+
+// Graphics thread: the atlas texture (GS_R8, coverage in red) with every
+// glyph rasterized so far uploaded
+gs_texture_t *glyph_atlas_texture();
+void glyph_atlas_size(uint32_t *cx, uint32_t *cy);
+
+// Graphics thread: frees the texture once no font is left (sources call it
+// on destroy)
+void glyph_atlas_trim();
+
+// Extra directory searched before the system font directories
+void glyph_atlas_add_font_dir(const char *dir);
+
+struct glyph_atlas_stats {
+	size_t fonts;               // Live glyph_font entries
+	size_t glyphs;              // Rasterized glyphs over all fonts
+	uint64_t rasterized;        // FT_Render_Glyph calls since startup
+	uint64_t uploads;           // Atlas texture updates since startup
+	uint64_t repacks;           // Full atlas repacked (or cleared) since startup
+	uint32_t cx, cy;            // Atlas size
+};
+
+void glyph_atlas_get_stats(glyph_atlas_stats *stats);
@@ -0,0 +1,175 @@
+/**
+ * Lower Thirds Plus - batched glyph quads
+ *
+ * See glyph-batch.hpp.
+ */
+
+#include "glyph-batch.hpp"
+#include <graphics/matrix4.h>
+#include <graphics/vec2.h>
+#include <util/bmem.h>
+#include <string.h>
+
+glyph_batch::glyph_batch()
+	: vbuf(nullptr)
+	, data(nullptr)
+	, capacity(0)
+	, count(0)
+	, effect(nullptr)
+	, image(nullptr)
+	, texel_size(nullptr)
+	, load_failed(false)
+{
+}
+
+bool glyph_batch::load()
+{
+	if (effect)
+		return true;
+	if (load_failed)
+		return false;
+
+	char *path = obs_module_file("effects/glyph-text.effect");
+	char *errors = nullptr;
+	if (path)
+		effect = gs_effect_create_from_file(path, &errors);
+	if (effect) {
+		image = gs_effect_get_param_by_name(effect, "image");
+		texel_size = gs_effect_get_param_by_name(effect, "texel_size");
+		if (!image || !texel_size) {
+			gs_effect_destroy(effect);
+			effect = nullptr;
+		}
+	}
+
+	if (!effect) {
+		load_failed = true;
+		blog(LOG_WARNING, "Glyph text effect unavailable (%s), using text sources%s%s",
+			path ? path : "effects/glyph-text.effect", errors ? ": " : "",
+			errors ? errors : "");
+	}
+	bfree(errors);
+	bfree(path);
+	return effect != nullptr;
+}
+
+void glyph_batch::begin()
+{
+	count = 0;
+}
+
+bool glyph_batch::grow(size_t num)
+{
+	// A few strings of a few dozen glyphs; grow geometrically for long ones
+	size_t new_capacity = capacity ? capacity : 768;
+	while (new_capacity < num)
+		new_capacity *= 2;
+
+	struct gs_vb_data *vb_data = gs_vbdata_create();
+	vb_data->num = new_capacity;
+	vb_data->points = (struct vec3 *)bmalloc(sizeof(struct vec3) * new_capacity);
+	vb_data->colors = (uint32_t *)bmalloc(sizeof(uint32_t) * new_capacity);
+	vb_data->num_tex = 1;
+	vb_data->tvarray = (struct gs_tvertarray *)bzalloc(sizeof(struct gs_tvertarray));
+	vb_data->tvarray[0].width = 2;
+	vb_data->tvarray[0].array = bmalloc(sizeof(struct vec2) * new_capacity);
+
+	gs_vertbuffer_t *new_vbuf = gs_vertexbuffer_create(vb_data, GS_DYNAMIC);
+	if (!new_vbuf) {
+		gs_vbdata_destroy(vb_data);
+		return false;
+	}
+
+	struct gs_vb_data *new_data = gs_vertexbuffer_get_data(new_vbuf);
+	size_t kept = count;
+	if (kept) {
+		memcpy(new_data->points, data->points, sizeof(struct vec3) * kept);
+		memcpy(new_data->colors, data->colors, sizeof(uint32_t) * kept);
+		memcpy(new_data->tvarray[0].array, data->tvarray[0].array, sizeof(struct vec2) * kept);
+	}
+
+	if (vbuf)
+		gs_vertexbuffer_destroy(vbuf);
+	vbuf = new_vbuf;
+	data = new_data;
+	capacity = new_capacity;
+	count = kept;
+	return true;
+}
+
+void glyph_batch::add(const text_layout &layout, uint32_t color)
+{
+	size_t needed = count + layout.quads.size() * 6;
+	if (layout.quads.empty() || (needed > capacity && !grow(needed)))
+		return;
+
+	// World position = local * matrix (row vectors, like libobs)
+	struct matrix4 m;
+	gs_matrix_get(&m);
+	auto transform = [&m](float x, float y, struct vec3 *out) {
+		vec3_set(out, x * m.x.x + y * m.y.x + m.t.x, x * m.x.y + y * m.y.y + m.t.y,
+			x * m.x.z + y * m.y.z + m.t.z);
+	};
+
+	struct vec2 *uvs = (struct vec2 *)data->tvarray[0].array;
+	for (const glyph_quad &q : layout.quads) {
+		// uv in texels; the effect divides by the atlas size, which may
+		// still grow this frame
+		float u0 = q.tx, v0 = q.ty, u1 = (float)(q.tx + q.tw), v1 = (float)(q.ty + q.th);
+		const float corners[6][4] = {
+			{q.x0, q.y0, u0, v0}, {q.x1, q.y0, u1, v0}, {q.x0, q.y1, u0, v1},
+			{q.x1, q.y0, u1, v0}, {q.x1, q.y1, u1, v1}, {q.x0, q.y1, u0, v1},
+		};
+		for (const float *c : corners) {
+			transform(c[0], c[1], &data->points[count]);
+			data->colors[count] = color;
+			vec2_set(&uvs[count], c[2], c[3]);
+			count++;
+		}
+	}
+}
+
+void glyph_batch::draw()
+{
+	if (!vbuf || count == 0 || !load())
+		return;
+
+	gs_texture_t *atlas = glyph_atlas_texture();
+	if (!atlas)
+		return;
+	uint32_t atlas_cx, atlas_cy;
+	glyph_atlas_size(&atlas_cx, &atlas_cy);
+	struct vec2 texel;
+	vec2_set(&texel, 1.0f / (float)atlas_cx, 1.0f / (float)atlas_cy);
+
+	gs_effect_set_texture(image, atlas);
+	gs_effect_set_vec2(texel_size, &texel);
+
+	gs_vertexbuffer_flush(vbuf);
+	gs_load_vertexbuffer(vbuf);
+	gs_load_indexbuffer(nullptr);
+
+	// Vertices are already in world space
+	gs_matrix_push();
+	gs_matrix_identity();
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw(GS_TRIS, 0, (uint32_t)count);
+	gs_matrix_pop();
+
+	gs_load_vertexbuffer(nullptr);
+}
+
+void glyph_batch::destroy()
+{
+	if (vbuf)
+		gs_vertexbuffer_destroy(vbuf);
+	vbuf = nullptr;
+	data = nullptr;
+	capacity = 0;
+	count = 0;
+	gs_effect_destroy(effect);
+	effect = nullptr;
+	image = nullptr;
+	texel_size = nullptr;
+	load_failed = false;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+#include "glyph-atlas.hpp"
+
+// Glyph quads of every string a source draws in a frame (title, subtitle,
+// right-side strings and their shadows), submitted in one gs_draw through
+// data/effects/glyph-text.effect. Each string is added under the caller's
+// usual gs_matrix_* transform, which is baked into its vertices, so the
+// strings keep their own slide, scale and offset animations.
+//
+// Must only be used from the graphics thread.
+
+struct glyph_batch {
+	gs_vertbuffer_t *vbuf;
+	struct gs_vb_data *data;
+	size_t capacity;            // Vertices
+	size_t count;
+	gs_effect_t *effect;
+	gs_eparam_t *image;
+	gs_eparam_t *texel_size;    // 1 / atlas size (uvs are in texels)
+	bool load_failed;           // Only try (and log) once
+
+	glyph_batch();
+
+	// Compiles the effect on first use; false if it is unavailable (callers
+	// then keep the text sources)
+	bool load();
+
+	void begin();
+
+	// The layout's glyphs under the current matrix, `color` ABGR with the
+	// string's alpha in the top byte
+	void add(const text_layout &layout, uint32_t color);
+
+	// Uploads the atlas if glyphs were added and draws everything since
+	// begin() as GS_TRIS
+	void draw();
+
+	void destroy();
+
+private:
+	bool grow(size_t num);
+};
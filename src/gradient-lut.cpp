@@ -0,0 +1,153 @@
+/**
+ * Lower Thirds Plus - multi-stop gradient LUT
+ *
+ * See gradient-lut.hpp.
+ */
+
+#include "gradient-lut.hpp"
+#include <graphics/vec2.h>
+#include <graphics/vec3.h>
+#include <graphics/vec4.h>
+#include <util/bmem.h>
+#include <math.h>
+#include <string.h>
+
+gradient_lut::gradient_lut()
+	: effect(nullptr)
+	, image(nullptr)
+	, linear_axis(nullptr)
+	, radial_scale(nullptr)
+	, opacity(nullptr)
+	, texture(nullptr)
+	, baked()
+	, baked_count(0)
+	, load_failed(false)
+{
+}
+
+bool gradient_lut::load()
+{
+	if (effect)
+		return true;
+	if (load_failed)
+		return false;
+
+	char *path = obs_module_file("effects/gradient.effect");
+	char *errors = nullptr;
+	if (path)
+		effect = gs_effect_create_from_file(path, &errors);
+
+	if (effect) {
+		image = gs_effect_get_param_by_name(effect, "image");
+		linear_axis = gs_effect_get_param_by_name(effect, "linear_axis");
+		radial_scale = gs_effect_get_param_by_name(effect, "radial_scale");
+		opacity = gs_effect_get_param_by_name(effect, "opacity");
+		if (!image || !linear_axis || !radial_scale || !opacity) {
+			gs_effect_destroy(effect);
+			effect = nullptr;
+		}
+	}
+
+	if (!effect) {
+		load_failed = true;
+		blog(LOG_WARNING, "Gradient effect unavailable (%s), using two-color gradients%s%s",
+			path ? path : "effects/gradient.effect", errors ? ": " : "",
+			errors ? errors : "");
+	}
+	bfree(errors);
+	bfree(path);
+	return effect != nullptr;
+}
+
+void gradient_lut::destroy()
+{
+	gs_effect_destroy(effect);
+	gs_texture_destroy(texture);
+	effect = nullptr;
+	image = linear_axis = radial_scale = opacity = nullptr;
+	texture = nullptr;
+	baked_count = 0;
+	load_failed = false;
+}
+
+bool gradient_lut::bake(const uint32_t *stops, int count)
+{
+	if (count < 2)
+		count = 2;
+	if (count > GRADIENT_MAX_STOPS)
+		count = GRADIENT_MAX_STOPS;
+	if (texture && count == baked_count && memcmp(stops, baked, sizeof(uint32_t) * count) == 0)
+		return true;
+
+	// Straight (not premultiplied) RGBA, interpolated like per-vertex colors
+	struct vec4 colors[GRADIENT_MAX_STOPS];
+	for (int i = 0; i < count; i++)
+		vec4_from_rgba(&colors[i], stops[i]);
+
+	uint32_t pixels[GRADIENT_LUT_WIDTH];
+	for (int x = 0; x < GRADIENT_LUT_WIDTH; x++) {
+		float pos = (float)x / (GRADIENT_LUT_WIDTH - 1) * (count - 1);
+		int i = (int)pos;
+		if (i > count - 2)
+			i = count - 2;
+		float f = pos - (float)i;
+
+		struct vec4 c;
+		vec4_sub(&c, &colors[i + 1], &colors[i]);
+		vec4_mulf(&c, &c, f);
+		vec4_add(&c, &c, &colors[i]);
+		pixels[x] = vec4_to_rgba(&c);
+	}
+
+	gs_texture_destroy(texture);
+	const uint8_t *planes = (const uint8_t *)pixels;
+	texture = gs_texture_create(GRADIENT_LUT_WIDTH, 1, GS_RGBA, 1, &planes, 0);
+	if (!texture) {
+		baked_count = 0;
+		return false;
+	}
+	memcpy(baked, stops, sizeof(uint32_t) * count);
+	baked_count = count;
+	return true;
+}
+
+bool gradient_lut::draw_linear(const uint32_t *stops, int count, float width, float height,
+	const float corner_t[3], float alpha)
+{
+	if (!load() || !bake(stops, count))
+		return false;
+
+	// t(u, v) = t_tl + (t_tr - t_tl) * u + (t_bl - t_tl) * v
+	struct vec3 axis;
+	vec3_set(&axis, corner_t[1] - corner_t[0], corner_t[2] - corner_t[0], corner_t[0]);
+	gs_effect_set_vec3(linear_axis, &axis);
+	return draw("Linear", width, height, alpha);
+}
+
+bool gradient_lut::draw_radial(const uint32_t *stops, int count, float width, float height, float alpha)
+{
+	if (!load() || !bake(stops, count))
+		return false;
+
+	// Half the diagonal maps to 1, so the corners get the last stop
+	float half_diagonal = 0.5f * sqrtf(width * width + height * height);
+	struct vec2 scale;
+	vec2_set(&scale, half_diagonal > 0.0f ? width / half_diagonal : 0.0f,
+		half_diagonal > 0.0f ? height / half_diagonal : 0.0f);
+	gs_effect_set_vec2(radial_scale, &scale);
+	return draw("Radial", width, height, alpha);
+}
+
+bool gradient_lut::draw(const char *technique, float width, float height, float alpha)
+{
+	gs_effect_set_texture(image, texture);
+	gs_effect_set_float(opacity, alpha);
+
+	// Unit sprite scaled to the bar, uv 0..1 across it
+	gs_matrix_push();
+	gs_matrix_scale3f(width, height, 1.0f);
+	while (gs_effect_loop(effect, technique))
+		gs_draw_sprite(nullptr, 0, 1, 1);
+	gs_matrix_pop();
+	return true;
+}
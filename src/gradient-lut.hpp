@@ -0,0 +1,49 @@
+#pragma once
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+#include <stdint.h>
+
+// Multi-stop background gradients (data/effects/gradient.effect). The color
+// stops are baked into a GRADIENT_LUT_WIDTH x 1 texture only when they
+// change; every frame is then a single textured quad whose pixel shader
+// turns its position into a gradient position and samples the LUT, so a
+// richer gradient costs the same as a solid fill.
+//
+// Must only be used from the graphics thread.
+
+#define GRADIENT_MAX_STOPS 8
+#define GRADIENT_LUT_WIDTH 256      // Texels; the effect's remap assumes this
+
+struct gradient_lut {
+	gs_effect_t *effect;
+	gs_eparam_t *image;
+	gs_eparam_t *linear_axis;
+	gs_eparam_t *radial_scale;
+	gs_eparam_t *opacity;
+	gs_texture_t *texture;
+	uint32_t baked[GRADIENT_MAX_STOPS]; // Stops (ABGR) the texture holds
+	int baked_count;                    // 0 = nothing baked yet
+	bool load_failed;                   // Only try (and log) once
+
+	gradient_lut();
+
+	// Compiles the effect on first use; false if it is unavailable
+	bool load();
+	void destroy();
+
+	// Gradient over (0, 0)-(width, height) in the current transform, stops
+	// evenly spaced from position 0 to 1. `corner_t` is the gradient
+	// position at the top-left, top-right and bottom-left corner (linear
+	// gradients are affine). `opacity` multiplies the stops' own alpha.
+	// False (nothing drawn) if the effect is unavailable.
+	bool draw_linear(const uint32_t *stops, int count, float width, float height,
+		const float corner_t[3], float opacity);
+
+	// Same, position 0 at the center and 1 at the corners
+	bool draw_radial(const uint32_t *stops, int count, float width, float height, float opacity);
+
+private:
+	bool bake(const uint32_t *stops, int count);
+	bool draw(const char *technique, float width, float height, float opacity);
+};
@@ -0,0 +1,180 @@
+/**
+ * Lower Thirds Plus - shared image cache
+ *
+ * See image-cache.hpp.
+ */
+
+#include "image-cache.hpp"
+#include "image-resample.hpp"
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <sys/stat.h>
+#include <vector>
+
+static std::mutex cache_mutex;
+static std::condition_variable cache_decoded;
+static std::map<std::string, shared_image *> cache_entries;
+
+// Canonical path + mtime + size + fit; empty if the file cannot be found
+static std::string image_key(const char *path, const image_fit &fit)
+{
+	char *abs_path = os_get_abs_path_ptr(path);
+	struct stat st;
+	std::string key;
+	if (abs_path && os_stat(abs_path, &st) == 0) {
+		char suffix[64];
+		snprintf(suffix, sizeof(suffix), "|%lld|%lld|%ux%u%s", (long long)st.st_mtime,
+			(long long)st.st_size, fit.max_cx, fit.max_cy, fit.mipmaps ? "|mips" : "");
+		key = std::string(abs_path) + suffix;
+	}
+	bfree(abs_path);
+	return key;
+}
+
+static bool fit_format(enum gs_color_format format)
+{
+	return format == GS_RGBA || format == GS_BGRA || format == GS_BGRX;
+}
+
+// Worker thread, right after the decode: shrinks the pixels to the fit and
+// builds the mip chain. Formats the resampler doesn't handle (animated GIFs
+// keep their frames elsewhere) are uploaded as decoded.
+static void fit_image(shared_image *entry, const char *path, const image_fit &fit)
+{
+	gs_image_file_t &image = entry->image;
+	if (!image.loaded || !image.texture_data || image.is_animated_gif || !fit_format(image.format))
+		return;
+
+	uint64_t start = os_gettime_ns();
+	uint32_t cx = fit.max_cx && image.cx > fit.max_cx ? fit.max_cx : image.cx;
+	uint32_t cy = fit.max_cy && image.cy > fit.max_cy ? fit.max_cy : image.cy;
+	bool scaled = cx != image.cx || cy != image.cy;
+	if ((scaled || fit.mipmaps) && image.format == GS_BGRX) {
+		// The fourth byte is padding, not alpha; make it opaque so the
+		// filters don't average garbage into the alpha
+		size_t count = (size_t)image.cx * image.cy;
+		for (size_t i = 0; i < count; i++)
+			image.texture_data[i * 4 + 3] = 0xFF;
+	}
+	if (scaled) {
+		uint8_t *pixels = (uint8_t *)bmalloc((size_t)cx * cy * 4);
+		image_downscale(image.texture_data, image.cx, image.cy, pixels, cx, cy);
+		bfree(image.texture_data);
+		image.texture_data = pixels;
+	}
+
+	if (fit.mipmaps) {
+		entry->levels = image_mip_levels(cx, cy);
+		entry->mips = (uint8_t *)bmalloc(image_mip_size(cx, cy, entry->levels));
+		image_build_mips(image.texture_data, cx, cy, entry->levels, entry->mips);
+	}
+
+	if (scaled || fit.mipmaps)
+		blog(LOG_INFO, "Fitted image %s: %ux%u -> %ux%u, %u mip levels (%.1f ms)", path, image.cx,
+			image.cy, cx, cy, entry->levels, (double)(os_gettime_ns() - start) / 1000000.0);
+	image.cx = cx;
+	image.cy = cy;
+}
+
+shared_image *image_cache_acquire(const char *path, const image_fit &fit)
+{
+	if (!path || !*path)
+		return nullptr;
+	std::string key = image_key(path, fit);
+	if (key.empty()) {
+		blog(LOG_WARNING, "Image not found: %s", path);
+		return nullptr;
+	}
+
+	std::unique_lock<std::mutex> guard(cache_mutex);
+	auto it = cache_entries.find(key);
+	if (it != cache_entries.end()) {
+		shared_image *entry = it->second;
+		entry->refs++;
+		cache_decoded.wait(guard, [entry] { return !entry->decoding; });
+		return entry;
+	}
+
+	shared_image *entry = new shared_image();
+	entry->key = key;
+	entry->refs = 1;
+	entry->decoding = true;
+	entry->levels = 1;
+	entry->mips = nullptr;
+	cache_entries[key] = entry;
+	guard.unlock();
+
+	// Decode outside the lock; same-key acquirers wait above
+	gs_image_file_init(&entry->image, path);
+	fit_image(entry, path, fit);
+
+	guard.lock();
+	entry->decoding = false;
+	guard.unlock();
+	cache_decoded.notify_all();
+	return entry;
+}
+
+void image_cache_release(shared_image *entry)
+{
+	if (!entry)
+		return;
+	{
+		std::lock_guard<std::mutex> guard(cache_mutex);
+		if (--entry->refs > 0)
+			return;
+		cache_entries.erase(entry->key);
+	}
+
+	obs_enter_graphics();
+	gs_image_file_free(&entry->image);
+	obs_leave_graphics();
+	bfree(entry->mips);
+	delete entry;
+}
+
+gs_texture_t *shared_image::texture()
+{
+	// Only the graphics thread writes it; the lock orders the write
+	// against image_cache_stats()
+	if (image.texture || !image.loaded)
+		return image.texture;
+
+	std::lock_guard<std::mutex> guard(cache_mutex);
+	if (levels > 1) {
+		std::vector<const uint8_t *> planes(levels);
+		planes[0] = image.texture_data;
+		uint32_t cx = image.cx, cy = image.cy;
+		for (uint32_t l = 1; l < levels; l++) {
+			planes[l] = l == 1 ? mips : planes[l - 1] + (size_t)cx * cy * 4;
+			cx = cx > 1 ? cx / 2 : 1;
+			cy = cy > 1 ? cy / 2 : 1;
+		}
+		image.texture = gs_texture_create(image.cx, image.cy, image.format, levels, planes.data(), 0);
+	} else {
+		gs_image_file_init_texture(&image);
+	}
+
+	// The texture holds its own copy
+	if (image.texture && !image.is_animated_gif) {
+		bfree(image.texture_data);
+		image.texture_data = nullptr;
+		bfree(mips);
+		mips = nullptr;
+	}
+	return image.texture;
+}
+
+void image_cache_stats(size_t *entries, size_t *textures)
+{
+	std::lock_guard<std::mutex> guard(cache_mutex);
+	*entries = cache_entries.size();
+	*textures = 0;
+	for (const auto &kv : cache_entries) {
+		if (kv.second->image.texture)
+			(*textures)++;
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <obs-module.h>
+#include <graphics/image-file.h>
+#include <string>
+
+// Process-wide cache of decoded images shared by every lower-third source.
+// Entries are keyed by canonical path + modification time + file size + the
+// fit below, so thirty sources showing the same logo decode it once and hold
+// one texture, while an edited file gets a fresh entry. Entries are
+// refcounted and freed (texture included) when the last user releases them.
+
+// Largest size an image is drawn at. Larger decodes are downscaled to it
+// (per axis, see image-resample.hpp) before upload; 0 leaves an axis alone.
+struct image_fit {
+	uint32_t max_cx;
+	uint32_t max_cy;
+	bool mipmaps;               // Upload a full mip chain (scaled or spun images)
+
+	bool operator==(const image_fit &o) const
+	{
+		return max_cx == o.max_cx && max_cy == o.max_cy && mipmaps == o.mipmaps;
+	}
+	bool operator!=(const image_fit &o) const { return !(*this == o); }
+};
+
+struct shared_image {
+	std::string key;
+	gs_image_file_t image;      // texture is set by the first texture() call
+	int refs;
+	bool decoding;              // Another thread is decoding this key
+	uint32_t levels;            // Mip levels, 1 without mipmaps
+	uint8_t *mips;              // Levels 1.. until uploaded
+
+	// Graphics thread: the texture, uploaded on first use (null if the
+	// file did not decode). The CPU copies are freed once uploaded.
+	gs_texture_t *texture();
+};
+
+// Any thread except the graphics thread (it may decode or wait for another
+// thread's decode of the same key). Null for an empty or missing path.
+shared_image *image_cache_acquire(const char *path, const image_fit &fit);
+
+// Any thread. Frees the entry with the last reference.
+void image_cache_release(shared_image *entry);
+
+// Live entries and how many hold a texture (for the bench and the log)
+void image_cache_stats(size_t *entries, size_t *textures);
@@ -0,0 +1,147 @@
+/**
+ * Lower Thirds Plus - asynchronous image loading
+ *
+ * See image-loader.hpp.
+ */
+
+#include "image-loader.hpp"
+#include <util/platform.h>
+
+image_loader::image_loader(const char *label)
+	: label(label)
+	, stopping(false)
+	, generation(0)
+	, queued_fit()
+	, queued(false)
+	, queued_at(0)
+	, ready(nullptr)
+	, ready_valid(false)
+	, ready_requested_at(0)
+	, ready_decode_ms(0.0)
+{
+}
+
+void image_loader::request(const char *path, const image_fit &fit)
+{
+	shared_image *dropped = nullptr;
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		generation++;
+
+		// A finished decode nobody displayed yet is already stale
+		if (ready_valid) {
+			dropped = ready;
+			ready = nullptr;
+			ready_valid = false;
+		}
+
+		if (!path || !*path) {
+			// Nothing to decode: clear on the next frame
+			queued = false;
+			ready = nullptr;
+			ready_valid = true;
+			ready_path.clear();
+			ready_requested_at = os_gettime_ns();
+			ready_decode_ms = 0.0;
+		} else {
+			queued_path = path;
+			queued_fit = fit;
+			queued = true;
+			queued_at = os_gettime_ns();
+			if (!worker.joinable())
+				worker = std::thread(&image_loader::run, this);
+		}
+	}
+	wake.notify_one();
+
+	// Only reachable on repeated changes before a frame rendered
+	image_cache_release(dropped);
+}
+
+void image_loader::run()
+{
+	std::unique_lock<std::mutex> guard(mutex);
+	for (;;) {
+		wake.wait(guard, [this] { return stopping || queued; });
+		if (stopping)
+			break;
+
+		std::string path = queued_path;
+		image_fit fit = queued_fit;
+		uint64_t requested_at = queued_at;
+		uint64_t job = generation;
+		queued = false;
+		guard.unlock();
+
+		uint64_t start = os_gettime_ns();
+		shared_image *image = image_cache_acquire(path.c_str(), fit);
+		double decode_ms = (double)(os_gettime_ns() - start) / 1000000.0;
+
+		guard.lock();
+		if (job != generation) {
+			// The path changed while decoding; the newer request is queued
+			blog(LOG_INFO, "Dropped stale %s image decode: %s (%.1f ms)", label, path.c_str(), decode_ms);
+			guard.unlock();
+			image_cache_release(image);
+			guard.lock();
+			continue;
+		}
+
+		ready = image;
+		ready_valid = true;
+		ready_path = path;
+		ready_requested_at = requested_at;
+		ready_decode_ms = decode_ms;
+	}
+}
+
+bool image_loader::swap(shared_image *&current)
+{
+	shared_image *image;
+	std::string path;
+	uint64_t requested_at;
+	double decode_ms;
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		if (!ready_valid)
+			return false;
+		image = ready;
+		path = ready_path;
+		requested_at = ready_requested_at;
+		decode_ms = ready_decode_ms;
+		ready = nullptr;
+		ready_valid = false;
+	}
+
+	if (image) {
+		image->texture();
+		size_t entries, textures;
+		image_cache_stats(&entries, &textures);
+		blog(LOG_INFO, "Loaded %s image %s: acquired in %.1f ms off the update thread, "
+			"on screen %.1f ms after the change (%zu shared images, %zu textures)", label,
+			path.c_str(), decode_ms, (double)(os_gettime_ns() - requested_at) / 1000000.0,
+			entries, textures);
+	}
+
+	image_cache_release(current);
+	current = image;
+	return true;
+}
+
+void image_loader::destroy()
+{
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		stopping = true;
+		generation++;
+	}
+	wake.notify_one();
+	if (worker.joinable())
+		worker.join();
+
+	image_cache_release(ready);
+	ready = nullptr;
+	ready_valid = false;
+	queued = false;
+	stopping = false;
+}
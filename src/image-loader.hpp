@@ -0,0 +1,54 @@
+#pragma once
+
+#include <obs-module.h>
+#include "image-cache.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Background decoding for the background and logo images. update() only
+// hands the path to request(); a worker thread acquires it from the shared
+// image cache (file read + decode, unless another source already holds the
+// same file), and the graphics thread uploads it in swap() on its next
+// frame, so the old image stays on screen until then. Oversized files are
+// downscaled to the requested fit on the worker as well.
+// A request made while an older one is queued or decoding supersedes it:
+// queued paths are never decoded and finished stale decodes are dropped.
+
+struct image_loader {
+	const char *label;              // "background" / "logo" for the log
+
+	image_loader(const char *label);
+
+	// Any thread. An empty path clears the image on the next swap().
+	void request(const char *path, const image_fit &fit);
+
+	// Graphics thread: if a newer image is ready, uploads it, releases the
+	// one in `current` and replaces it. True if `current` changed.
+	bool swap(shared_image *&current);
+
+	// Stops the worker (waiting for a decode in progress) and releases any
+	// undelivered image. Call outside the graphics context.
+	void destroy();
+
+private:
+	std::thread worker;
+	std::mutex mutex;
+	std::condition_variable wake;
+	bool stopping;
+
+	// Guarded by mutex
+	uint64_t generation;            // Bumped by every request()
+	std::string queued_path;
+	image_fit queued_fit;
+	bool queued;
+	uint64_t queued_at;             // os_gettime_ns() of the request
+	shared_image *ready;            // Decoded, not yet uploaded
+	bool ready_valid;               // ready (possibly null = clear) is current
+	std::string ready_path;
+	uint64_t ready_requested_at;
+	double ready_decode_ms;
+
+	void run();
+};
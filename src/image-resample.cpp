@@ -0,0 +1,177 @@
+/**
+ * Lower Thirds Plus - image downscaling
+ *
+ * See image-resample.hpp.
+ */
+
+#include "image-resample.hpp"
+#include "art-kernel.hpp"
+#include <util/sse-intrin.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+// Source span and per-pixel coverage of every destination pixel on one axis;
+// weights of a span sum to 1
+struct axis_weights {
+	std::vector<uint32_t> first;
+	std::vector<uint32_t> count;
+	std::vector<uint32_t> offset;
+	std::vector<float> weight;
+};
+
+static void build_axis(uint32_t src, uint32_t dst, axis_weights &w)
+{
+	const double scale = (double)src / dst;
+	w.first.resize(dst);
+	w.count.resize(dst);
+	w.offset.resize(dst);
+	w.weight.clear();
+	w.weight.reserve((size_t)dst * ((uint32_t)ceil(scale) + 1));
+
+	for (uint32_t d = 0; d < dst; d++) {
+		double x0 = d * scale;
+		double x1 = (d + 1) * scale;
+		uint32_t i0 = (uint32_t)x0;
+		uint32_t i1 = (uint32_t)ceil(x1 - 1e-9);
+		if (i1 > src)
+			i1 = src;
+		if (i1 <= i0)
+			i1 = i0 + 1;
+
+		w.first[d] = i0;
+		w.count[d] = i1 - i0;
+		w.offset[d] = (uint32_t)w.weight.size();
+		for (uint32_t i = i0; i < i1; i++) {
+			double cover = fmin(x1, (double)i + 1.0) - fmax(x0, (double)i);
+			w.weight.push_back((float)(cover / scale));
+		}
+	}
+}
+
+// Weighted channel sums (0..255 units) back to 8-bit
+static inline void store_pixel(const float *acc, uint8_t *out)
+{
+	for (int c = 0; c < 4; c++)
+		out[c] = (uint8_t)(fminf(acc[c], 255.0f) + 0.5f);
+}
+
+static void downscale_scalar(const uint8_t *src, uint32_t sw, const axis_weights &wx, const axis_weights &wy,
+	uint8_t *dst, uint32_t dw, uint32_t dh)
+{
+	std::vector<float> acc((size_t)dw * 4);
+	for (uint32_t y = 0; y < dh; y++) {
+		std::fill(acc.begin(), acc.end(), 0.0f);
+		for (uint32_t j = 0; j < wy.count[y]; j++) {
+			const uint8_t *line = src + (size_t)(wy.first[y] + j) * sw * 4;
+			float row_weight = wy.weight[wy.offset[y] + j];
+			for (uint32_t x = 0; x < dw; x++) {
+				const uint8_t *p = line + (size_t)wx.first[x] * 4;
+				const float *w = &wx.weight[wx.offset[x]];
+				float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+				for (uint32_t k = 0; k < wx.count[x]; k++, p += 4) {
+					r += p[0] * w[k];
+					g += p[1] * w[k];
+					b += p[2] * w[k];
+					a += p[3] * w[k];
+				}
+				float *out = &acc[(size_t)x * 4];
+				out[0] += r * row_weight;
+				out[1] += g * row_weight;
+				out[2] += b * row_weight;
+				out[3] += a * row_weight;
+			}
+		}
+
+		uint8_t *line = dst + (size_t)y * dw * 4;
+		for (uint32_t x = 0; x < dw; x++)
+			store_pixel(&acc[(size_t)x * 4], line + (size_t)x * 4);
+	}
+}
+
+// Same arithmetic with the four channels of a pixel in one register
+static void downscale_sse2(const uint8_t *src, uint32_t sw, const axis_weights &wx, const axis_weights &wy,
+	uint8_t *dst, uint32_t dw, uint32_t dh)
+{
+	const __m128i zero = _mm_setzero_si128();
+
+	std::vector<float> acc((size_t)dw * 4);
+	for (uint32_t y = 0; y < dh; y++) {
+		std::fill(acc.begin(), acc.end(), 0.0f);
+		for (uint32_t j = 0; j < wy.count[y]; j++) {
+			const uint8_t *line = src + (size_t)(wy.first[y] + j) * sw * 4;
+			const __m128 row_weight = _mm_set1_ps(wy.weight[wy.offset[y] + j]);
+			for (uint32_t x = 0; x < dw; x++) {
+				const uint8_t *p = line + (size_t)wx.first[x] * 4;
+				const float *w = &wx.weight[wx.offset[x]];
+				__m128 sum = _mm_setzero_ps();
+				for (uint32_t k = 0; k < wx.count[x]; k++, p += 4) {
+					int32_t bits;
+					memcpy(&bits, p, 4);
+					__m128i px = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bits), zero), zero);
+					__m128 v = _mm_cvtepi32_ps(px);
+					sum = _mm_add_ps(sum, _mm_mul_ps(v, _mm_set1_ps(w[k])));
+				}
+				float *out = &acc[(size_t)x * 4];
+				_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(sum, row_weight)));
+			}
+		}
+
+		uint8_t *line = dst + (size_t)y * dw * 4;
+		for (uint32_t x = 0; x < dw; x++)
+			store_pixel(&acc[(size_t)x * 4], line + (size_t)x * 4);
+	}
+}
+
+void image_downscale(const uint8_t *src, uint32_t sw, uint32_t sh, uint8_t *dst, uint32_t dw, uint32_t dh)
+{
+	if (!dw || !dh)
+		return;
+	axis_weights wx, wy;
+	build_axis(sw, dw, wx);
+	build_axis(sh, dh, wy);
+
+	if (art_kernel_get_isa() >= ART_KERNEL_SSE2)
+		downscale_sse2(src, sw, wx, wy, dst, dw, dh);
+	else
+		downscale_scalar(src, sw, wx, wy, dst, dw, dh);
+}
+
+uint32_t image_mip_levels(uint32_t cx, uint32_t cy)
+{
+	uint32_t levels = 1;
+	while (cx > 1 || cy > 1) {
+		cx = cx > 1 ? cx / 2 : 1;
+		cy = cy > 1 ? cy / 2 : 1;
+		levels++;
+	}
+	return levels;
+}
+
+size_t image_mip_size(uint32_t cx, uint32_t cy, uint32_t levels)
+{
+	size_t size = 0;
+	for (uint32_t l = 1; l < levels; l++) {
+		cx = cx > 1 ? cx / 2 : 1;
+		cy = cy > 1 ? cy / 2 : 1;
+		size += (size_t)cx * cy * 4;
+	}
+	return size;
+}
+
+void image_build_mips(const uint8_t *base, uint32_t cx, uint32_t cy, uint32_t levels, uint8_t *mips)
+{
+	// Each level from the one above: a 2:1 box per axis (odd sizes blend
+	// three texels), so the chain costs about a third of the base
+	const uint8_t *prev = base;
+	for (uint32_t l = 1; l < levels; l++) {
+		uint32_t next_cx = cx > 1 ? cx / 2 : 1;
+		uint32_t next_cy = cy > 1 ? cy / 2 : 1;
+		image_downscale(prev, cx, cy, mips, next_cx, next_cy);
+		prev = mips;
+		mips += (size_t)next_cx * next_cy * 4;
+		cx = next_cx;
+		cy = next_cy;
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Load-time downscaling for decoded images (8-bit, 4 channels, alpha in the
+// fourth: GS_RGBA, GS_BGRA; callers set GS_BGRX padding to 255 first). Area
+// filter: every destination pixel is the coverage-weighted mean of the
+// source pixels under its footprint, for any (non-integer) ratio. Input is
+// premultiplied, as gs_image_file_init() decodes it, so all four channels
+// are averaged alike and transparent edges neither darken nor brighten.
+// Runs on the image loader's worker thread.
+//
+// The vector path keeps one pixel per register (SSE2, NEON through
+// util/sse-intrin.h) and follows the art kernels' dispatch level
+// (art_kernel_get_isa()); the scalar path is the reference.
+
+// src is sw x sh, dst dw x dh, both tightly packed; dw <= sw, dh <= sh
+void image_downscale(const uint8_t *src, uint32_t sw, uint32_t sh, uint8_t *dst, uint32_t dw, uint32_t dh);
+
+// Levels of a full mip chain (halving down to 1 x 1), including the base
+uint32_t image_mip_levels(uint32_t cx, uint32_t cy);
+
+// Bytes of levels 1..levels-1 for a cx x cy base, and fills them from the
+// base into `mips` (laid out level after level)
+size_t image_mip_size(uint32_t cx, uint32_t cy, uint32_t levels);
+void image_build_mips(const uint8_t *base, uint32_t cx, uint32_t cy, uint32_t levels, uint8_t *mips);
@@ -11,6 +11,7 @@
 
 #include "lowerthirds-source-simple.hpp"
 #include "json-loader.hpp"
+#include "unit-circle.hpp"
 #include <obs-module.h>
 #include <graphics/graphics.h>
 #include <graphics/vec4.h>
@@ -20,6 +21,7 @@
 #include <util/dstr.h>
 #include <util/platform.h>
 #include <math.h>
+#include <string.h>
 
 // Source callbacks
 static const char *lowerthirds_get_name(void *unused)
@@ -150,6 +152,7 @@ static void lowerthirds_get_defaults(obs_data_t *settings)
 	obs_data_set_default_bool(settings, "show_background", true); // Background ON by default
 	obs_data_set_default_int(settings, "title_size", 72);  // Larger, more prominent title
 	obs_data_set_default_int(settings, "subtitle_size", 48);  // Larger, more readable subtitle
+	obs_data_set_default_bool(settings, "glyph_text", false); // Opt-in shared glyph atlas (no complex script shaping)
 	obs_data_set_default_int(settings, "padding_horizontal", 60);  // More breathing room
 	obs_data_set_default_int(settings, "padding_vertical", 25);
 	obs_data_set_default_int(settings, "bar_height", 200);  // Taller box for larger content
@@ -180,6 +183,14 @@ static void lowerthirds_get_defaults(obs_data_t *settings)
 	// Gradient defaults
 	obs_data_set_default_int(settings, "gradient_type", GRADIENT_NONE);
 	obs_data_set_default_int(settings, "gradient_color2", 0xFFD27619); // Darker blue for gradient (ABGR format)
+	obs_data_set_default_int(settings, "gradient_stop_count", 2);
+	obs_data_set_default_int(settings, "gradient_color3", 0xFF8C3D1A); // Navy
+	obs_data_set_default_int(settings, "gradient_color4", 0xFF5A1F0F); // Deep navy
+	obs_data_set_default_int(settings, "gradient_color5", 0xFF7A2E6B); // Purple
+	obs_data_set_default_int(settings, "gradient_color6", 0xFF4A3BC9); // Red
+	obs_data_set_default_int(settings, "gradient_color7", 0xFF2E9CF5); // Orange
+	obs_data_set_default_int(settings, "gradient_color8", 0xFF3ED6F7); // Yellow
+	obs_data_set_default_int(settings, "gradient_angle", 45);
 	
 	// Text shadow defaults
 	obs_data_set_default_bool(settings, "text_shadow_enabled", false);
@@ -187,6 +198,7 @@ static void lowerthirds_get_defaults(obs_data_t *settings)
 	obs_data_set_default_int(settings, "text_shadow_opacity", 75);
 	obs_data_set_default_int(settings, "text_shadow_offset_x", 3);
 	obs_data_set_default_int(settings, "text_shadow_offset_y", 3);
+	obs_data_set_default_int(settings, "text_shadow_blur", 0); // Hard shadow
 	
 	// Logo shadow defaults
 	obs_data_set_default_bool(settings, "logo_shadow_enabled", false);
@@ -202,6 +214,12 @@ static void lowerthirds_get_defaults(obs_data_t *settings)
 	obs_data_set_default_int(settings, "text_highlight_corner_radius", 8);
 	obs_data_set_default_int(settings, "text_highlight_padding_horizontal", 20);
 	obs_data_set_default_int(settings, "text_highlight_padding_vertical", 10);
+	obs_data_set_default_bool(settings, "text_highlight_sdf", false); // Cached geometry (hard edges)
+	obs_data_set_default_int(settings, "text_highlight_border_width", 0);
+	obs_data_set_default_int(settings, "text_highlight_border_color", 0xFFFFFFFF); // White (ABGR format)
+	obs_data_set_default_int(settings, "text_highlight_inner_shadow", 0);
+	obs_data_set_default_int(settings, "text_highlight_inner_shadow_color", 0xFF000000); // Black (ABGR format)
+	obs_data_set_default_int(settings, "text_highlight_inner_shadow_opacity", 50);
 	
 	// Background art effect defaults
 	obs_data_set_default_int(settings, "art_effect", ART_PARTICLES); // Particles by default
@@ -210,6 +228,17 @@ static void lowerthirds_get_defaults(obs_data_t *settings)
 	obs_data_set_default_double(settings, "art_intensity", 1.0); // Normal intensity
 	obs_data_set_default_double(settings, "art_speed", 30.0); // Moderate movement
 	obs_data_set_default_bool(settings, "art_animate", true); // Animated by default
+	obs_data_set_default_int(settings, "art_sim_rate", 0); // Update art every frame
+	obs_data_set_default_bool(settings, "art_adaptive_quality", false); // Always full quality
+	obs_data_set_default_double(settings, "art_render_budget", 2.0); // ms per frame
+	obs_data_set_default_bool(settings, "art_loop_bake", false); // Draw loops live
+	obs_data_set_default_int(settings, "art_loop_frames", 60);
+	obs_data_set_default_int(settings, "art_loop_resolution", 50); // Half size: soft glows hide it
+	obs_data_set_default_bool(settings, "art_particle_sim", false); // Classic stateless motion
+	obs_data_set_default_double(settings, "art_emit_rate", 15.0); // 60 alive, like classic particles
+	obs_data_set_default_double(settings, "art_particle_life", 4.0);
+	obs_data_set_default_double(settings, "art_particle_velocity", 20.0);
+	obs_data_set_default_bool(settings, "art_use_shader", false); // CPU geometry (reference look)
 }
 
 // Button callback for Play Profile 1
@@ -223,9 +252,8 @@ static bool lowerthirds_play_profile1_clicked(obs_properties_t *props, obs_prope
 	context->is_visible = false;
 	context->animation_progress = 0.0f;
 	
-	// NOW switch profile and update text while hidden
-	context->current_profile = 0;
-	context->update_text_sources(); // Update text while invisible
+	// NOW switch profile while hidden (its text is already rasterized)
+	context->select_profile(0);
 	
 	// NOW start fresh animation with correct content
 	context->force_replay = true;
@@ -246,9 +274,8 @@ static bool lowerthirds_play_profile2_clicked(obs_properties_t *props, obs_prope
 	context->is_visible = false;
 	context->animation_progress = 0.0f;
 	
-	// NOW switch profile and update text while hidden
-	context->current_profile = 1;
-	context->update_text_sources(); // Update text while invisible
+	// NOW switch profile while hidden (its text is already rasterized)
+	context->select_profile(1);
 	
 	// NOW start fresh animation with correct content
 	context->force_replay = true;
@@ -269,9 +296,8 @@ static bool lowerthirds_play_profile3_clicked(obs_properties_t *props, obs_prope
 	context->is_visible = false;
 	context->animation_progress = 0.0f;
 	
-	// NOW switch profile and update text while hidden
-	context->current_profile = 2;
-	context->update_text_sources(); // Update text while invisible
+	// NOW switch profile while hidden (its text is already rasterized)
+	context->select_profile(2);
 	
 	// NOW start fresh animation with correct content
 	context->force_replay = true;
@@ -292,9 +318,8 @@ static bool lowerthirds_play_profile4_clicked(obs_properties_t *props, obs_prope
 	context->is_visible = false;
 	context->animation_progress = 0.0f;
 	
-	// NOW switch profile and update text while hidden
-	context->current_profile = 3;
-	context->update_text_sources(); // Update text while invisible
+	// NOW switch profile while hidden (its text is already rasterized)
+	context->select_profile(3);
 	
 	// NOW start fresh animation with correct content
 	context->force_replay = true;
@@ -315,9 +340,8 @@ static bool lowerthirds_play_profile5_clicked(obs_properties_t *props, obs_prope
 	context->is_visible = false;
 	context->animation_progress = 0.0f;
 	
-	// NOW switch profile and update text while hidden
-	context->current_profile = 4;
-	context->update_text_sources(); // Update text while invisible
+	// NOW switch profile while hidden (its text is already rasterized)
+	context->select_profile(4);
 	
 	// NOW start fresh animation with correct content
 	context->force_replay = true;
@@ -574,6 +598,7 @@ static obs_properties_t *lowerthirds_get_properties(void *data)
 	obs_properties_add_int_slider(text_style_group, "title_size", "Title Size (px)", 20, 120, 2);
 	obs_properties_add_int_slider(text_style_group, "subtitle_size", "Subtitle Size (px)", 16, 100, 2);
 	obs_properties_add_color(text_style_group, "text_color", "Text Color");
+	obs_properties_add_bool(text_style_group, "glyph_text", "Built-in Text Rendering (OFF = OBS Text Sources)");
 	
 	obs_properties_add_group(advanced_group, "text_styling", "✏️ Text Styling", 
 		OBS_GROUP_NORMAL, text_style_group);
@@ -589,6 +614,7 @@ static obs_properties_t *lowerthirds_get_properties(void *data)
 	obs_properties_add_int_slider(text_effects_group, "text_shadow_opacity", "   Shadow Opacity (%)", 0, 100, 1);
 	obs_properties_add_int_slider(text_effects_group, "text_shadow_offset_x", "   Shadow Offset X (px)", -20, 20, 1);
 	obs_properties_add_int_slider(text_effects_group, "text_shadow_offset_y", "   Shadow Offset Y (px)", -20, 20, 1);
+	obs_properties_add_int_slider(text_effects_group, "text_shadow_blur", "   Shadow Blur (px)", 0, 20, 1);
 	
 	// Highlight/Background
 	obs_properties_add_bool(text_effects_group, "text_highlight_enabled", "🎨 Enable Text Highlight (Background Box)");
@@ -597,6 +623,12 @@ static obs_properties_t *lowerthirds_get_properties(void *data)
 	obs_properties_add_int_slider(text_effects_group, "text_highlight_corner_radius", "   Corner Radius (px)", 0, 50, 1);
 	obs_properties_add_int_slider(text_effects_group, "text_highlight_padding_horizontal", "   Padding Horizontal (px)", 0, 100, 2);
 	obs_properties_add_int_slider(text_effects_group, "text_highlight_padding_vertical", "   Padding Vertical (px)", 0, 50, 2);
+	obs_properties_add_bool(text_effects_group, "text_highlight_sdf", "   🖥 Smooth Edges (GPU Shader)");
+	obs_properties_add_int_slider(text_effects_group, "text_highlight_border_width", "      Border Width (px)", 0, 10, 1);
+	obs_properties_add_color(text_effects_group, "text_highlight_border_color", "      Border Color");
+	obs_properties_add_int_slider(text_effects_group, "text_highlight_inner_shadow", "      Inner Shadow Size (px)", 0, 30, 1);
+	obs_properties_add_color(text_effects_group, "text_highlight_inner_shadow_color", "      Inner Shadow Color");
+	obs_properties_add_int_slider(text_effects_group, "text_highlight_inner_shadow_opacity", "      Inner Shadow Opacity (%)", 0, 100, 1);
 	
 	obs_properties_add_group(advanced_group, "text_effects", "✨ Text Effects", 
 		OBS_GROUP_NORMAL, text_effects_group);
@@ -639,8 +671,18 @@ static obs_properties_t *lowerthirds_get_properties(void *data)
 	obs_property_list_add_int(gradient_list, "Vertical ↓", GRADIENT_VERTICAL);
 	obs_property_list_add_int(gradient_list, "Diagonal ↘", GRADIENT_DIAGONAL_TL_BR);
 	obs_property_list_add_int(gradient_list, "Diagonal ↗", GRADIENT_DIAGONAL_BL_TR);
-	
-	obs_properties_add_color(background_group, "gradient_color2", "Gradient End Color");
+	obs_property_list_add_int(gradient_list, "Angle ∠", GRADIENT_ANGLE);
+	obs_property_list_add_int(gradient_list, "Radial ◎", GRADIENT_RADIAL);
+	
+	obs_properties_add_color(background_group, "gradient_color2", "Gradient Color 2 (End)");
+	obs_properties_add_int_slider(background_group, "gradient_stop_count", "   Color Stops", 2, GRADIENT_MAX_STOPS, 1);
+	for (int i = 3; i <= GRADIENT_MAX_STOPS; i++) {
+		char key[32], label[48];
+		snprintf(key, sizeof(key), "gradient_color%d", i);
+		snprintf(label, sizeof(label), "   Gradient Color %d", i);
+		obs_properties_add_color(background_group, key, label);
+	}
+	obs_properties_add_int_slider(background_group, "gradient_angle", "   Gradient Angle (°)", 0, 359, 1);
 	obs_properties_add_path(background_group, "bg_image", "Background Image (Optional)", 
 		OBS_PATH_FILE, "Image Files (*.png *.jpg *.jpeg *.bmp);;All Files (*.*)", NULL);
 	
@@ -662,6 +704,44 @@ static obs_properties_t *lowerthirds_get_properties(void *data)
 	obs_properties_add_float_slider(background_group, "art_intensity", "   Effect Intensity", 0.5, 2.0, 0.1);
 	obs_properties_add_bool(background_group, "art_animate", "   🎬 Animate Effect (Live)");
 	obs_properties_add_float_slider(background_group, "art_speed", "   Animation Speed", 5.0, 100.0, 5.0);
+	obs_properties_add_bool(background_group, "art_use_shader", "   🖥 GPU Shader Effects (Per-Pixel)");
+	
+	obs_properties_add_bool(background_group, "art_particle_sim", "   🌠 Simulated Particles (Particles, Sparkles)");
+	obs_properties_add_float_slider(background_group, "art_emit_rate", "   Emission Rate (per second)", 1.0, 3000.0, 1.0);
+	obs_properties_add_float_slider(background_group, "art_particle_life", "   Particle Lifetime (s)", 0.5, 10.0, 0.5);
+	obs_properties_add_float_slider(background_group, "art_particle_velocity", "   Particle Velocity (px/s)", 0.0, 200.0, 5.0);
+	
+	obs_property_t *sim_rate_list = obs_properties_add_list(background_group, "art_sim_rate", 
+		"   Effect Update Rate", OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(sim_rate_list, "Every Frame", 0);
+	obs_property_list_add_int(sim_rate_list, "60 Hz", 60);
+	obs_property_list_add_int(sim_rate_list, "30 Hz (lighter)", 30);
+	obs_property_list_add_int(sim_rate_list, "15 Hz (lightest)", 15);
+	
+	obs_properties_add_bool(background_group, "art_adaptive_quality", "   ⚡ Adaptive Quality (Busy Machines)");
+	obs_properties_add_float_slider(background_group, "art_render_budget", "   Render Budget (ms)", 0.5, 8.0, 0.5);
+	
+	// Governor tier as of opening the properties
+	char quality_label[128];
+	if (context && context->art_gov.enabled)
+		snprintf(quality_label, sizeof(quality_label), "   Current Quality: %s (%.2f ms)",
+			context->art_gov.quality().name, context->art_gov.avg_ms);
+	else
+		snprintf(quality_label, sizeof(quality_label), "   Current Quality: %s",
+			art_quality_for_tier(ART_QUALITY_FULL).name);
+	obs_properties_add_text(background_group, "art_quality_info", quality_label, OBS_TEXT_INFO);
+	
+	obs_properties_add_bool(background_group, "art_loop_bake", "   🎞 Baked Loop (Light Rays)");
+	obs_property_t *loop_frames_list = obs_properties_add_list(background_group, "art_loop_frames", 
+		"   Loop Frames", OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(loop_frames_list, "30", 30);
+	obs_property_list_add_int(loop_frames_list, "60", 60);
+	obs_property_list_add_int(loop_frames_list, "120 (smoothest)", 120);
+	obs_property_t *loop_res_list = obs_properties_add_list(background_group, "art_loop_resolution", 
+		"   Loop Resolution", OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(loop_res_list, "25%", 25);
+	obs_property_list_add_int(loop_res_list, "50%", 50);
+	obs_property_list_add_int(loop_res_list, "100% (sharpest)", 100);
 	
 	obs_properties_add_group(advanced_group, "background_styling", "🎨 Background Styling", 
 		OBS_GROUP_NORMAL, background_group);
@@ -695,11 +775,27 @@ lowerthirds_source::lowerthirds_source(obs_source_t *src, obs_data_t *settings)
 	, subtitle_text_source(nullptr)
 	, title_right_text_source(nullptr)
 	, subtitle_right_text_source(nullptr)
+	, profile_text_sources()
+	, text_fingerprints()
+	, text_updates_performed(0)
+	, text_updates_skipped(0)
+	, glyph_text_enabled(false)
+	, use_glyph_text(false)
+	, glyph_fonts()
+	, glyph_sizes()
+	, glyph_layouts()
+	, glyph_generation(0)
+	, text_metrics_cache()
+	, glyph_text()
 	, font_face(nullptr)
 	, bg_image_path(nullptr)
 	, bg_image(nullptr)
+	, bg_loader("background")
+	, bg_fit()
 	, logo_image_path(nullptr)
 	, logo_image(nullptr)
+	, logo_loader("logo")
+	, logo_fit()
 	, logo_size(140)  // Larger default logo
 	, logo_opacity(100)
 	, logo_padding_horizontal(20)  // More padding
@@ -718,6 +814,8 @@ lowerthirds_source::lowerthirds_source(obs_source_t *src, obs_data_t *settings)
 	, text_shadow_opacity(75)
 	, text_shadow_offset_x(3)
 	, text_shadow_offset_y(3)
+	, text_shadow_blur(0)
+	, text_shadows()
 	, logo_shadow_enabled(false)
 	, logo_shadow_color(0xFF000000)  // Black
 	, logo_shadow_opacity(75)
@@ -729,8 +827,20 @@ lowerthirds_source::lowerthirds_source(obs_source_t *src, obs_data_t *settings)
 	, text_highlight_corner_radius(8)
 	, text_highlight_padding_horizontal(20)
 	, text_highlight_padding_vertical(10)
+	, text_highlight_sdf(false)
+	, text_highlight_border_width(0)
+	, text_highlight_border_color(0xFFFFFFFF)
+	, text_highlight_inner_shadow(0)
+	, text_highlight_inner_shadow_color(0xFF000000)
+	, text_highlight_inner_shadow_opacity(50)
+	, highlight_rects()
+	, highlight_sdf()
 	, gradient_type(GRADIENT_NONE)
 	, gradient_color2(0xFFD27619)
+	, gradient_stop_count(2)
+	, gradient_stops()
+	, gradient_angle(45)
+	, gradient_tex()
 	, art_effect(ART_PARTICLES)
 	, art_color(0xFFFFFFFF)  // White - glowing effect
 	, art_opacity(60)
@@ -738,6 +848,28 @@ lowerthirds_source::lowerthirds_source(obs_source_t *src, obs_data_t *settings)
 	, art_speed(30.0f)
 	, art_animate(true)
 	, art_animation_offset(0.0f)
+	, art_sim_rate(0)
+	, art_sim_elapsed(0.0f)
+	, art_sim_offset(0.0f)
+	, art_sim_live(true)
+	, art_table()
+	, art_cache(nullptr)
+	, art_cache_valid(false)
+	, art_cache_state()
+	, art_gov()
+	, art_loop_bake(false)
+	, art_loop_frames(60)
+	, art_loop_resolution(50)
+	, art_loop()
+	, art_particle_sim(false)
+	, art_emit_rate(15.0f)
+	, art_particle_life(4.0f)
+	, art_particle_velocity(20.0f)
+	, art_pool()
+	, art_pool_emitter()
+	, art_use_shader(false)
+	, art_gpu()
+	, art_sprites()
 	, auto_scale(false)  // OFF by default - keeps consistent pixel sizes
 	, scale_factor(1.0f)
 	, is_visible(false)
@@ -751,54 +883,8 @@ lowerthirds_source::lowerthirds_source(obs_source_t *src, obs_data_t *settings)
 	, force_replay(false)
 	, preview_mode(false)
 {
-	// Create UNIQUE text sources for this instance (prevents conflicts when duplicating)
-	// Use source pointer to ensure unique names for each duplicated instance
-	char name_buffer[256];
-	
-	// Create text sources for rendering (left side) - UNIQUE per instance
-	obs_data_t *title_settings = obs_data_create();
-	obs_data_t *subtitle_settings = obs_data_create();
-	
-	snprintf(name_buffer, sizeof(name_buffer), "lt_title_%p", (void*)src);
-	title_text_source = obs_source_create_private("text_ft2_source_v2", name_buffer, title_settings);
-	
-	snprintf(name_buffer, sizeof(name_buffer), "lt_subtitle_%p", (void*)src);
-	subtitle_text_source = obs_source_create_private("text_ft2_source_v2", name_buffer, subtitle_settings);
-	
-	// If FreeType text not available, try GDI (macOS uses FreeType usually)
-	if (!title_text_source) {
-		snprintf(name_buffer, sizeof(name_buffer), "lt_title_%p", (void*)src);
-		title_text_source = obs_source_create_private("text_gdiplus_v2", name_buffer, title_settings);
-	}
-	if (!subtitle_text_source) {
-		snprintf(name_buffer, sizeof(name_buffer), "lt_subtitle_%p", (void*)src);
-		subtitle_text_source = obs_source_create_private("text_gdiplus_v2", name_buffer, subtitle_settings);
-	}
-	
-	obs_data_release(title_settings);
-	obs_data_release(subtitle_settings);
-	
-	// Create text sources for right side (optional) - UNIQUE per instance
-	obs_data_t *title_right_settings = obs_data_create();
-	obs_data_t *subtitle_right_settings = obs_data_create();
-	
-	snprintf(name_buffer, sizeof(name_buffer), "lt_title_right_%p", (void*)src);
-	title_right_text_source = obs_source_create_private("text_ft2_source_v2", name_buffer, title_right_settings);
-	
-	snprintf(name_buffer, sizeof(name_buffer), "lt_subtitle_right_%p", (void*)src);
-	subtitle_right_text_source = obs_source_create_private("text_ft2_source_v2", name_buffer, subtitle_right_settings);
-	
-	if (!title_right_text_source) {
-		snprintf(name_buffer, sizeof(name_buffer), "lt_title_right_%p", (void*)src);
-		title_right_text_source = obs_source_create_private("text_gdiplus_v2", name_buffer, title_right_settings);
-	}
-	if (!subtitle_right_text_source) {
-		snprintf(name_buffer, sizeof(name_buffer), "lt_subtitle_right_%p", (void*)src);
-		subtitle_right_text_source = obs_source_create_private("text_gdiplus_v2", name_buffer, subtitle_right_settings);
-	}
-	
-	obs_data_release(title_right_settings);
-	obs_data_release(subtitle_right_settings);
+	// Text sources are created by update_text_sources(), and only if the
+	// built-in text cannot be used
 	
 	// Initialize all 5 profiles with nullptr
 	for (int i = 0; i < 5; i++) {
@@ -813,24 +899,36 @@ lowerthirds_source::lowerthirds_source(obs_source_t *src, obs_data_t *settings)
 
 lowerthirds_source::~lowerthirds_source()
 {
-	obs_source_release(title_text_source);
-	obs_source_release(subtitle_text_source);
-	obs_source_release(title_right_text_source);
-	obs_source_release(subtitle_right_text_source);
-	
-	if (bg_image) {
-		obs_enter_graphics();
-		gs_image_file_free(bg_image);
-		obs_leave_graphics();
-		bfree(bg_image);
-	}
-	
-	if (logo_image) {
-		obs_enter_graphics();
-		gs_image_file_free(logo_image);
-		obs_leave_graphics();
-		bfree(logo_image);
-	}
+	// Once per source, so the saving of the dirty tracking shows in any log
+	blog(LOG_INFO, "Text source updates: %llu re-rasterized, %llu unchanged and skipped",
+		(unsigned long long)text_updates_performed, (unsigned long long)text_updates_skipped);
+	
+	release_text_sources();
+	glyph_font_release(glyph_fonts[0]);
+	glyph_font_release(glyph_fonts[1]);
+	
+	// Before entering graphics: a decode in flight frees through it
+	bg_loader.destroy();
+	logo_loader.destroy();
+	
+	image_cache_release(bg_image);
+	image_cache_release(logo_image);
+	
+	obs_enter_graphics();
+	art_batch.destroy();
+	gs_texrender_destroy(art_cache);
+	art_loop.destroy();
+	art_pool.destroy();
+	art_gpu.destroy();
+	art_sprites.destroy();
+	glyph_text.destroy();
+	glyph_atlas_trim();
+	text_shadows.destroy();
+	gradient_tex.destroy();
+	highlight_rects.destroy();
+	highlight_sdf.destroy();
+	obs_leave_graphics();
+	bfree(art_table.data);
 	
 	// Free all profiles
 	for (int i = 0; i < 5; i++) {
@@ -845,6 +943,12 @@ lowerthirds_source::~lowerthirds_source()
 	bfree(logo_image_path);
 }
 
+static bool same_emitter(const particle_emitter &a, const particle_emitter &b)
+{
+	return a.rate == b.rate && a.lifetime == b.lifetime && a.velocity == b.velocity && a.size == b.size &&
+		a.width == b.width && a.height == b.height;
+}
+
 void lowerthirds_source::update(obs_data_t *settings)
 {
 	// Load all 5 profiles' text content
@@ -901,63 +1005,13 @@ void lowerthirds_source::update(obs_data_t *settings)
 	bfree(font_face);
 	font_face = bstrdup(new_font);
 	
-	// Load background image if path changed
-	if (!bg_image_path || strcmp(bg_image_path, new_bg_image) != 0) {
-		bfree(bg_image_path);
-		bg_image_path = bstrdup(new_bg_image);
-		
-		// Clean up old image
-		if (bg_image) {
-			obs_enter_graphics();
-			gs_image_file_free(bg_image);
-			obs_leave_graphics();
-			bfree(bg_image);
-			bg_image = nullptr;
-		}
-		
-		// Load new image if path is not empty
-		if (bg_image_path && strlen(bg_image_path) > 0) {
-			bg_image = (gs_image_file_t *)bzalloc(sizeof(gs_image_file_t));
-			gs_image_file_init(bg_image, bg_image_path);
-			
-			obs_enter_graphics();
-			gs_image_file_init_texture(bg_image);
-			obs_leave_graphics();
-		}
-	}
-	
-	// Load logo image if path changed
-	const char *new_logo_image = obs_data_get_string(settings, "logo_image");
-	if (!logo_image_path || strcmp(logo_image_path, new_logo_image) != 0) {
-		bfree(logo_image_path);
-		logo_image_path = bstrdup(new_logo_image);
-		
-		// Clean up old logo
-		if (logo_image) {
-			obs_enter_graphics();
-			gs_image_file_free(logo_image);
-			obs_leave_graphics();
-			bfree(logo_image);
-			logo_image = nullptr;
-		}
-		
-		// Load new logo if path is not empty
-		if (logo_image_path && strlen(logo_image_path) > 0) {
-			logo_image = (gs_image_file_t *)bzalloc(sizeof(gs_image_file_t));
-			gs_image_file_init(logo_image, logo_image_path);
-			
-			obs_enter_graphics();
-			gs_image_file_init_texture(logo_image);
-			obs_leave_graphics();
-		}
-	}
-	
 	bg_color = (uint32_t)obs_data_get_int(settings, "bg_color");
 	text_color = (uint32_t)obs_data_get_int(settings, "text_color");
 	opacity = (int)obs_data_get_int(settings, "opacity");
 	show_background = obs_data_get_bool(settings, "show_background");
 	title_size = (int)obs_data_get_int(settings, "title_size");
 	subtitle_size = (int)obs_data_get_int(settings, "subtitle_size");
+	glyph_text_enabled = obs_data_get_bool(settings, "glyph_text");
 	padding_horizontal = (int)obs_data_get_int(settings, "padding_horizontal");
 	padding_vertical = (int)obs_data_get_int(settings, "padding_vertical");
 	bar_height_pixels = (int)obs_data_get_int(settings, "bar_height");
@@ -972,17 +1026,102 @@ void lowerthirds_source::update(obs_data_t *settings)
 	logo_padding_horizontal = (int)obs_data_get_int(settings, "logo_padding_horizontal");
 	logo_padding_vertical = (int)obs_data_get_int(settings, "logo_padding_vertical");
 	
+	// Images decode on the loaders' worker threads; render() swaps them in
+	// when ready, so the old image stays up and update() never waits.
+	// Larger files are downscaled there to the most they are drawn at: the
+	// 1920 x bar layout and the logo square, with headroom for a canvas
+	// above 1080p (auto-scale, or the source stretched to fill it). The
+	// logo keeps mipmaps for the zoom and spin animations.
+	float headroom = 1.0f;
+	obs_video_info ovi;
+	if (obs_get_video_info(&ovi))
+		headroom = fminf(fmaxf(ovi.base_height / 1080.0f, 1.0f), 2.5f);
+	image_fit new_bg_fit = {(uint32_t)ceilf(1920.0f * headroom),
+		(uint32_t)ceilf((float)bar_height_pixels * headroom), false};
+	image_fit new_logo_fit = {(uint32_t)ceilf((float)logo_size * headroom),
+		(uint32_t)ceilf((float)logo_size * headroom), true};
+	
+	if (!bg_image_path || strcmp(bg_image_path, new_bg_image) != 0 || bg_fit != new_bg_fit) {
+		bfree(bg_image_path);
+		bg_image_path = bstrdup(new_bg_image);
+		bg_fit = new_bg_fit;
+		bg_loader.request(bg_image_path, bg_fit);
+	}
+	
+	const char *new_logo_image = obs_data_get_string(settings, "logo_image");
+	if (!logo_image_path || strcmp(logo_image_path, new_logo_image) != 0 || logo_fit != new_logo_fit) {
+		bfree(logo_image_path);
+		logo_image_path = bstrdup(new_logo_image);
+		logo_fit = new_logo_fit;
+		logo_loader.request(logo_image_path, logo_fit);
+	}
+	
 	// Gradient settings
 	gradient_type = (GradientType)obs_data_get_int(settings, "gradient_type");
 	gradient_color2 = (uint32_t)obs_data_get_int(settings, "gradient_color2");
+	gradient_stop_count = (int)obs_data_get_int(settings, "gradient_stop_count");
+	if (gradient_stop_count < 2)
+		gradient_stop_count = 2;
+	if (gradient_stop_count > GRADIENT_MAX_STOPS)
+		gradient_stop_count = GRADIENT_MAX_STOPS;
+	gradient_stops[0] = bg_color;
+	gradient_stops[1] = gradient_color2;
+	for (int i = 2; i < GRADIENT_MAX_STOPS; i++) {
+		char key[32];
+		snprintf(key, sizeof(key), "gradient_color%d", i + 1);
+		gradient_stops[i] = (uint32_t)obs_data_get_int(settings, key);
+	}
+	gradient_angle = (int)obs_data_get_int(settings, "gradient_angle");
 	
 	// Background art effect settings
+	BackgroundArtEffect last_art_effect = art_effect;
+	float last_art_intensity = art_intensity;
 	art_effect = (BackgroundArtEffect)obs_data_get_int(settings, "art_effect");
 	art_color = (uint32_t)obs_data_get_int(settings, "art_color");
 	art_opacity = (int)obs_data_get_int(settings, "art_opacity");
 	art_intensity = (float)obs_data_get_double(settings, "art_intensity");
 	art_speed = (float)obs_data_get_double(settings, "art_speed");
 	art_animate = obs_data_get_bool(settings, "art_animate");
+	art_sim_rate = (int)obs_data_get_int(settings, "art_sim_rate");
+	
+	// Only changes that move the art's cost start the governor over; cues and
+	// unrelated settings keep its tier and relapse back-off
+	bool art_adaptive = obs_data_get_bool(settings, "art_adaptive_quality");
+	float art_budget = (float)obs_data_get_double(settings, "art_render_budget");
+	if (art_effect != last_art_effect || art_intensity != last_art_intensity ||
+		art_adaptive != art_gov.enabled || art_budget != art_gov.budget_ms)
+		art_gov.reset();
+	art_gov.enabled = art_adaptive;
+	art_gov.budget_ms = art_budget;
+	
+	art_loop_bake = obs_data_get_bool(settings, "art_loop_bake");
+	art_loop_frames = (int)obs_data_get_int(settings, "art_loop_frames");
+	art_loop_resolution = (int)obs_data_get_int(settings, "art_loop_resolution");
+	art_particle_sim = obs_data_get_bool(settings, "art_particle_sim");
+	art_emit_rate = (float)obs_data_get_double(settings, "art_emit_rate");
+	art_particle_life = (float)obs_data_get_double(settings, "art_particle_life");
+	art_particle_velocity = (float)obs_data_get_double(settings, "art_particle_velocity");
+	art_use_shader = obs_data_get_bool(settings, "art_use_shader");
+	
+	// Rebuild per-element art constants under the graphics lock so render
+	// never sees a half-built table (1920 = render()'s fixed layout width)
+	obs_enter_graphics();
+	update_art_table(art_effect, art_intensity, 1920.0f, (float)bar_height_pixels * scale_factor);
+	
+	// Pool sized for the steady population plus one lifetime's spread,
+	// then pre-run so the effect does not fill up on screen. Other updates
+	// (cues, unrelated settings) leave the running field alone.
+	if (art_uses_pool()) {
+		particle_emitter emitter = art_emitter();
+		if (!art_pool.data || !same_emitter(emitter, art_pool_emitter)) {
+			art_pool.init(particle_pool::steady_count(emitter) * 3 / 2 + 16);
+			art_pool.warm(emitter);
+			art_pool_emitter = emitter;
+		}
+	} else {
+		art_pool.destroy();
+	}
+	obs_leave_graphics();
 	
 	// Text shadow settings
 	text_shadow_enabled = obs_data_get_bool(settings, "text_shadow_enabled");
@@ -990,6 +1129,7 @@ void lowerthirds_source::update(obs_data_t *settings)
 	text_shadow_opacity = (int)obs_data_get_int(settings, "text_shadow_opacity");
 	text_shadow_offset_x = (int)obs_data_get_int(settings, "text_shadow_offset_x");
 	text_shadow_offset_y = (int)obs_data_get_int(settings, "text_shadow_offset_y");
+	text_shadow_blur = (int)obs_data_get_int(settings, "text_shadow_blur");
 	
 	// Logo shadow settings
 	logo_shadow_enabled = obs_data_get_bool(settings, "logo_shadow_enabled");
@@ -1005,6 +1145,12 @@ void lowerthirds_source::update(obs_data_t *settings)
 	text_highlight_corner_radius = (int)obs_data_get_int(settings, "text_highlight_corner_radius");
 	text_highlight_padding_horizontal = (int)obs_data_get_int(settings, "text_highlight_padding_horizontal");
 	text_highlight_padding_vertical = (int)obs_data_get_int(settings, "text_highlight_padding_vertical");
+	text_highlight_sdf = obs_data_get_bool(settings, "text_highlight_sdf");
+	text_highlight_border_width = (int)obs_data_get_int(settings, "text_highlight_border_width");
+	text_highlight_border_color = (uint32_t)obs_data_get_int(settings, "text_highlight_border_color");
+	text_highlight_inner_shadow = (int)obs_data_get_int(settings, "text_highlight_inner_shadow");
+	text_highlight_inner_shadow_color = (uint32_t)obs_data_get_int(settings, "text_highlight_inner_shadow_color");
+	text_highlight_inner_shadow_opacity = (int)obs_data_get_int(settings, "text_highlight_inner_shadow_opacity");
 	
 	// Load preview mode
 	preview_mode = obs_data_get_bool(settings, "preview_mode");
@@ -1038,88 +1184,396 @@ void lowerthirds_source::update(obs_data_t *settings)
 
 void lowerthirds_source::update_text_sources()
 {
-	// Use current profile's text content
-	int profile = current_profile;
+	update_glyph_fonts();
+	bool glyph = glyph_text_enabled && glyph_fonts[0] && glyph_fonts[1];
+	if (glyph) {
+		obs_enter_graphics();
+		glyph = glyph_text.load();
+		obs_leave_graphics();
+	}
+	if (glyph != use_glyph_text) {
+		// The other renderer has none of the strings yet
+		for (int p = 0; p < 5; p++) {
+			for (int t = 0; t < 4; t++)
+				text_fingerprints[p][t].valid = false;
+		}
+		use_glyph_text = glyph;
+		glyph_generation = glyph_atlas_generation();
+	}
+	if (use_glyph_text)
+		release_text_sources();
+	
+	// All profiles, so switching never rasterizes; only changed strings
+	// reach their source (or layout), and only non-empty strings have one
+	uint64_t performed = text_updates_performed;
+	for (int p = 0; p < 5; p++)
+		update_profile_text(p);
+	select_profile(current_profile);
+	
+	// Laying out (here or in another source) may have repacked the atlas
+	// under strings laid out before
+	refresh_glyph_layouts();
+	
+	// Highlight padding may have changed without the text
+	for (int p = 0; p < 5; p++) {
+		for (int t = 0; t < 4; t++)
+			update_text_box(text_metrics_cache[p][t]);
+	}
+	
+	if (text_updates_performed != performed && !use_glyph_text) {
+		int sources = 0;
+		for (int p = 0; p < 5; p++) {
+			for (int t = 0; t < 4; t++)
+				sources += profile_text_sources[p][t] ? 1 : 0;
+		}
+		blog(LOG_INFO, "Rasterized profile text: %llu sources updated, %d text sources, %zu/%zu/%zu/%zu/%zu KB per profile",
+			(unsigned long long)(text_updates_performed - performed), sources, profile_text_bytes(0) / 1024,
+			profile_text_bytes(1) / 1024, profile_text_bytes(2) / 1024, profile_text_bytes(3) / 1024,
+			profile_text_bytes(4) / 1024);
+	}
+}
+
+void lowerthirds_source::update_profile_text(int profile)
+{
+	update_text_source(profile, 0, title[profile], title_size, OBS_FONT_BOLD);
+	update_text_source(profile, 1, subtitle[profile], subtitle_size, 0);
+	
+	// Right side title and subtitle (optional)
+	update_text_source(profile, 2, title_right[profile], title_size, OBS_FONT_BOLD);
+	update_text_source(profile, 3, subtitle_right[profile], subtitle_size, 0);
+}
+
+// Lays every string out again when the shared atlas was repacked since
+// (by any source): the old layouts point at texels that now hold other
+// glyphs. A relayout can fill the atlas once more, hence the second round.
+void lowerthirds_source::refresh_glyph_layouts()
+{
+	for (int round = 0; round < 2; round++) {
+		uint64_t generation = glyph_atlas_generation();
+		if (!use_glyph_text || generation == glyph_generation)
+			return;
+		for (int p = 0; p < 5; p++) {
+			for (int t = 0; t < 4; t++)
+				text_fingerprints[p][t].valid = false;
+		}
+		for (int p = 0; p < 5; p++)
+			update_profile_text(p);
+		glyph_generation = generation;
+	}
+}
+
+// Title and subtitle fonts from the shared atlas for the current face and
+// sizes; null when built-in text is off or the face has no font file
+void lowerthirds_source::update_glyph_fonts()
+{
+	const char *face = font_face ? font_face : "";
+	const int sizes[2] = {title_size, subtitle_size};
+	const uint32_t flags[2] = {OBS_FONT_BOLD, 0};
+	for (int f = 0; f < 2; f++) {
+		bool current = glyph_text_enabled && glyph_fonts[f] && glyph_face == face && glyph_sizes[f] == sizes[f];
+		if (current)
+			continue;
+		glyph_font_release(glyph_fonts[f]);
+		glyph_fonts[f] = glyph_text_enabled ? glyph_font_acquire(face, sizes[f], flags[f]) : nullptr;
+		glyph_sizes[f] = sizes[f];
+	}
+	glyph_face = face;
+}
+
+// Create a UNIQUE text source for this instance (prevents conflicts when duplicating)
+// Use source pointer to ensure unique names for each duplicated instance
+void lowerthirds_source::create_text_source(int profile, int slot)
+{
+	static const char *text_names[4] = {"title", "subtitle", "title_right", "subtitle_right"};
+	if (profile_text_sources[profile][slot])
+		return;
+	char name_buffer[256];
+	if (profile == 0)
+		snprintf(name_buffer, sizeof(name_buffer), "lt_%s_%p", text_names[slot], (void*)source);
+	else
+		snprintf(name_buffer, sizeof(name_buffer), "lt_%s_p%d_%p", text_names[slot], profile + 1, (void*)source);
+	
+	// If FreeType text not available, try GDI (macOS uses FreeType usually)
+	obs_data_t *text_settings = obs_data_create();
+	profile_text_sources[profile][slot] = obs_source_create_private("text_ft2_source_v2", name_buffer, text_settings);
+	if (!profile_text_sources[profile][slot])
+		profile_text_sources[profile][slot] = obs_source_create_private("text_gdiplus_v2", name_buffer, text_settings);
+	obs_data_release(text_settings);
+}
+
+// Drops a slot whose string went empty: each text source holds several MB
+// whether or not it shows anything
+void lowerthirds_source::release_text_source(int profile, int slot)
+{
+	if (!profile_text_sources[profile][slot])
+		return;
+	obs_source_release(profile_text_sources[profile][slot]);
+	profile_text_sources[profile][slot] = nullptr;
+	text_fingerprints[profile][slot].valid = false;
+	text_metrics_cache[profile][slot] = text_metrics();
+	update_text_box(text_metrics_cache[profile][slot]);
+}
+
+void lowerthirds_source::release_text_sources()
+{
+	for (int p = 0; p < 5; p++) {
+		for (int t = 0; t < 4; t++) {
+			release_text_source(p, t);
+		}
+	}
+	title_text_source = nullptr;
+	subtitle_text_source = nullptr;
+	title_right_text_source = nullptr;
+	subtitle_right_text_source = nullptr;
+}
+
+// Switching is just re-pointing the render path at another profile's
+// sources (or layouts); update_text_sources() keeps all of them current
+void lowerthirds_source::select_profile(int profile)
+{
 	if (profile < 0 || profile >= 5)
 		profile = 0;
+	current_profile = profile;
+	title_text_source = profile_text_sources[profile][0];
+	subtitle_text_source = profile_text_sources[profile][1];
+	title_right_text_source = profile_text_sources[profile][2];
+	subtitle_right_text_source = profile_text_sources[profile][3];
+}
+
+// Memory the profile's text sources hold, RAM and VRAM together. A
+// text_ft2 source keeps its own A8 glyph cache, in a system memory buffer
+// and a texture of the same size, however short its string; text_gdiplus
+// keeps an RGBA bitmap and texture at the string's size. Built-in text holds
+// none of its own, its glyphs live in the shared atlas.
+size_t lowerthirds_source::profile_text_bytes(int profile)
+{
+	size_t bytes = 0;
+	for (int t = 0; t < 4; t++) {
+		obs_source_t *text_source = profile_text_sources[profile][t];
+		if (!text_source)
+			continue;
+		const char *id = obs_source_get_id(text_source);
+		if (id && strcmp(id, "text_ft2_source_v2") == 0)
+			bytes += (size_t)TEXT_FT2_TEXBUF_SIZE * TEXT_FT2_TEXBUF_SIZE * 2;
+		else
+			bytes += (size_t)obs_source_get_width(text_source) * obs_source_get_height(text_source) * 4 * 2;
+	}
+	return bytes;
+}
+
+// Sends the settings to one text source (or lays the string out again)
+// unless they match what it already shows: update() runs for every slider
+// drag and show/hide, and most of those leave the text alone. True if the
+// string was updated.
+bool lowerthirds_source::update_text_source(int profile, int slot, const char *text, int size, uint32_t flags)
+{
+	if (!text)
+		text = "";
+	if (!use_glyph_text) {
+		// Empty slots draw nothing and keep no source
+		if (!*text) {
+			release_text_source(profile, slot);
+			return false;
+		}
+		create_text_source(profile, slot);
+	}
+	obs_source_t *text_source = profile_text_sources[profile][slot];
+	if (!use_glyph_text && !text_source)
+		return false;
+	
+	text_fingerprint &last = text_fingerprints[profile][slot];
+	const char *face = font_face ? font_face : "";
+	// Built-in text takes its color per vertex at draw time, so a color
+	// change alone needs no new layout
+	bool same_color = use_glyph_text || last.color == text_color;
+	if (last.valid && last.size == size && last.flags == flags && same_color && last.text == text &&
+		last.face == face) {
+		text_updates_skipped++;
+		return false;
+	}
 	
-	if (title_text_source) {
+	if (use_glyph_text) {
+		// Color is per vertex at draw time; only the glyphs matter here
+		glyph_layout(glyph_fonts[slot & 1], text, glyph_layouts[profile][slot]);
+	} else {
 		obs_data_t *text_settings = obs_data_create();
-		obs_data_set_string(text_settings, "text", title[profile] ? title[profile] : "");
+		obs_data_set_string(text_settings, "text", text);
 		obs_data_set_int(text_settings, "color1", text_color);
 		obs_data_set_int(text_settings, "color2", text_color);
 		
 		// Font settings
 		obs_data_t *font_obj = obs_data_create();
 		obs_data_set_string(font_obj, "face", font_face);
-		obs_data_set_int(font_obj, "size", title_size);
-		obs_data_set_int(font_obj, "flags", OBS_FONT_BOLD);
+		obs_data_set_int(font_obj, "size", size);
+		obs_data_set_int(font_obj, "flags", flags);
 		obs_data_set_obj(text_settings, "font", font_obj);
 		obs_data_release(font_obj);
 		
-		obs_source_update(title_text_source, text_settings);
+		obs_source_update(text_source, text_settings);
 		obs_data_release(text_settings);
 	}
 	
-	if (subtitle_text_source) {
-		obs_data_t *text_settings = obs_data_create();
-		obs_data_set_string(text_settings, "text", subtitle[profile] ? subtitle[profile] : "");
-		obs_data_set_int(text_settings, "color1", text_color);
-		obs_data_set_int(text_settings, "color2", text_color);
+	last.valid = true;
+	last.text = text;
+	last.face = face;
+	last.size = size;
+	last.flags = flags;
+	last.color = text_color;
+	last.version = ++text_updates_performed;
+	measure_text(profile, slot);
+	return true;
+}
+
+// Slots are title, subtitle, right title, right subtitle of the current
+// profile
+bool lowerthirds_source::text_slot_ready(int slot)
+{
+	return use_glyph_text || profile_text_sources[current_profile][slot] != nullptr;
+}
+
+const text_metrics &lowerthirds_source::slot_metrics(int slot) const
+{
+	return text_metrics_cache[current_profile][slot];
+}
+
+// Measures a string after its text or font changed. Built-in text is laid
+// out already; a text source rasterizes on its next video tick, so until
+// tick_text_metrics() sees the new size the last one stays in use.
+void lowerthirds_source::measure_text(int profile, int slot)
+{
+	text_metrics &metrics = text_metrics_cache[profile][slot];
+	if (use_glyph_text) {
+		const text_layout &layout = glyph_layouts[profile][slot];
+		metrics.width = layout.width;
+		metrics.height = layout.height;
+		metrics.baseline = layout.baseline;
+		metrics.pending_ticks = 0;
+	} else {
+		obs_source_t *text_source = profile_text_sources[profile][slot];
+		metrics.width = obs_source_get_width(text_source);
+		metrics.height = obs_source_get_height(text_source);
 		
-		// Font settings
-		obs_data_t *font_obj = obs_data_create();
-		obs_data_set_string(font_obj, "face", font_face);
-		obs_data_set_int(font_obj, "size", subtitle_size);
-		obs_data_set_int(font_obj, "flags", 0); // Normal weight
-		obs_data_set_obj(text_settings, "font", font_obj);
-		obs_data_release(font_obj);
+		// text_ft2 does not report its baseline; its line box puts it about
+		// four fifths down
+		metrics.baseline = (float)metrics.height * 0.8f;
 		
-		obs_source_update(subtitle_text_source, text_settings);
-		obs_data_release(text_settings);
+		// Its tick may run before or after ours in the frame that applies it
+		metrics.pending_ticks = 2;
+	}
+	update_text_box(metrics);
+}
+
+// Highlight box around the string, relative to its origin (layout pixels,
+// before the text's own scale animation)
+void lowerthirds_source::update_text_box(text_metrics &metrics)
+{
+	metrics.box_x = -(float)text_highlight_padding_horizontal;
+	metrics.box_y = -(float)text_highlight_padding_vertical;
+	metrics.box_width = (float)metrics.width + 2.0f * (float)text_highlight_padding_horizontal;
+	metrics.box_height = (float)metrics.height + 2.0f * (float)text_highlight_padding_vertical;
+}
+
+// Re-measures text sources updated in the last few ticks, once their
+// deferred update has rasterized the new string
+void lowerthirds_source::tick_text_metrics()
+{
+	for (int p = 0; p < 5; p++) {
+		for (int t = 0; t < 4; t++) {
+			text_metrics &metrics = text_metrics_cache[p][t];
+			if (metrics.pending_ticks <= 0)
+				continue;
+			obs_source_t *text_source = profile_text_sources[p][t];
+			metrics.width = obs_source_get_width(text_source);
+			metrics.height = obs_source_get_height(text_source);
+			metrics.baseline = (float)metrics.height * 0.8f;
+			metrics.pending_ticks--;
+			update_text_box(metrics);
+		}
+	}
+}
+
+// Draws the slot's string under the current matrix: queued into the glyph
+// batch in `color`, or rendered through its text source (which has the
+// text color already; `tint` modulates it, for shadows)
+void lowerthirds_source::draw_text(int slot, uint32_t color, bool tint)
+{
+	if (use_glyph_text) {
+		glyph_text.add(glyph_layouts[current_profile][slot], color);
+		return;
 	}
 	
-	// Right side title (optional)
-	if (title_right_text_source) {
-		obs_data_t *text_settings = obs_data_create();
-		obs_data_set_string(text_settings, "text", title_right[profile] ? title_right[profile] : "");
-		obs_data_set_int(text_settings, "color1", text_color);
-		obs_data_set_int(text_settings, "color2", text_color);
-		
-		// Font settings
-		obs_data_t *font_obj = obs_data_create();
-		obs_data_set_string(font_obj, "face", font_face);
-		obs_data_set_int(font_obj, "size", title_size);
-		obs_data_set_int(font_obj, "flags", OBS_FONT_BOLD);
-		obs_data_set_obj(text_settings, "font", font_obj);
-		obs_data_release(font_obj);
-		
-		obs_source_update(title_right_text_source, text_settings);
-		obs_data_release(text_settings);
+	obs_source_t *text_source = profile_text_sources[current_profile][slot];
+	if (tint) {
+		gs_enable_color(true, true, true, true);
+		gs_color(color);
 	}
+	obs_source_video_render(text_source);
 	
-	// Right side subtitle (optional)
-	if (subtitle_right_text_source) {
-		obs_data_t *text_settings = obs_data_create();
-		obs_data_set_string(text_settings, "text", subtitle_right[profile] ? subtitle_right[profile] : "");
-		obs_data_set_int(text_settings, "color1", text_color);
-		obs_data_set_int(text_settings, "color2", text_color);
-		
-		// Font settings
-		obs_data_t *font_obj = obs_data_create();
-		obs_data_set_string(font_obj, "face", font_face);
-		obs_data_set_int(font_obj, "size", subtitle_size);
-		obs_data_set_int(font_obj, "flags", 0); // Normal weight
-		obs_data_set_obj(text_settings, "font", font_obj);
-		obs_data_release(font_obj);
+	// Reset color modulation to white (fully opaque)
+	if (tint)
+		gs_color(0xFFFFFFFF);
+}
+
+// Renders the shadow silhouette of each of the current profile's strings
+// that changed since its shadow was cached, so a frame draws every shadow
+// as one quad. Hard shadows on built-in text need no cache: they batch
+// with the text.
+void lowerthirds_source::update_text_shadows()
+{
+	if (!text_shadow_enabled || (use_glyph_text && text_shadow_blur == 0)) {
+		text_shadows.clear();
+		return;
+	}
+	if (!text_shadows.load())
+		return;
+	
+	for (int slot = 0; slot < 4; slot++) {
+		const text_metrics &metrics = slot_metrics(slot);
+		uint32_t cx = metrics.width, cy = metrics.height;
+		uint64_t version = text_fingerprints[current_profile][slot].version;
 		
-		obs_source_update(subtitle_right_text_source, text_settings);
-		obs_data_release(text_settings);
+		// A text source that may still be rasterizing is re-rendered until
+		// its size has settled
+		if (!cx || !cy || (metrics.pending_ticks == 0 &&
+			text_shadows.current(slot, current_profile, version, text_shadow_blur, cx, cy)))
+			continue;
+		if (!text_shadows.build_begin(slot, current_profile, version, text_shadow_blur, cx, cy))
+			continue;
+		if (use_glyph_text) {
+			glyph_text.begin();
+			glyph_text.add(glyph_layouts[current_profile][slot], 0xFFFFFFFF);
+			glyph_text.draw();
+		} else {
+			obs_source_video_render(profile_text_sources[current_profile][slot]);
+		}
+		text_shadows.build_end(slot);
 	}
 }
 
+// Cached shadows go out as they are reached, so they stay beneath every
+// string of the glyph batch, which is drawn last
+void lowerthirds_source::draw_text_shadow(int slot, uint32_t color)
+{
+	if (!text_shadows.draw(slot, color))
+		draw_text(slot, color, true);
+}
+
+// Draws the strings queued so far, so what is drawn next (a highlight box)
+// stays on top of them like it did with per-string draws
+void lowerthirds_source::flush_glyph_text()
+{
+	if (!use_glyph_text)
+		return;
+	glyph_text.draw();
+	glyph_text.begin();
+}
+
 void lowerthirds_source::tick(float seconds)
 {
+	// Text sources rasterize after an update; pick up their final size here
+	// rather than measuring in render()
+	tick_text_metrics();
+	
 	// Update animation (enhanced modern timing: 1.4 second duration for smooth, professional feel)
 	if (is_visible && animation_progress < 1.0f) {
 		animation_progress += seconds * 0.714f; // 1.4 second smooth animation (1/1.4 = 0.714)
@@ -1159,14 +1613,50 @@ void lowerthirds_source::tick(float seconds)
 		// Wrap around to prevent overflow
 		if (art_animation_offset > 10000.0f)
 			art_animation_offset = fmodf(art_animation_offset, 1000.0f);
+		
+		// Fixed-rate simulation: the art only changes on steps, in between
+		// render() reuses the cached pattern. A rate at or above the canvas
+		// frame rate steps every frame, so those draw live.
+		if (art_sim_rate > 0) {
+			float step = 1.0f / (float)art_sim_rate;
+			art_sim_live = seconds >= step * 0.999f;
+			art_sim_elapsed += seconds;
+			if (art_sim_elapsed >= step) {
+				art_sim_elapsed = fmodf(art_sim_elapsed, step);
+				art_sim_offset = art_animation_offset;
+			}
+		} else {
+			art_sim_live = true;
+		}
 	}
+	
+	// Pooled particles move on their own clock, independent of the offset
+	if (art_animate && art_uses_pool())
+		art_pool.update(art_emitter(), seconds);
+	
+	// Nothing for the governor to scale without an art effect
+	if (art_effect != ART_NONE)
+		art_gov.update(seconds);
+}
+
+// ABGR `color` with its alpha scaled, for per-vertex text color
+static inline uint32_t color_with_alpha(uint32_t color, float alpha)
+{
+	uint32_t a = (uint32_t)((float)(color >> 24) * alpha + 0.5f);
+	return (color & 0x00FFFFFF) | (a << 24);
 }
 
 void lowerthirds_source::render()
 {
+	// Upload images decoded since the last frame
+	bg_loader.swap(bg_image);
+	logo_loader.swap(logo_image);
+	
 	if (animation_progress <= 0.0f)
 		return;
 	
+	uint64_t render_start = art_gov.enabled ? os_gettime_ns() : 0;
+	
 	// Use FIXED internal width - never changes with OBS transforms
 	// This ensures text and logo positions are always stable
 	const uint32_t fixed_width = 1920;
@@ -1439,12 +1929,12 @@ void lowerthirds_source::render()
 	
 	// === Draw Background (optional - can be turned off) ===
 	if (show_background) {
-		if (bg_image && bg_image->texture) {
+		if (bg_image && bg_image->texture()) {
 			// Draw background image
 			gs_effect_t *image_effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
 			gs_eparam_t *image_param = gs_effect_get_param_by_name(image_effect, "image");
 			
-			gs_effect_set_texture(image_param, bg_image->texture);
+			gs_effect_set_texture(image_param, bg_image->texture());
 			
 			// Set opacity
 			if (alpha < 1.0f) {
@@ -1457,7 +1947,7 @@ void lowerthirds_source::render()
 			gs_blend_function(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA);
 			
 			while (gs_effect_loop(image_effect, "Draw")) {
-				gs_draw_sprite(bg_image->texture, 0, fixed_width, (uint32_t)bar_height);
+				gs_draw_sprite(bg_image->texture(), 0, fixed_width, (uint32_t)bar_height);
 			}
 			
 			gs_blend_state_pop();
@@ -1473,15 +1963,18 @@ void lowerthirds_source::render()
 		color1.z = ((bg_color >> 16) & 0xFF) / 255.0f;          // Blue
 		
 		// Second color (end color for gradient) - correct ABGR parsing
-		color2.w = ((gradient_color2 >> 24) & 0xFF) / 255.0f * alpha;  // Alpha
-		color2.x = (gradient_color2 & 0xFF) / 255.0f;                  // Red
-		color2.y = ((gradient_color2 >> 8) & 0xFF) / 255.0f;           // Green
-		color2.z = ((gradient_color2 >> 16) & 0xFF) / 255.0f;          // Blue
+		uint32_t end_color = gradient_stops[gradient_stop_count - 1];
+		color2.w = ((end_color >> 24) & 0xFF) / 255.0f * alpha;  // Alpha
+		color2.x = (end_color & 0xFF) / 255.0f;                  // Red
+		color2.y = ((end_color >> 8) & 0xFF) / 255.0f;           // Green
+		color2.z = ((end_color >> 16) & 0xFF) / 255.0f;          // Blue
 			
 			// Draw gradient or solid color
 			if (gradient_type != GRADIENT_NONE) {
-				// Draw gradient rectangle
-				draw_gradient_rect(0.0f, 0.0f, (float)fixed_width, bar_height, color1, color2, gradient_type);
+				// Multi-stop and radial gradients sample the baked LUT; two
+				// stops (or a missing effect file) are a per-vertex quad
+				if (!draw_gradient_lut((float)fixed_width, bar_height, alpha))
+					draw_gradient_rect(0.0f, 0.0f, (float)fixed_width, bar_height, color1, color2, gradient_type);
 			} else {
 				// Draw solid color rectangle
 				gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
@@ -1504,9 +1997,19 @@ void lowerthirds_source::render()
 	// Pattern renders on top of all background elements
 	if (show_background && art_effect != ART_NONE && art_opacity > 0) {
 		// Draw art effect within the current transformation matrix
-		draw_art_effect(0.0f, 0.0f, (float)fixed_width, bar_height, 
-			art_effect, art_color, (art_opacity / 100.0f) * alpha, 
-			art_intensity, art_animation_offset);
+		if (art_animate && art_loop_bake &&
+			draw_art_baked((float)fixed_width, bar_height, alpha)) {
+			// One cell of the baked loop
+		} else if (art_animate && art_sim_live) {
+			draw_art_effect(0.0f, 0.0f, (float)fixed_width, bar_height, 
+				art_effect, art_color, (art_opacity / 100.0f) * alpha, 
+				art_intensity, art_animation_offset);
+		} else {
+			// Frozen pattern or fixed-rate simulation: rendered once per
+			// change, a single textured quad on every other frame
+			draw_art_cached((float)fixed_width, bar_height, alpha,
+				art_animate ? art_sim_offset : art_animation_offset);
+		}
 	}
 	
 	gs_matrix_pop();
@@ -1514,7 +2017,7 @@ void lowerthirds_source::render()
 	// === Draw Logo (Left Side - Optional) ===
 	// Logo has INDEPENDENT padding controls - does NOT affect text position
 	float logo_width_with_padding = 0.0f;
-	if (logo_image && logo_image->texture && logo_alpha_animation > 0.01f) {
+	if (logo_image && logo_image->texture() && logo_alpha_animation > 0.01f) {
 		// Logo ALWAYS uses fixed pixel values (never scales with box size)
 		float fixed_logo_size = (float)logo_size;
 		float fixed_logo_pad_horizontal = (float)logo_padding_horizontal;
@@ -1679,13 +2182,13 @@ void lowerthirds_source::render()
 				float shadow_alpha = (logo_shadow_opacity / 100.0f) * final_logo_alpha;
 				
 				// Draw logo as shadow (darkened with shadow color)
-				draw_logo_with_alpha(logo_image->texture, fixed_logo_size, fixed_logo_size, shadow_alpha * 0.5f);
+				draw_logo_with_alpha(logo_image->texture(), fixed_logo_size, fixed_logo_size, shadow_alpha * 0.5f);
 				
 				gs_matrix_pop();
 			}
 			
 			// Draw logo with custom alpha support
-			draw_logo_with_alpha(logo_image->texture, fixed_logo_size, fixed_logo_size, final_logo_alpha);
+			draw_logo_with_alpha(logo_image->texture(), fixed_logo_size, fixed_logo_size, final_logo_alpha);
 			
 			gs_matrix_pop();
 		}
@@ -1706,6 +2209,9 @@ void lowerthirds_source::render()
 	// === Draw Text with Professional Animations ===
 	gs_blend_state_push();
 	gs_blend_function(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA);
+	refresh_glyph_layouts();
+	update_text_shadows();
+	glyph_text.begin();
 	
 	// Calculate total text height for centering (always use pixel values for stability)
 	float text_title_size = (float)title_size;
@@ -1870,23 +2376,23 @@ void lowerthirds_source::render()
 	}
 	
 	// Draw title text (appears first with animation)
-	if (title_text_source && title[current_profile] && strlen(title[current_profile]) > 0 && title_alpha > 0.01f) {
+	if (text_slot_ready(0) && title[current_profile] && strlen(title[current_profile]) > 0 && title_alpha > 0.01f) {
 		// Center text vertically in the bar (uses pixel values for stable position)
 		float title_y = center_offset + fixed_title_offset_y;
 		float title_x = fixed_padding_horizontal + logo_width_with_padding + fixed_title_offset_x;
 		
 		// Draw text highlight/background box (if enabled) - BEFORE text
 		if (text_highlight_enabled) {
-			uint32_t text_width = obs_source_get_width(title_text_source);
-			uint32_t text_height = obs_source_get_height(title_text_source);
-			
-			if (text_width > 0 && text_height > 0) {
-				float box_x = title_x - (float)text_highlight_padding_horizontal;
-				float box_y = title_y - (float)text_highlight_padding_vertical;
-				float box_width = (float)text_width + 2.0f * (float)text_highlight_padding_horizontal;
-				float box_height = (float)text_height + 2.0f * (float)text_highlight_padding_vertical;
+			const text_metrics &metrics = slot_metrics(0);
+			
+			if (metrics.width > 0 && metrics.height > 0) {
+				float box_x = title_x + metrics.box_x;
+				float box_y = title_y + metrics.box_y;
+				float box_width = metrics.box_width;
+				float box_height = metrics.box_height;
 				float highlight_opacity = (text_highlight_opacity / 100.0f) * title_alpha;
 				
+				flush_glyph_text();
 				draw_rounded_rect(box_x, box_y, box_width, box_height, 
 					(float)text_highlight_corner_radius, text_highlight_color, highlight_opacity);
 			}
@@ -1916,13 +2422,7 @@ void lowerthirds_source::render()
 			// Pack into RGBA format (R in lowest byte)
 			uint32_t shadow_color_packed = (shadow_a << 24) | (shadow_b << 16) | (shadow_g << 8) | shadow_r;
 			
-			gs_enable_color(true, true, true, true);
-			gs_color(shadow_color_packed);
-			
-			obs_source_video_render(title_text_source);
-			
-			// Reset color modulation to white (fully opaque)
-			gs_color(0xFFFFFFFF);
+			draw_text_shadow(0, shadow_color_packed);
 			
 			gs_matrix_pop();
 		}
@@ -1935,28 +2435,28 @@ void lowerthirds_source::render()
 				gs_effect_set_float(opacity_param, title_alpha);
 		}
 		
-		obs_source_video_render(title_text_source);
+		draw_text(0, color_with_alpha(text_color, title_alpha), false);
 		gs_matrix_pop();
 	}
 	
 	// Draw subtitle text (appears after title - staggered effect)
-	if (subtitle_text_source && subtitle[current_profile] && strlen(subtitle[current_profile]) > 0 && subtitle_alpha > 0.01f) {
+	if (text_slot_ready(1) && subtitle[current_profile] && strlen(subtitle[current_profile]) > 0 && subtitle_alpha > 0.01f) {
 		// Keep subtitle below title, centered in the bar
 		float subtitle_y = center_offset + text_title_size + text_spacing + fixed_subtitle_offset_y;
 		float subtitle_x = fixed_padding_horizontal + logo_width_with_padding + fixed_subtitle_offset_x;
 		
 		// Draw text highlight/background box (if enabled) - BEFORE text
 		if (text_highlight_enabled) {
-			uint32_t text_width = obs_source_get_width(subtitle_text_source);
-			uint32_t text_height = obs_source_get_height(subtitle_text_source);
-			
-			if (text_width > 0 && text_height > 0) {
-				float box_x = subtitle_x - (float)text_highlight_padding_horizontal;
-				float box_y = subtitle_y - (float)text_highlight_padding_vertical;
-				float box_width = (float)text_width + 2.0f * (float)text_highlight_padding_horizontal;
-				float box_height = (float)text_height + 2.0f * (float)text_highlight_padding_vertical;
+			const text_metrics &metrics = slot_metrics(1);
+			
+			if (metrics.width > 0 && metrics.height > 0) {
+				float box_x = subtitle_x + metrics.box_x;
+				float box_y = subtitle_y + metrics.box_y;
+				float box_width = metrics.box_width;
+				float box_height = metrics.box_height;
 				float highlight_opacity = (text_highlight_opacity / 100.0f) * subtitle_alpha;
 				
+				flush_glyph_text();
 				draw_rounded_rect(box_x, box_y, box_width, box_height, 
 					(float)text_highlight_corner_radius, text_highlight_color, highlight_opacity);
 			}
@@ -1986,13 +2486,7 @@ void lowerthirds_source::render()
 			// Pack into RGBA format (R in lowest byte)
 			uint32_t shadow_color_packed = (shadow_a << 24) | (shadow_b << 16) | (shadow_g << 8) | shadow_r;
 			
-			gs_enable_color(true, true, true, true);
-			gs_color(shadow_color_packed);
-			
-			obs_source_video_render(subtitle_text_source);
-			
-			// Reset color modulation to white (fully opaque)
-			gs_color(0xFFFFFFFF);
+			draw_text_shadow(1, shadow_color_packed);
 			
 			gs_matrix_pop();
 		}
@@ -2005,7 +2499,7 @@ void lowerthirds_source::render()
 				gs_effect_set_float(opacity_param, subtitle_alpha);
 		}
 		
-		obs_source_video_render(subtitle_text_source);
+		draw_text(1, color_with_alpha(text_color, subtitle_alpha), false);
 		gs_matrix_pop();
 	}
 	
@@ -2149,22 +2643,22 @@ void lowerthirds_source::render()
 	}
 	
 	// Draw right title text (with modern scale animation - DELAYED)
-	if (title_right_text_source && title_right[current_profile] && strlen(title_right[current_profile]) > 0 && title_right_alpha > 0.01f) {
+	if (text_slot_ready(2) && title_right[current_profile] && strlen(title_right[current_profile]) > 0 && title_right_alpha > 0.01f) {
 		// Get text width for right alignment (pixel values for stable position)
-		uint32_t title_right_width = obs_source_get_width(title_right_text_source);
-		uint32_t title_right_height = obs_source_get_height(title_right_text_source);
-		float title_right_x = (float)fixed_width - (float)title_right_width - fixed_padding_horizontal - fixed_title_right_offset_x;
+		const text_metrics &title_right_metrics = slot_metrics(2);
+		float title_right_x = (float)fixed_width - (float)title_right_metrics.width - fixed_padding_horizontal - fixed_title_right_offset_x;
 		// Keep right text centered vertically too (use fixed offset)
 		float title_right_y = center_offset + fixed_title_right_offset_y;
 		
 		// Draw text highlight/background box (if enabled) - BEFORE text
-		if (text_highlight_enabled && title_right_width > 0 && title_right_height > 0) {
-			float box_x = title_right_x - (float)text_highlight_padding_horizontal;
-			float box_y = title_right_y - (float)text_highlight_padding_vertical;
-			float box_width = (float)title_right_width + 2.0f * (float)text_highlight_padding_horizontal;
-			float box_height = (float)title_right_height + 2.0f * (float)text_highlight_padding_vertical;
+		if (text_highlight_enabled && title_right_metrics.width > 0 && title_right_metrics.height > 0) {
+			float box_x = title_right_x + title_right_metrics.box_x;
+			float box_y = title_right_y + title_right_metrics.box_y;
+			float box_width = title_right_metrics.box_width;
+			float box_height = title_right_metrics.box_height;
 			float highlight_opacity = (text_highlight_opacity / 100.0f) * title_right_alpha;
 			
+			flush_glyph_text();
 			draw_rounded_rect(box_x, box_y, box_width, box_height, 
 				(float)text_highlight_corner_radius, text_highlight_color, highlight_opacity);
 		}
@@ -2193,13 +2687,7 @@ void lowerthirds_source::render()
 			// Pack into RGBA format (R in lowest byte)
 			uint32_t shadow_color_packed = (shadow_a << 24) | (shadow_b << 16) | (shadow_g << 8) | shadow_r;
 			
-			gs_enable_color(true, true, true, true);
-			gs_color(shadow_color_packed);
-			
-			obs_source_video_render(title_right_text_source);
-			
-			// Reset color modulation to white (fully opaque)
-			gs_color(0xFFFFFFFF);
+			draw_text_shadow(2, shadow_color_packed);
 			
 			gs_matrix_pop();
 		}
@@ -2212,27 +2700,27 @@ void lowerthirds_source::render()
 				gs_effect_set_float(opacity_param, title_right_alpha);
 		}
 		
-		obs_source_video_render(title_right_text_source);
+		draw_text(2, color_with_alpha(text_color, title_right_alpha), false);
 		gs_matrix_pop();
 	}
 	
 	// Draw right subtitle text (with modern scale animation - MORE DELAYED)
-	if (subtitle_right_text_source && subtitle_right[current_profile] && strlen(subtitle_right[current_profile]) > 0 && subtitle_right_alpha > 0.01f) {
+	if (text_slot_ready(3) && subtitle_right[current_profile] && strlen(subtitle_right[current_profile]) > 0 && subtitle_right_alpha > 0.01f) {
 		// Get text width for right alignment (pixel values for stable position)
-		uint32_t subtitle_right_width = obs_source_get_width(subtitle_right_text_source);
-		uint32_t subtitle_right_height = obs_source_get_height(subtitle_right_text_source);
-		float subtitle_right_x = (float)fixed_width - (float)subtitle_right_width - fixed_padding_horizontal - fixed_subtitle_right_offset_x;
+		const text_metrics &subtitle_right_metrics = slot_metrics(3);
+		float subtitle_right_x = (float)fixed_width - (float)subtitle_right_metrics.width - fixed_padding_horizontal - fixed_subtitle_right_offset_x;
 		// Keep right subtitle centered vertically (use fixed values)
 		float subtitle_right_y = center_offset + text_title_size + text_spacing + fixed_subtitle_right_offset_y;
 		
 		// Draw text highlight/background box (if enabled) - BEFORE text
-		if (text_highlight_enabled && subtitle_right_width > 0 && subtitle_right_height > 0) {
-			float box_x = subtitle_right_x - (float)text_highlight_padding_horizontal;
-			float box_y = subtitle_right_y - (float)text_highlight_padding_vertical;
-			float box_width = (float)subtitle_right_width + 2.0f * (float)text_highlight_padding_horizontal;
-			float box_height = (float)subtitle_right_height + 2.0f * (float)text_highlight_padding_vertical;
+		if (text_highlight_enabled && subtitle_right_metrics.width > 0 && subtitle_right_metrics.height > 0) {
+			float box_x = subtitle_right_x + subtitle_right_metrics.box_x;
+			float box_y = subtitle_right_y + subtitle_right_metrics.box_y;
+			float box_width = subtitle_right_metrics.box_width;
+			float box_height = subtitle_right_metrics.box_height;
 			float highlight_opacity = (text_highlight_opacity / 100.0f) * subtitle_right_alpha;
 			
+			flush_glyph_text();
 			draw_rounded_rect(box_x, box_y, box_width, box_height, 
 				(float)text_highlight_corner_radius, text_highlight_color, highlight_opacity);
 		}
@@ -2261,13 +2749,7 @@ void lowerthirds_source::render()
 			// Pack into RGBA format (R in lowest byte)
 			uint32_t shadow_color_packed = (shadow_a << 24) | (shadow_b << 16) | (shadow_g << 8) | shadow_r;
 			
-			gs_enable_color(true, true, true, true);
-			gs_color(shadow_color_packed);
-			
-			obs_source_video_render(subtitle_right_text_source);
-			
-			// Reset color modulation to white (fully opaque)
-			gs_color(0xFFFFFFFF);
+			draw_text_shadow(3, shadow_color_packed);
 			
 			gs_matrix_pop();
 		}
@@ -2280,11 +2762,16 @@ void lowerthirds_source::render()
 				gs_effect_set_float(opacity_param, subtitle_right_alpha);
 		}
 		
-		obs_source_video_render(subtitle_right_text_source);
+		draw_text(3, color_with_alpha(text_color, subtitle_right_alpha), false);
 		gs_matrix_pop();
 	}
 	
+	// Every string and shadow queued above, in one draw
+	flush_glyph_text();
 	gs_blend_state_pop();
+	
+	if (art_gov.enabled)
+		art_gov.sample(os_gettime_ns() - render_start);
 }
 
 uint32_t lowerthirds_source::get_width()
@@ -2297,160 +2784,95 @@ uint32_t lowerthirds_source::get_height()
 	return bar_height_pixels;
 }
 
-void lowerthirds_source::draw_gradient_rect(float x, float y, float width, float height, 
-	struct vec4 color1, struct vec4 color2, GradientType type)
+// Gradient position (0 = first stop, 1 = last) at the top-left, top-right,
+// bottom-left and bottom-right corner. Every linear type is affine in x and
+// y, so these four values define it completely. Diagonals run corner to
+// corner; an angle spans the projection of the rectangle onto its direction.
+static void gradient_corners(GradientType type, int angle, float width, float height, float t[4])
 {
-	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
-	gs_eparam_t *param_color = gs_effect_get_param_by_name(solid, "color");
-	
-	// For gradients, we need to draw with per-vertex colors
-	// OBS doesn't have a built-in gradient effect, so we'll use multiple strips
-	
-	const int gradient_steps = 32; // Smooth gradient with 32 color steps
-	
 	switch (type) {
 		case GRADIENT_HORIZONTAL:
-			// Left to right gradient
-			for (int i = 0; i < gradient_steps; i++) {
-				float t1 = (float)i / (float)gradient_steps;
-				float t2 = (float)(i + 1) / (float)gradient_steps;
-				
-				// Interpolate colors
-				struct vec4 c1, c2;
-				c1.x = color1.x + (color2.x - color1.x) * t1;
-				c1.y = color1.y + (color2.y - color1.y) * t1;
-				c1.z = color1.z + (color2.z - color1.z) * t1;
-				c1.w = color1.w + (color2.w - color1.w) * t1;
-				
-				c2.x = color1.x + (color2.x - color1.x) * t2;
-				c2.y = color1.y + (color2.y - color1.y) * t2;
-				c2.z = color1.z + (color2.z - color1.z) * t2;
-				c2.w = color1.w + (color2.w - color1.w) * t2;
-				
-				float x1 = x + width * t1;
-				float x2 = x + width * t2;
-				
-				// Draw strip with first color
-				gs_effect_set_vec4(param_color, &c1);
-				while (gs_effect_loop(solid, "Solid")) {
-					gs_render_start(true);
-					gs_vertex2f(x1, y);
-					gs_vertex2f(x2, y);
-					gs_vertex2f(x1, y + height);
-					gs_vertex2f(x2, y + height);
-					gs_render_stop(GS_TRISTRIP);
-				}
-			}
+			t[0] = 0.0f; t[1] = 1.0f; t[2] = 0.0f; t[3] = 1.0f;
 			break;
-			
 		case GRADIENT_VERTICAL:
-			// Top to bottom gradient
-			for (int i = 0; i < gradient_steps; i++) {
-				float t1 = (float)i / (float)gradient_steps;
-				float t2 = (float)(i + 1) / (float)gradient_steps;
-				
-				// Interpolate colors
-				struct vec4 c1, c2;
-				c1.x = color1.x + (color2.x - color1.x) * t1;
-				c1.y = color1.y + (color2.y - color1.y) * t1;
-				c1.z = color1.z + (color2.z - color1.z) * t1;
-				c1.w = color1.w + (color2.w - color1.w) * t1;
-				
-				c2.x = color1.x + (color2.x - color1.x) * t2;
-				c2.y = color1.y + (color2.y - color1.y) * t2;
-				c2.z = color1.z + (color2.z - color1.z) * t2;
-				c2.w = color1.w + (color2.w - color1.w) * t2;
-				
-				float y1 = y + height * t1;
-				float y2 = y + height * t2;
-				
-				// Draw strip with color
-				gs_effect_set_vec4(param_color, &c1);
-				while (gs_effect_loop(solid, "Solid")) {
-					gs_render_start(true);
-					gs_vertex2f(x, y1);
-					gs_vertex2f(x + width, y1);
-					gs_vertex2f(x, y2);
-					gs_vertex2f(x + width, y2);
-					gs_render_stop(GS_TRISTRIP);
-				}
-			}
+		case GRADIENT_RADIAL:       // Not affine: the two-color fallback runs top to bottom
+			t[0] = 0.0f; t[1] = 0.0f; t[2] = 1.0f; t[3] = 1.0f;
 			break;
-			
 		case GRADIENT_DIAGONAL_TL_BR:
-			// Top-left to bottom-right diagonal
-			for (int i = 0; i < gradient_steps; i++) {
-				float t1 = (float)i / (float)gradient_steps;
-				float t2 = (float)(i + 1) / (float)gradient_steps;
-				
-				// Interpolate colors
-				struct vec4 c1;
-				c1.x = color1.x + (color2.x - color1.x) * t1;
-				c1.y = color1.y + (color2.y - color1.y) * t1;
-				c1.z = color1.z + (color2.z - color1.z) * t1;
-				c1.w = color1.w + (color2.w - color1.w) * t1;
-				
-				gs_effect_set_vec4(param_color, &c1);
-				while (gs_effect_loop(solid, "Solid")) {
-					// Simplified diagonal rendering using horizontal strips
-					float y1 = y + height * t1;
-					float y2 = y + height * t2;
-					gs_render_start(true);
-					gs_vertex2f(x, y1);
-					gs_vertex2f(x + width, y1);
-					gs_vertex2f(x, y2);
-					gs_vertex2f(x + width, y2);
-					gs_render_stop(GS_TRISTRIP);
-				}
-			}
+			t[0] = 0.0f; t[1] = 0.5f; t[2] = 0.5f; t[3] = 1.0f;
 			break;
-			
 		case GRADIENT_DIAGONAL_BL_TR:
-			// Bottom-left to top-right diagonal
-			for (int i = 0; i < gradient_steps; i++) {
-				float t1 = (float)i / (float)gradient_steps;
-				float t2 = (float)(i + 1) / (float)gradient_steps;
-				
-				// Interpolate colors (reversed)
-				struct vec4 c1;
-				c1.x = color1.x + (color2.x - color1.x) * t1;
-				c1.y = color1.y + (color2.y - color1.y) * t1;
-				c1.z = color1.z + (color2.z - color1.z) * t1;
-				c1.w = color1.w + (color2.w - color1.w) * t1;
-				
-				gs_effect_set_vec4(param_color, &c1);
-				while (gs_effect_loop(solid, "Solid")) {
-					// Reversed vertical strips
-					float y1 = y + height * (1.0f - t2);
-					float y2 = y + height * (1.0f - t1);
-					gs_render_start(true);
-					gs_vertex2f(x, y1);
-					gs_vertex2f(x + width, y1);
-					gs_vertex2f(x, y2);
-					gs_vertex2f(x + width, y2);
-					gs_render_stop(GS_TRISTRIP);
-				}
-			}
+			t[0] = 0.5f; t[1] = 1.0f; t[2] = 0.0f; t[3] = 0.5f;
 			break;
-			
+		case GRADIENT_ANGLE: {
+			// Y points down, so 90 degrees runs top to bottom
+			float rad = (float)angle * (3.14159265f / 180.0f);
+			float dx = cosf(rad) * width, dy = sinf(rad) * height;
+			float d[4] = {0.0f, dx, dy, dx + dy};
+			float lo = fminf(fminf(d[0], d[1]), fminf(d[2], d[3]));
+			float hi = fmaxf(fmaxf(d[0], d[1]), fmaxf(d[2], d[3]));
+			for (int i = 0; i < 4; i++)
+				t[i] = hi > lo ? (d[i] - lo) / (hi - lo) : 0.0f;
+			break;
+		}
 		case GRADIENT_NONE:
 		default:
-			// Solid color
-			gs_effect_t *solid_effect = obs_get_base_effect(OBS_EFFECT_SOLID);
-			gs_eparam_t *color_param = gs_effect_get_param_by_name(solid_effect, "color");
-			gs_effect_set_vec4(color_param, &color1);
-			
-			while (gs_effect_loop(solid_effect, "Solid")) {
-				gs_render_start(true);
-				gs_vertex2f(x, y);              // Top-left
-				gs_vertex2f(x + width, y);      // Top-right
-				gs_vertex2f(x, y + height);        // Bottom-left
-				gs_vertex2f(x + width, y + height); // Bottom-right
-				gs_render_stop(GS_TRISTRIP);
-			}
+			t[0] = t[1] = t[2] = t[3] = 0.0f;
 			break;
 	}
-	}
+}
+
+void lowerthirds_source::draw_gradient_rect(float x, float y, float width, float height, 
+	struct vec4 color1, struct vec4 color2, GradientType type)
+{
+	// The rasterizer's per-vertex interpolation reproduces an affine
+	// gradient exactly, so the whole gradient is one quad
+	float t[4];
+	gradient_corners(type, gradient_angle, width, height, t);
+
+	uint32_t corner[4];
+	for (int i = 0; i < 4; i++) {
+		struct vec4 c;
+		vec4_set(&c,
+			color1.x + (color2.x - color1.x) * t[i],
+			color1.y + (color2.y - color1.y) * t[i],
+			color1.z + (color2.z - color1.z) * t[i],
+			color1.w + (color2.w - color1.w) * t[i]);
+		corner[i] = vec4_to_rgba(&c);
+	}
+
+	// Vertex colors carry the full RGBA; the uniform just passes them through
+	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
+	gs_eparam_t *param_color = gs_effect_get_param_by_name(solid, "color");
+	struct vec4 white;
+	vec4_set(&white, 1.0f, 1.0f, 1.0f, 1.0f);
+	gs_effect_set_vec4(param_color, &white);
+
+	while (gs_effect_loop(solid, "SolidColored")) {
+		gs_render_start(true);
+		gs_color(corner[0]);
+		gs_vertex2f(x, y);                      // Top-left
+		gs_color(corner[1]);
+		gs_vertex2f(x + width, y);              // Top-right
+		gs_color(corner[2]);
+		gs_vertex2f(x, y + height);             // Bottom-left
+		gs_color(corner[3]);
+		gs_vertex2f(x + width, y + height);     // Bottom-right
+		gs_render_stop(GS_TRISTRIP);
+	}
+}
+
+bool lowerthirds_source::draw_gradient_lut(float width, float height, float alpha)
+{
+	if (gradient_type == GRADIENT_RADIAL)
+		return gradient_tex.draw_radial(gradient_stops, gradient_stop_count, width, height, alpha);
+	if (gradient_stop_count <= 2)
+		return false;
+
+	float t[4];
+	gradient_corners(gradient_type, gradient_angle, width, height, t);
+	return gradient_tex.draw_linear(gradient_stops, gradient_stop_count, width, height, t, alpha);
+}
 
 // Helper function to draw logo/image with custom alpha/opacity
 void lowerthirds_source::draw_logo_with_alpha(gs_texture_t *texture, float width, float height, float alpha)
@@ -2518,101 +2940,296 @@ void lowerthirds_source::draw_rounded_rect(float x, float y, float width, float
 		opacity                             // A
 	);
 	
-	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
-	gs_eparam_t *color_param = gs_effect_get_param_by_name(solid, "color");
-	gs_effect_set_vec4(color_param, &color_vec);
+	if (text_highlight_sdf) {
+		// Border and inner shadow fade with the box
+		rounded_rect_style style;
+		style.fill = color_vec;
+		vec4_from_rgba(&style.border, text_highlight_border_color);
+		style.border.w *= opacity;
+		style.border_width = (float)text_highlight_border_width;
+		vec4_from_rgba(&style.shadow, text_highlight_inner_shadow_color);
+		style.shadow.w = (text_highlight_inner_shadow_opacity / 100.0f) * opacity;
+		style.shadow_size = (float)text_highlight_inner_shadow;
+		
+		gs_matrix_push();
+		gs_matrix_translate3f(x, y, 0.0f);
+		bool drawn = highlight_sdf.draw(width, height, radius, style);
+		gs_matrix_pop();
+		if (drawn)
+			return;
+	}
+	
+	// Corners are quarters of the shared unit circle, hard-edged so held to
+	// 0.25 px on screen; the geometry is cached per size, radius and segments
+	int segments = 0;
+	if (radius > 0.5f)
+		segments = (unit_circle_segments(radius * scale_factor, 0.25f, 8) + 3) / 4;
 	
 	gs_matrix_push();
 	gs_matrix_translate3f(x, y, 0.0f);
+	highlight_rects.draw(width, height, radius, segments, color_vec);
+	gs_matrix_pop();
+}
+
+// Segments for one glow layer of an art circle. Layers are soft and stacked,
+// so a facet on a faint outer layer is far less visible than one on the core:
+// the error budget grows as the layer's relative alpha falls (0.5 px on the
+// core, at most 10 px). The adaptive quality tier scales the whole budget.
+static inline int art_circle_segments(float screen_radius, float layer_falloff, const art_quality &q)
+{
+	return unit_circle_segments(screen_radius, q.error_scale * 0.5f / fmaxf(layer_falloff, 0.05f), 6);
+}
+
+// Segments for a curve running `length` layout pixels whose second derivative
+// stays under `curvature`. A chord of length h strays at most
+// curvature * h^2 / 8 from the curve; that is held under the circles' half
+// pixel on screen, scaled by the quality tier.
+static inline int art_curve_segments(float length, float curvature, float screen_scale,
+	const art_quality &q, int min_segments, int max_segments)
+{
+	float max_error = q.error_scale * 0.5f / fmaxf(screen_scale, 0.01f);
+	int segments = (int)ceilf(length * sqrtf(curvature / (8.0f * max_error)));
+	return segments < min_segments ? min_segments : segments > max_segments ? max_segments : segments;
+}
+
+// Steps for a stepped alpha fade spanning `alpha_range` whose steepest slope
+// (per unit length) is `max_slope`: no step jumps more than two 8-bit levels,
+// scaled by the quality tier
+static inline int art_fade_segments(float alpha_range, float max_slope, const art_quality &q, int max_segments)
+{
+	int segments = (int)ceilf(alpha_range * max_slope * 255.0f / (2.0f * q.error_scale));
+	return segments < 1 ? 1 : segments > max_segments ? max_segments : segments;
+}
+
+// Light ray alpha along its length (0 = start, 1 = end)
+static inline float art_ray_falloff(float t)
+{
+	return powf(1.0f - t, 1.5f);
+}
+
+// Energy pulse alpha: peaks near the front (30%) and fades at both ends
+static inline float art_pulse_falloff(float t)
+{
+	return 1.0f - powf(fabsf(t - 0.3f) / 0.7f, 1.5f);
+}
+
+// Sparkle twinkle: a sharpened sine, so stars flash briefly
+static inline float art_twinkle(float phase)
+{
+	float twinkle_raw = sinf(phase) * 0.5f + 0.5f;
+	return twinkle_raw * twinkle_raw * twinkle_raw;
+}
+
+// Light streak position along the bar and its edge-faded alpha
+static inline float art_streak_pos(const art_element_table &t, int i, float animation_offset, float width)
+{
+	return fmodf(animation_offset * t.speed[i] + t.phase[i], width + 250.0f) - 125.0f;
+}
+
+static inline float art_streak_alpha(float streak_pos, float streak_length, float width, float opacity)
+{
+	// Smooth fade in/out at edges with smooth curve
+	float streak_alpha = opacity * 0.5f;
+	float fade_distance = 120.0f;
+	if (streak_pos < 0.0f) {
+		float fade = (fade_distance + streak_pos) / fade_distance;
+		streak_alpha *= fade * fade;
+	} else if (streak_pos > width - streak_length) {
+		float over = streak_pos - (width - streak_length);
+		float fade = 1.0f - over / fade_distance;
+		streak_alpha *= fade * fade;
+	}
+	return streak_alpha;
+}
+
+// Precompute the static per-element terms of the art effects. Only rebuilds
+// when the effect, intensity or bar size actually changed.
+void lowerthirds_source::update_art_table(BackgroundArtEffect effect, float intensity, float width, float height)
+{
+	art_element_table &t = art_table;
+	if (t.data && t.effect == effect && t.intensity == intensity &&
+		t.width == width && t.height == height)
+		return;
 	
-	while (gs_effect_loop(solid, "Solid")) {
-		if (radius <= 0.5f) {
-			// Draw simple rectangle (no rounded corners)
-			gs_render_start(true);
-			gs_vertex2f(0.0f, 0.0f);
-			gs_vertex2f(width, 0.0f);
-			gs_vertex2f(0.0f, height);
-			gs_vertex2f(width, height);
-			gs_render_stop(GS_TRISTRIP);
-		} else {
-			// Draw rounded rectangle using segments
-			int segments = 8; // Number of segments per corner
-			
-			// Center rectangle (main body)
-			gs_render_start(true);
-			gs_vertex2f(radius, 0.0f);
-			gs_vertex2f(width - radius, 0.0f);
-			gs_vertex2f(radius, height);
-			gs_vertex2f(width - radius, height);
-			gs_render_stop(GS_TRISTRIP);
-			
-			// Left rectangle
-			gs_render_start(true);
-			gs_vertex2f(0.0f, radius);
-			gs_vertex2f(radius, radius);
-			gs_vertex2f(0.0f, height - radius);
-			gs_vertex2f(radius, height - radius);
-			gs_render_stop(GS_TRISTRIP);
-			
-			// Right rectangle
-			gs_render_start(true);
-			gs_vertex2f(width - radius, radius);
-			gs_vertex2f(width, radius);
-			gs_vertex2f(width - radius, height - radius);
-			gs_vertex2f(width, height - radius);
-			gs_render_stop(GS_TRISTRIP);
-			
-			// Top-left corner (triangle strip)
-			for (int i = 0; i < segments; i++) {
-				float angle1 = (float)M_PI + (float)i / (float)segments * (float)M_PI / 2.0f;
-				float angle2 = (float)M_PI + (float)(i + 1) / (float)segments * (float)M_PI / 2.0f;
-				
-				gs_render_start(true);
-				gs_vertex2f(radius, radius); // Center
-				gs_vertex2f(radius + radius * cosf(angle1), radius + radius * sinf(angle1));
-				gs_vertex2f(radius + radius * cosf(angle2), radius + radius * sinf(angle2));
-				gs_render_stop(GS_TRIS);
+	int count = 0;
+	switch (effect) {
+		case ART_PARTICLES:     count = (int)(60 * intensity); break;
+		case ART_LIGHT_RAYS:    count = (int)(10 * intensity); break;
+		case ART_BOKEH:         count = (int)(20 * intensity); break;
+		case ART_SPARKLES:      count = (int)(50 * intensity); break;
+		case ART_GLOW_ORBS:     count = (int)(12 * intensity); break;
+		case ART_LIGHT_STREAKS: count = (int)(8 * intensity); break;
+		case ART_SHIMMER:       count = (int)(15 * intensity); break;
+		case ART_ENERGY_FLOW:   count = (int)(6 * intensity) * 2; break;
+		default: break;
+	}
+	if (count < 0)
+		count = 0;
+	
+	// Zero-filled padding lanes are harmless inputs for the vector kernels
+	const int num_arrays = 13;
+	const int stride = art_kernel_padded(count > 0 ? count : 1);
+	bfree(t.data);
+	t.data = (float *)bzalloc(sizeof(float) * num_arrays * stride);
+	t.x = t.data;
+	t.y = t.x + stride;
+	t.size = t.y + stride;
+	t.thickness = t.size + stride;
+	t.speed = t.thickness + stride;
+	t.phase = t.speed + stride;
+	t.phase2 = t.phase + stride;
+	t.phase3 = t.phase2 + stride;
+	t.frequency = t.phase3 + stride;
+	t.amplitude = t.frequency + stride;
+	t.sim_x = t.amplitude + stride;
+	t.sim_y = t.sim_x + stride;
+	t.sim_alpha = t.sim_y + stride;
+	memset(t.layer_falloff, 0, sizeof(t.layer_falloff));
+	
+	t.effect = effect;
+	t.intensity = intensity;
+	t.width = width;
+	t.height = height;
+	t.count = count;
+	
+	switch (effect) {
+		case ART_PARTICLES: {
+			float base_particle_size = 4.0f * intensity;
+			for (int i = 0; i < count; i++) {
+				float seed = (float)i * 12.9898f;
+				t.x[i] = fmodf(sinf(seed) * 43758.5453f, width);
+				t.y[i] = fmodf(cosf(seed * 1.414f) * 43758.5453f, height);
+				t.speed[i] = (0.3f + fmodf(sinf(seed * 2.718f), 0.4f)) * 8.0f;
+				t.phase[i] = seed;                  // Drift
+				t.phase2[i] = seed * 3.14159f;      // Pulse
+				t.size[i] = base_particle_size * (0.7f + sinf(seed * 7.0f) * 0.5f);
 			}
-			
-			// Top-right corner (triangle strip)
-			for (int i = 0; i < segments; i++) {
-				float angle1 = 1.5f * (float)M_PI + (float)i / (float)segments * (float)M_PI / 2.0f;
-				float angle2 = 1.5f * (float)M_PI + (float)(i + 1) / (float)segments * (float)M_PI / 2.0f;
-				
-				gs_render_start(true);
-				gs_vertex2f(width - radius, radius); // Center
-				gs_vertex2f(width - radius + radius * cosf(angle1), radius + radius * sinf(angle1));
-				gs_vertex2f(width - radius + radius * cosf(angle2), radius + radius * sinf(angle2));
-				gs_render_stop(GS_TRIS);
+			for (int layer = 0; layer < 5; layer++)
+				t.layer_falloff[layer] = powf(1.0f - (float)layer / 5.0f, 2.0f);
+			break;
+		}
+		
+		case ART_LIGHT_RAYS: {
+			for (int i = 0; i < count; i++) {
+				float angle = ((float)i / (float)count) * (float)M_PI * 0.6f - (float)M_PI * 0.1f;
+				t.x[i] = cosf(angle + (float)M_PI * 0.25f);
+				t.y[i] = sinf(angle + (float)M_PI * 0.25f);
+				t.phase[i] = -250.0f + i * 70.0f;  // Start distance
 			}
-			
-			// Bottom-left corner (triangle strip)
-			for (int i = 0; i < segments; i++) {
-				float angle1 = 0.5f * (float)M_PI + (float)i / (float)segments * (float)M_PI / 2.0f;
-				float angle2 = 0.5f * (float)M_PI + (float)(i + 1) / (float)segments * (float)M_PI / 2.0f;
-				
-				gs_render_start(true);
-				gs_vertex2f(radius, height - radius); // Center
-				gs_vertex2f(radius + radius * cosf(angle1), height - radius + radius * sinf(angle1));
-				gs_vertex2f(radius + radius * cosf(angle2), height - radius + radius * sinf(angle2));
-				gs_render_stop(GS_TRIS);
+			break;
+		}
+		
+		case ART_BOKEH: {
+			for (int i = 0; i < count; i++) {
+				float seed = (float)i * 17.951f;
+				t.x[i] = fmodf(sinf(seed) * 43758.5453f + width * 0.5f, width);
+				t.y[i] = fmodf(cosf(seed * 1.732f) * 43758.5453f + height * 0.5f, height);
+				t.phase[i] = seed;
+				t.phase2[i] = seed * 1.5f;
+				t.size[i] = (18.0f + sinf(seed * 3.14f) * 12.0f) * intensity;
 			}
-			
-			// Bottom-right corner (triangle strip)
-			for (int i = 0; i < segments; i++) {
-				float angle1 = 0.0f + (float)i / (float)segments * (float)M_PI / 2.0f;
-				float angle2 = 0.0f + (float)(i + 1) / (float)segments * (float)M_PI / 2.0f;
-				
-				gs_render_start(true);
-				gs_vertex2f(width - radius, height - radius); // Center
-				gs_vertex2f(width - radius + radius * cosf(angle1), height - radius + radius * sinf(angle1));
-				gs_vertex2f(width - radius + radius * cosf(angle2), height - radius + radius * sinf(angle2));
-				gs_render_stop(GS_TRIS);
+			for (int layer = 0; layer < 4; layer++)
+				t.layer_falloff[layer] = powf(1.0f - (float)layer / 4.0f, 2.5f);
+			break;
+		}
+		
+		case ART_SPARKLES: {
+			for (int i = 0; i < count; i++) {
+				float seed = (float)i * 23.140f;
+				t.x[i] = fmodf(sinf(seed) * 43758.5453f + width * 0.5f, width);
+				t.y[i] = fmodf(cosf(seed * 1.618f) * 43758.5453f + height * 0.5f, height);
+				t.speed[i] = 2.0f + sinf(seed) * 1.5f;
+				t.phase[i] = seed * 10.0f;
+				t.size[i] = (2.0f + sinf(seed * 7.0f) * 1.5f) * intensity;
+			}
+			for (int layer = 0; layer < 3; layer++)
+				t.layer_falloff[layer] = powf(1.0f - (float)layer / 3.0f, 2.0f);
+			break;
+		}
+		
+		case ART_GLOW_ORBS: {
+			for (int i = 0; i < count; i++) {
+				float seed = (float)i * 31.415f;
+				t.x[i] = fmodf(sinf(seed) * 43758.5453f + width * 0.5f, width);
+				t.y[i] = fmodf(cosf(seed * 2.236f) * 43758.5453f + height * 0.5f, height);
+				t.speed[i] = 0.3f + sinf(seed) * 0.2f;
+				t.phase[i] = seed;                  // Orbit
+				t.phase2[i] = seed * 5.0f;          // Pulse
+				t.size[i] = (22.0f + sinf(seed * 5.0f) * 8.0f) * intensity;
+			}
+			for (int layer = 0; layer < 6; layer++)
+				t.layer_falloff[layer] = powf(1.0f - (float)layer / 6.0f, 2.5f);
+			break;
+		}
+		
+		case ART_LIGHT_STREAKS: {
+			for (int i = 0; i < count; i++) {
+				float seed = (float)i * 19.739f;
+				t.y[i] = (height / (float)count) * (float)i + sinf(seed) * 15.0f;
+				t.speed[i] = (1.0f + sinf(seed) * 0.4f) * 25.0f;
+				t.phase[i] = seed * 100.0f;
+				t.size[i] = 90.0f + sinf(seed * 3.0f) * 50.0f;
+				t.thickness[i] = 1.8f + sinf(seed * 7.0f) * 1.2f;
+			}
+			for (int layer = 0; layer < 4; layer++)
+				t.layer_falloff[layer] = powf(1.0f - (float)layer / 4.0f, 2.0f);
+			break;
+		}
+		
+		case ART_SHIMMER: {
+			for (int i = 0; i < count; i++) {
+				float seed = (float)i * 13.579f;
+				t.y[i] = (height / (float)count) * (float)i;
+				t.frequency[i] = 0.04f + sinf(seed) * 0.02f;
+				t.amplitude[i] = 12.0f + cosf(seed * 2.0f) * 8.0f;
+				t.speed[i] = 0.4f + sinf(seed * 3.0f) * 0.25f;
+				t.phase[i] = seed;                  // Wave
+				t.phase2[i] = seed * 10.0f;         // Shimmer 1
+				t.phase3[i] = seed * 7.0f;          // Shimmer 2
+			}
+			for (int layer = 0; layer < 3; layer++)
+				t.layer_falloff[layer] = powf(1.0f - (float)layer / 3.0f, 1.5f);
+			break;
+		}
+		
+		case ART_ENERGY_FLOW: {
+			// Two pulses per flow line, stored flow-major
+			int num_flows = count / 2;
+			for (int i = 0; i < num_flows; i++) {
+				float seed = (float)i * 27.183f;
+				float lane_y = (height / (float)num_flows) * (float)i + sinf(seed) * 8.0f;
+				for (int p = 0; p < 2; p++) {
+					int e = i * 2 + p;
+					float pulse_seed = seed + (float)p * 100.0f;
+					t.y[e] = lane_y;
+					t.phase[e] = seed;              // Wave
+					t.phase2[e] = pulse_seed * 200.0f;
+					t.speed[e] = (0.8f + sinf(pulse_seed) * 0.4f) * 35.0f;
+					t.size[e] = 70.0f + sinf(pulse_seed * 2.0f) * 25.0f;
+				}
 			}
+			break;
 		}
+		
+		default:
+			break;
+	}
+}
+
+// Technique in art-procedural.effect for each effect
+static const char *art_shader_technique(BackgroundArtEffect effect)
+{
+	switch (effect) {
+		case ART_PARTICLES:     return "Particles";
+		case ART_LIGHT_RAYS:    return "LightRays";
+		case ART_BOKEH:         return "Bokeh";
+		case ART_SPARKLES:      return "Sparkles";
+		case ART_GLOW_ORBS:     return "GlowOrbs";
+		case ART_LIGHT_STREAKS: return "LightStreaks";
+		case ART_SHIMMER:       return "Shimmer";
+		case ART_ENERGY_FLOW:   return "EnergyFlow";
+		default:                return "";
 	}
-	
-	gs_matrix_pop();
 }
 
 // Draw background pattern with live animation effects
@@ -2622,6 +3239,24 @@ void lowerthirds_source::draw_art_effect(float x, float y, float width, float he
 	if (opacity < 0.001f || width <= 0.0f || height <= 0.0f || effect == ART_NONE)
 		return;
 	
+	// No-op unless auto-scale changed the bar height since update()
+	update_art_table(effect, intensity, width, height);
+	const art_element_table &t = art_table;
+	
+	// Per-pixel shader: one quad for the whole layer. The geometry below
+	// stays the reference look and the fallback if the shader cannot load.
+	if (art_use_shader && !art_uses_pool()) {
+		gs_matrix_push();
+		gs_matrix_translate3f(x, y, 0.0f);
+		bool drawn = art_gpu.draw(art_shader_technique(effect), width, height,
+			color, opacity, intensity, animation_offset, t.count);
+		gs_matrix_pop();
+		if (drawn)
+			return;
+	}
+	const art_quality &q = art_gov.quality();
+	const int stride = q.element_stride;
+	
 	// Convert color to vec4 (ABGR to RGBA)
 	struct vec4 art_color_vec;
 	vec4_set(&art_color_vec,
@@ -2647,79 +3282,74 @@ void lowerthirds_source::draw_art_effect(float x, float y, float width, float he
 	gs_matrix_push();
 	gs_matrix_translate3f(x, y, 0.0f);
 	
+	// Soft elements go out as one batch of atlas sprites when available;
+	// the layered geometry below is the fallback
+	if (!art_uses_pool() && draw_art_sprites(effect, art_color_vec, opacity, width, animation_offset)) {
+		gs_matrix_pop();
+		gs_blend_state_pop();
+		return;
+	}
+	
 	switch (effect) {
 		case ART_PARTICLES: {
+			if (art_uses_pool() && art_pool.capacity) {
+				draw_art_pool(effect, art_color_vec, opacity);
+				break;
+			}
+			
 			// Floating particle system with smooth radial gradient falloff
-			int num_particles = (int)(60 * intensity);
-			float base_particle_size = 4.0f * intensity;
+			// All layers of all particles go out in one draw with per-vertex color
+			// (additive blending makes the draw order irrelevant)
+			const int layers = art_quality_layers(q, 5);
+			art_batch.begin((size_t)(t.count / stride + 1) * layers * 8 * 3);
 			
-			for (int i = 0; i < num_particles; i++) {
-				// Create pseudo-random but deterministic particle positions
-				float seed = (float)i * 12.9898f;
-				float px = fmodf(sinf(seed) * 43758.5453f, width);
-				float py = fmodf(cosf(seed * 1.414f) * 43758.5453f, height);
-				
-				// Smooth floating animation with ease curves
-				float speed = 0.3f + fmodf(sinf(seed * 2.718f), 0.4f);
-				float drift_phase = animation_offset * 0.3f + seed;
-				float drift = sinf(drift_phase) * 25.0f * cosf(drift_phase * 0.7f);
-				py = fmodf(py - animation_offset * speed * 8.0f + height, height);
-				px = px + drift;
-				
-				// Smooth pulsating with sine easing
-				float pulse_phase = animation_offset * 1.5f + seed * 3.14159f;
-				float pulse = (sinf(pulse_phase) * 0.4f + 0.6f);
-				
-				// Varying particle sizes for depth
-				float size_variation = 0.7f + sinf(seed * 7.0f) * 0.5f;
-				float particle_size = base_particle_size * size_variation;
+			// Floating drift, wrap-around and pulse for all particles at once
+			art_kernel_input in = {t.count, t.x, t.y, t.speed, t.phase, t.phase2, animation_offset, height};
+			art_kernel_output out = {t.sim_x, t.sim_y, t.sim_alpha};
+			art_kernel_particles(&in, opacity, &out);
+			
+			for (int i = 0; i < t.count; i += stride) {
+				float px = t.sim_x[i];
+				float py = t.sim_y[i];
 				
 				// Multi-layer radial gradient for smooth glow
-				while (gs_effect_loop(solid, "Solid")) {
-					for (int layer = 0; layer < 5; layer++) {
-						float layer_size = particle_size * (1.0f + layer * 0.6f);
-						float layer_alpha = pulse * opacity * powf(1.0f - (float)layer / 5.0f, 2.0f);
-						
-						struct vec4 particle_color = art_color_vec;
-						particle_color.w = layer_alpha * 0.25f; // Softer overall
-						gs_effect_set_vec4(color_param, &particle_color);
-						
-						// Draw as circle approximation with more segments for smoothness
-						gs_render_start(true);
-						int segments = 8;
-						for (int s = 0; s <= segments; s++) {
-							float angle = ((float)s / (float)segments) * 2.0f * (float)M_PI;
-							float cx = px + cosf(angle) * layer_size;
-							float cy = py + sinf(angle) * layer_size;
-							gs_vertex2f(px, py);
-							gs_vertex2f(cx, cy);
-						}
-						gs_render_stop(GS_TRISTRIP);
-					}
+				for (int layer = 0; layer < layers; layer++) {
+					float layer_size = t.size[i] * (1.0f + layer * 0.6f);
+					float layer_alpha = t.sim_alpha[i] * t.layer_falloff[layer];
+					
+					struct vec4 particle_color = art_color_vec;
+					particle_color.w = layer_alpha * 0.25f; // Softer overall
+					
+					// Circle approximation sized to the on-screen radius
+					int segments = art_circle_segments(layer_size * scale_factor, t.layer_falloff[layer], q);
+					art_batch.add_fan(px, py, layer_size, segments, vec4_to_rgba(&particle_color));
 				}
 			}
+			
+			art_batch.draw();
 			break;
 		}
 		
 		case ART_LIGHT_RAYS: {
 			// Diagonal light rays with smooth gradient falloff
-			int num_rays = (int)(10 * intensity);
 			float base_ray_width = 35.0f * intensity;
 			
-			for (int i = 0; i < num_rays; i++) {
-				// Distribute rays evenly across angle range
-				float angle = ((float)i / (float)num_rays) * (float)M_PI * 0.6f - (float)M_PI * 0.1f;
-				
-				// Smooth, slower animation
-				float offset = fmodf(animation_offset * 15.0f, 250.0f);
-				float start_dist = -250.0f + offset + i * 70.0f;
-				
-				// Calculate ray direction
-				float dx = cosf(angle + (float)M_PI * 0.25f);
-				float dy = sinf(angle + (float)M_PI * 0.25f);
+			// Smooth, slower animation
+			float offset = fmodf(animation_offset * 15.0f, 250.0f);
+			
+			// Ray edges are straight (the taper is linear), so segments only
+			// carry the stepped fade: as many as keep each step under the
+			// error budget, steepest at the start where (1 - t)^1.5 has slope 1.5
+			const int edges = art_quality_layers(q, 2);
+			const float outer_mult = 1.0f + edges * 0.7f;
+			const int num_segments = art_fade_segments(opacity * 0.2f / (float)(edges + 1), 1.5f, q, 8);
+			
+			for (int i = 0; i < t.count; i += stride) {
+				float start_dist = t.phase[i] + offset;
+				float dx = t.x[i];
+				float dy = t.y[i];
 				
 				// Ray fades smoothly along its length with exponential falloff
-				int num_segments = 8;
 				for (int seg = 0; seg < num_segments; seg++) {
 					float t1 = (float)seg / (float)num_segments;
 					float t2 = (float)(seg + 1) / (float)num_segments;
@@ -2727,41 +3357,23 @@ void lowerthirds_source::draw_art_effect(float x, float y, float width, float he
 					float dist1 = start_dist + t1 * 400.0f;
 					float dist2 = start_dist + t2 * 400.0f;
 					
-					// Exponential fade for smoother appearance
-					float alpha1 = opacity * 0.2f * powf(1.0f - t1, 1.5f);
-					float alpha2 = opacity * 0.2f * powf(1.0f - t2, 1.5f);
-					
 					// Ray width also tapers for more natural look
-					float width1 = base_ray_width * (1.0f - t1 * 0.3f);
-					float width2 = base_ray_width * (1.0f - t2 * 0.3f);
+					float width1 = base_ray_width * (1.0f - t1 * 0.3f) * outer_mult;
+					float width2 = base_ray_width * (1.0f - t2 * 0.3f) * outer_mult;
+					
+					// Core line to outer glow edge in one quad: the inner glow
+					// edges are collinear with it and the strip draws with a
+					// single alpha (the outer edge's, at the segment end)
+					struct vec4 ray_color = art_color_vec;
+					ray_color.w = opacity * 0.2f * art_ray_falloff(t2) / (float)(edges + 1);
 					
-					// Draw ray with soft edges (center bright, edges fade)
 					while (gs_effect_loop(solid, "Solid")) {
-						// Center core of ray
-						struct vec4 ray_color_center = art_color_vec;
-						ray_color_center.w = alpha1 * 1.5f;
-						gs_effect_set_vec4(color_param, &ray_color_center);
-						
+						gs_effect_set_vec4(color_param, &ray_color);
 						gs_render_start(true);
 						gs_vertex2f(dist1 * dx, dist1 * dy);
 						gs_vertex2f(dist2 * dx, dist2 * dy);
-						
-						// Soft outer glow layers
-						for (int edge = 0; edge < 2; edge++) {
-							float edge_mult = 1.0f + (edge + 1) * 0.7f;
-							float edge_alpha1 = alpha1 / (edge + 2);
-							float edge_alpha2 = alpha2 / (edge + 2);
-							
-							struct vec4 edge_color1 = art_color_vec;
-							struct vec4 edge_color2 = art_color_vec;
-							edge_color1.w = edge_alpha1;
-							edge_color2.w = edge_alpha2;
-							
-							gs_effect_set_vec4(color_param, &edge_color1);
-							gs_vertex2f(dist1 * dx - width1 * edge_mult * dy, dist1 * dy + width1 * edge_mult * dx);
-							gs_effect_set_vec4(color_param, &edge_color2);
-							gs_vertex2f(dist2 * dx - width2 * edge_mult * dy, dist2 * dy + width2 * edge_mult * dx);
-						}
+						gs_vertex2f(dist1 * dx - width1 * dy, dist1 * dy + width1 * dx);
+						gs_vertex2f(dist2 * dx - width2 * dy, dist2 * dy + width2 * dx);
 						gs_render_stop(GS_TRISTRIP);
 					}
 				}
@@ -2771,46 +3383,36 @@ void lowerthirds_source::draw_art_effect(float x, float y, float width, float he
 		
 		case ART_BOKEH: {
 			// Bokeh blur circles with soft radial gradient
-			int num_bokeh = (int)(20 * intensity);
+			// Very slow, smooth drift and gentle pulsating for all circles at once
+			art_kernel_input in = {t.count, t.x, t.y, t.speed, t.phase, t.phase2, animation_offset, height};
+			art_kernel_output out = {t.sim_x, t.sim_y, t.sim_alpha};
+			art_kernel_bokeh(&in, opacity * 0.15f, &out);
+			const int layers = art_quality_layers(q, 4);
 			
-			for (int i = 0; i < num_bokeh; i++) {
-				// Pseudo-random positions
-				float seed = (float)i * 17.951f;
-				float px = fmodf(sinf(seed) * 43758.5453f + width * 0.5f, width);
-				float py = fmodf(cosf(seed * 1.732f) * 43758.5453f + height * 0.5f, height);
-				
-				// Very slow, smooth drift animation
-				float drift_phase_x = animation_offset * 0.2f + seed;
-				float drift_phase_y = animation_offset * 0.15f + seed * 1.5f;
-				px += sinf(drift_phase_x) * 35.0f * cosf(drift_phase_x * 0.5f);
-				py += cosf(drift_phase_y) * 25.0f * sinf(drift_phase_y * 0.7f);
+			for (int i = 0; i < t.count; i += stride) {
+				float px = t.sim_x[i];
+				float py = t.sim_y[i];
 				
 				// Varying sizes for depth perception
-				float base_size = (18.0f + sinf(seed * 3.14f) * 12.0f) * intensity;
-				
-				// Gentle pulsating with smooth sine
-				float pulse_phase = animation_offset * 0.8f + seed;
-				float pulse = (sinf(pulse_phase) * 0.25f + 0.75f);
+				float base_size = t.size[i];
 				
 				// Multi-layer soft bokeh with radial gradient
 				while (gs_effect_loop(solid, "Solid")) {
-					for (int layer = 0; layer < 4; layer++) {
+					for (int layer = 0; layer < layers; layer++) {
 						float layer_size = base_size * (1.0f + layer * 0.5f);
-						float layer_alpha = pulse * opacity * 0.15f * powf(1.0f - (float)layer / 4.0f, 2.5f);
+						float layer_alpha = t.sim_alpha[i] * t.layer_falloff[layer];
 						
 						struct vec4 bokeh_color = art_color_vec;
 						bokeh_color.w = layer_alpha;
 						gs_effect_set_vec4(color_param, &bokeh_color);
 						
-						// Draw smooth circle with more segments
+						// Draw smooth circle sized to the on-screen radius
 						gs_render_start(true);
-						int segments = 12;
+						int segments = art_circle_segments(layer_size * scale_factor, t.layer_falloff[layer], q);
+						const struct vec2 *rim = unit_circle_table(segments);
 						for (int j = 0; j <= segments; j++) {
-							float angle = ((float)j / (float)segments) * 2.0f * (float)M_PI;
-							float cx = px + cosf(angle) * layer_size;
-							float cy = py + sinf(angle) * layer_size;
 							gs_vertex2f(px, py);
-							gs_vertex2f(cx, cy);
+							gs_vertex2f(px + rim[j].x * layer_size, py + rim[j].y * layer_size);
 						}
 						gs_render_stop(GS_TRISTRIP);
 					}
@@ -2820,34 +3422,31 @@ void lowerthirds_source::draw_art_effect(float x, float y, float width, float he
 		}
 		
 		case ART_SPARKLES: {
-			// Sparkling stars with smooth twinkling and soft glow
-			int num_sparkles = (int)(50 * intensity);
+			if (art_uses_pool() && art_pool.capacity) {
+				draw_art_pool(effect, art_color_vec, opacity);
+				break;
+			}
 			
-			for (int i = 0; i < num_sparkles; i++) {
-				// Fixed sparkle positions
-				float seed = (float)i * 23.140f;
-				float px = fmodf(sinf(seed) * 43758.5453f + width * 0.5f, width);
-				float py = fmodf(cosf(seed * 1.618f) * 43758.5453f + height * 0.5f, height);
+			// Sparkling stars with smooth twinkling and soft glow
+			const int layers = art_quality_layers(q, 3);
+			for (int i = 0; i < t.count; i += stride) {
+				float px = t.x[i];
+				float py = t.y[i];
 				
 				// Smooth twinkling with varied timing
-				float twinkle_speed = 2.0f + sinf(seed) * 1.5f;
-				float twinkle_phase = animation_offset * twinkle_speed + seed * 10.0f;
-				float twinkle_raw = sinf(twinkle_phase) * 0.5f + 0.5f;
-				// Smooth curve for elegant twinkling
-				float twinkle = powf(twinkle_raw, 3.0f);
+				float twinkle = art_twinkle(animation_offset * t.speed[i] + t.phase[i]);
 				
 				float alpha = twinkle * opacity * 0.6f;
 				
 				if (alpha > 0.05f) {
 					// Varying sparkle sizes
-					float base_size = (2.0f + sinf(seed * 7.0f) * 1.5f) * intensity;
-					float size = base_size * (0.5f + twinkle * 0.5f);
+					float size = t.size[i] * (0.5f + twinkle * 0.5f);
 					
 					// Draw star with soft glow layers
 					while (gs_effect_loop(solid, "Solid")) {
-						for (int layer = 0; layer < 3; layer++) {
+						for (int layer = 0; layer < layers; layer++) {
 							float layer_mult = 1.0f + layer * 0.8f;
-							float layer_alpha = alpha * powf(1.0f - (float)layer / 3.0f, 2.0f);
+							float layer_alpha = alpha * t.layer_falloff[layer];
 							
 							struct vec4 sparkle_color = art_color_vec;
 							sparkle_color.w = layer_alpha * 0.4f;
@@ -2894,46 +3493,35 @@ void lowerthirds_source::draw_art_effect(float x, float y, float width, float he
 		
 		case ART_GLOW_ORBS: {
 			// Glowing orbs with smooth radial gradient and gentle motion
-			int num_orbs = (int)(12 * intensity);
+			// Figure-eight floating and pulsating for all orbs at once
+			art_kernel_input in = {t.count, t.x, t.y, t.speed, t.phase, t.phase2, animation_offset, height};
+			art_kernel_output out = {t.sim_x, t.sim_y, t.sim_alpha};
+			art_kernel_glow_orbs(&in, opacity * 0.12f, &out);
+			const int layers = art_quality_layers(q, 6);
 			
-			for (int i = 0; i < num_orbs; i++) {
-				// Pseudo-random positions
-				float seed = (float)i * 31.415f;
-				float base_px = fmodf(sinf(seed) * 43758.5453f + width * 0.5f, width);
-				float base_py = fmodf(cosf(seed * 2.236f) * 43758.5453f + height * 0.5f, height);
-				
-				// Smooth floating animation with figure-eight pattern
-				float orbit_radius = 35.0f;
-				float orbit_speed = 0.3f + sinf(seed) * 0.2f;
-				float phase = animation_offset * orbit_speed + seed;
-				float px = base_px + cosf(phase) * orbit_radius + sinf(phase * 2.0f) * 15.0f;
-				float py = base_py + sinf(phase * 1.3f) * orbit_radius * 0.8f;
-				
-				// Smooth pulsating with sine easing
-				float pulse_phase = animation_offset * 1.0f + seed * 5.0f;
-				float pulse = (sinf(pulse_phase) * 0.2f + 0.8f);
+			for (int i = 0; i < t.count; i += stride) {
+				float px = t.sim_x[i];
+				float py = t.sim_y[i];
 				
 				// Varying orb sizes
-				float base_size = (22.0f + sinf(seed * 5.0f) * 8.0f) * intensity;
+				float base_size = t.size[i];
 				
 				// Multi-layer soft glow with exponential falloff
 				while (gs_effect_loop(solid, "Solid")) {
-					for (int layer = 0; layer < 6; layer++) {
+					for (int layer = 0; layer < layers; layer++) {
 						float layer_size = base_size * (1.0f + layer * 0.5f);
-						float layer_opacity = opacity * pulse * 0.12f * powf(1.0f - (float)layer / 6.0f, 2.5f);
+						float layer_opacity = t.sim_alpha[i] * t.layer_falloff[layer];
 						
 						struct vec4 orb_color = art_color_vec;
 						orb_color.w = layer_opacity;
 						gs_effect_set_vec4(color_param, &orb_color);
 						
 						gs_render_start(true);
-						int segments = 16;
+						int segments = art_circle_segments(layer_size * scale_factor, t.layer_falloff[layer], q);
+						const struct vec2 *rim = unit_circle_table(segments);
 						for (int j = 0; j <= segments; j++) {
-							float angle = ((float)j / (float)segments) * 2.0f * (float)M_PI;
-							float cx = px + cosf(angle) * layer_size;
-							float cy = py + sinf(angle) * layer_size;
 							gs_vertex2f(px, py);
-							gs_vertex2f(cx, cy);
+							gs_vertex2f(px + rim[j].x * layer_size, py + rim[j].y * layer_size);
 						}
 						gs_render_stop(GS_TRISTRIP);
 					}
@@ -2944,37 +3532,24 @@ void lowerthirds_source::draw_art_effect(float x, float y, float width, float he
 		
 		case ART_LIGHT_STREAKS: {
 			// Smooth horizontal light streaks with soft gradients
-			int num_streaks = (int)(8 * intensity);
-			
-			for (int i = 0; i < num_streaks; i++) {
-				// Staggered vertical positions
-				float seed = (float)i * 19.739f;
-				float py = (height / (float)num_streaks) * (float)i + sinf(seed) * 15.0f;
+			const int layers = art_quality_layers(q, 4);
+			for (int i = 0; i < t.count; i += stride) {
+				float py = t.y[i];
 				
 				// Smooth animation with ease
-				float speed = 1.0f + sinf(seed) * 0.4f;
-				float streak_pos = fmodf(animation_offset * speed * 25.0f + seed * 100.0f, width + 250.0f) - 125.0f;
+				float streak_pos = art_streak_pos(t, i, animation_offset, width);
 				
 				// Streak dimensions with variation
-				float streak_length = 90.0f + sinf(seed * 3.0f) * 50.0f;
-				float streak_height = 1.8f + sinf(seed * 7.0f) * 1.2f;
-				
-				// Smooth fade in/out at edges with smooth curve
-				float streak_alpha = opacity * 0.5f;
-				float fade_distance = 120.0f;
-				if (streak_pos < 0.0f) {
-					streak_alpha *= powf((fade_distance + streak_pos) / fade_distance, 2.0f);
-				} else if (streak_pos > width - streak_length) {
-					float over = streak_pos - (width - streak_length);
-					streak_alpha *= powf(1.0f - over / fade_distance, 2.0f);
-				}
+				float streak_length = t.size[i];
+				float streak_height = t.thickness[i];
+				float streak_alpha = art_streak_alpha(streak_pos, streak_length, width, opacity);
 				
 				if (streak_alpha > 0.03f) {
 					// Multi-layer gradient for ultra-smooth appearance
 					while (gs_effect_loop(solid, "Solid")) {
-						for (int layer = 0; layer < 4; layer++) {
+						for (int layer = 0; layer < layers; layer++) {
 							float layer_height = streak_height * (1.0f + layer * 0.8f);
-							float layer_alpha = streak_alpha * powf(1.0f - (float)layer / 4.0f, 2.0f);
+							float layer_alpha = streak_alpha * t.layer_falloff[layer];
 							
 							struct vec4 streak_color = art_color_vec;
 							streak_color.w = layer_alpha;
@@ -3009,40 +3584,50 @@ void lowerthirds_source::draw_art_effect(float x, float y, float width, float he
 		
 		case ART_SHIMMER: {
 			// Smooth shimmering effect like light on water surface
-			int num_waves = (int)(15 * intensity);
-			
-			for (int i = 0; i < num_waves; i++) {
-				float seed = (float)i * 13.579f;
-				float base_y = (height / (float)num_waves) * (float)i;
+			const int layers = art_quality_layers(q, 3);
+			// Strips end on the last 6 px column before the bar edge; each strip
+			// is drawn with the alpha of that column
+			const float end_x = (ceilf(width / 6.0f) - 1.0f) * 6.0f;
+			const int max_segments = (int)(end_x / 6.0f);
+			for (int i = 0; i < t.count; i += stride) {
+				float base_y = t.y[i];
 				
 				// Smooth wave parameters
-				float wave_frequency = 0.04f + sinf(seed) * 0.02f;
-				float wave_amplitude = 12.0f + cosf(seed * 2.0f) * 8.0f;
-				float wave_speed = 0.4f + sinf(seed * 3.0f) * 0.25f;
+				float wave_frequency = t.frequency[i];
+				float wave_amplitude = t.amplitude[i];
+				float wave_offset = animation_offset * t.speed[i] + t.phase[i];
+				float shimmer_offset1 = animation_offset * 1.5f + t.phase2[i];
+				float shimmer_offset2 = -animation_offset * 1.0f + t.phase3[i];
+				float end_shimmer = (sinf(end_x * 0.08f + shimmer_offset1) + sinf(end_x * 0.05f + shimmer_offset2)) * 0.25f + 0.5f;
 				
 				// Multi-layer shimmer for depth
 				while (gs_effect_loop(solid, "Solid")) {
-					for (int layer = 0; layer < 3; layer++) {
+					for (int layer = 0; layer < layers; layer++) {
 						float layer_mult = 1.0f + layer * 0.3f;
 						
+						struct vec4 shimmer_color = art_color_vec;
+						shimmer_color.w = opacity * 0.35f * t.layer_falloff[layer] * end_shimmer;
+						gs_effect_set_vec4(color_param, &shimmer_color);
+						
+						// Edges are the wave (amplitude * f^2 curvature) plus or
+						// minus the thickness, whose two shimmer sines add
+						// 2.5 * 0.25 * (0.08^2 + 0.05^2) at most
+						float curvature = (wave_amplitude * wave_frequency * wave_frequency + 0.0055625f) * layer_mult;
+						int segments = art_curve_segments(end_x, curvature, scale_factor, q, 4, max_segments);
+						float step = end_x / (float)segments;
+						
 						gs_render_start(true);
-						for (float px = 0; px < width; px += 6.0f) {
-							float wave_phase = px * wave_frequency + animation_offset * wave_speed + seed;
+						for (int k = 0; k <= segments; k++) {
+							float px = (float)k * step;
+							float wave_phase = px * wave_frequency + wave_offset;
 							float py = base_y + wave_amplitude * sinf(wave_phase) * layer_mult;
 							
 							// Smooth intensity variation with double sine for complexity
-							float shimmer_phase1 = px * 0.08f + animation_offset * 1.5f + seed * 10.0f;
-							float shimmer_phase2 = px * 0.05f - animation_offset * 1.0f + seed * 7.0f;
+							float shimmer_phase1 = px * 0.08f + shimmer_offset1;
+							float shimmer_phase2 = px * 0.05f + shimmer_offset2;
 							float shimmer_raw = (sinf(shimmer_phase1) + sinf(shimmer_phase2)) * 0.5f;
 							float shimmer_intensity = shimmer_raw * 0.5f + 0.5f;
 							
-							// Smooth alpha with layer falloff
-							float layer_alpha = opacity * shimmer_intensity * 0.35f * powf(1.0f - (float)layer / 3.0f, 1.5f);
-							
-							struct vec4 shimmer_color = art_color_vec;
-							shimmer_color.w = layer_alpha;
-							gs_effect_set_vec4(color_param, &shimmer_color);
-							
 							// Variable thickness based on intensity
 							float thickness = (1.5f + shimmer_intensity * 2.5f) * layer_mult;
 							
@@ -3058,68 +3643,62 @@ void lowerthirds_source::draw_art_effect(float x, float y, float width, float he
 		
 		case ART_ENERGY_FLOW: {
 			// Smooth flowing energy with pulsing gradients
-			int num_flows = (int)(6 * intensity);
+			float base_thickness = 2.5f * intensity;
+			const int layers = art_quality_layers(q, 3);
+			// The centerline wave 6 * sin(0.08 x) bends by at most 6 * 0.08^2
+			const float wave_curvature = 6.0f * 0.08f * 0.08f;
 			
-			for (int i = 0; i < num_flows; i++) {
-				float seed = (float)i * 27.183f;
-				float lane_y = (height / (float)num_flows) * (float)i + sinf(seed) * 8.0f;
+			// Energy pulses traveling along flow lines
+			for (int e = 0; e < t.count; e += stride) {
+				float lane_y = t.y[e];
+				float pulse_pos = fmodf(animation_offset * t.speed[e] + t.phase2[e], width + 180.0f) - 90.0f;
+				float pulse_length = t.size[e];
+				float wave_offset = animation_offset * 0.7f + t.phase[e];
 				
-				// Energy pulses traveling along flow lines
-				int num_pulses = 2;
-				for (int p = 0; p < num_pulses; p++) {
-					float pulse_seed = seed + (float)p * 100.0f;
-					float pulse_speed = 0.8f + sinf(pulse_seed) * 0.4f;
-					float pulse_pos = fmodf(animation_offset * pulse_speed * 35.0f + pulse_seed * 200.0f, width + 180.0f) - 90.0f;
+				// Draw smooth gradient pulse with multiple layers
+				// Segment ends are shared, so each wave sample is evaluated once
+				float wave_offset1 = sinf(pulse_pos * 0.08f + wave_offset) * 6.0f;
+				int num_segments = art_curve_segments(pulse_length, wave_curvature, scale_factor, q, 4, 16);
+				for (int seg = 0; seg < num_segments; seg++) {
+					float t1 = (float)seg / (float)num_segments;
+					float t2 = (float)(seg + 1) / (float)num_segments;
 					
-					// Pulse dimensions
-					float pulse_length = 70.0f + sinf(pulse_seed * 2.0f) * 25.0f;
-					float base_thickness = 2.5f * intensity;
+					float seg_start = pulse_pos + t1 * pulse_length;
+					float seg_end = pulse_pos + t2 * pulse_length;
 					
-					// Draw smooth gradient pulse with multiple layers
-					int num_segments = 8;
-					for (int seg = 0; seg < num_segments; seg++) {
-						float t1 = (float)seg / (float)num_segments;
-						float t2 = (float)(seg + 1) / (float)num_segments;
-						
-						float seg_start = pulse_pos + t1 * pulse_length;
-						float seg_end = pulse_pos + t2 * pulse_length;
-						
-						// Smooth intensity curve - peaks in the middle, fades at ends
-						float peak_pos = 0.3f; // Peak near front
-						float intensity1 = 1.0f - powf(fabsf(t1 - peak_pos) / (1.0f - peak_pos), 1.5f);
-						float intensity2 = 1.0f - powf(fabsf(t2 - peak_pos) / (1.0f - peak_pos), 1.5f);
-						
-						// Smooth sine wave perturbation
-						float wave_phase1 = seg_start * 0.08f + animation_offset * 0.7f + seed;
-						float wave_phase2 = seg_end * 0.08f + animation_offset * 0.7f + seed;
-						float wave_offset1 = sinf(wave_phase1) * 6.0f;
-						float wave_offset2 = sinf(wave_phase2) * 6.0f;
-						
-						// Multi-layer for soft glow
-						while (gs_effect_loop(solid, "Solid")) {
-							for (int layer = 0; layer < 3; layer++) {
-								float layer_mult = 1.0f + layer * 0.6f;
-								float layer_thickness = base_thickness * layer_mult;
-								
-								float alpha1 = opacity * intensity1 * 0.3f / (1.0f + layer * 0.5f);
-								float alpha2 = opacity * intensity2 * 0.3f / (1.0f + layer * 0.5f);
-								
-								struct vec4 flow_color1 = art_color_vec;
-								struct vec4 flow_color2 = art_color_vec;
-								flow_color1.w = alpha1;
-								flow_color2.w = alpha2;
-								
-								gs_render_start(true);
-								gs_effect_set_vec4(color_param, &flow_color1);
-								gs_vertex2f(seg_start, lane_y + wave_offset1 - layer_thickness);
-								gs_vertex2f(seg_start, lane_y + wave_offset1 + layer_thickness);
-								gs_effect_set_vec4(color_param, &flow_color2);
-								gs_vertex2f(seg_end, lane_y + wave_offset2 - layer_thickness);
-								gs_vertex2f(seg_end, lane_y + wave_offset2 + layer_thickness);
-								gs_render_stop(GS_TRISTRIP);
-							}
+					// Smooth intensity curve - peaks in the middle, fades at ends
+					float intensity1 = art_pulse_falloff(t1);
+					float intensity2 = art_pulse_falloff(t2);
+					
+					// Smooth sine wave perturbation
+					float wave_offset2 = sinf(seg_end * 0.08f + wave_offset) * 6.0f;
+					
+					// Multi-layer for soft glow
+					while (gs_effect_loop(solid, "Solid")) {
+						for (int layer = 0; layer < layers; layer++) {
+							float layer_mult = 1.0f + layer * 0.6f;
+							float layer_thickness = base_thickness * layer_mult;
+							
+							float alpha1 = opacity * intensity1 * 0.3f / (1.0f + layer * 0.5f);
+							float alpha2 = opacity * intensity2 * 0.3f / (1.0f + layer * 0.5f);
+							
+							struct vec4 flow_color1 = art_color_vec;
+							struct vec4 flow_color2 = art_color_vec;
+							flow_color1.w = alpha1;
+							flow_color2.w = alpha2;
+							
+							gs_render_start(true);
+							gs_effect_set_vec4(color_param, &flow_color1);
+							gs_vertex2f(seg_start, lane_y + wave_offset1 - layer_thickness);
+							gs_vertex2f(seg_start, lane_y + wave_offset1 + layer_thickness);
+							gs_effect_set_vec4(color_param, &flow_color2);
+							gs_vertex2f(seg_end, lane_y + wave_offset2 - layer_thickness);
+							gs_vertex2f(seg_end, lane_y + wave_offset2 + layer_thickness);
+							gs_render_stop(GS_TRISTRIP);
 						}
 					}
+					
+					wave_offset1 = wave_offset2;
 				}
 			}
 			break;
@@ -3135,6 +3714,368 @@ void lowerthirds_source::draw_art_effect(float x, float y, float width, float he
 	gs_blend_state_pop();
 }
 
+bool lowerthirds_source::art_uses_pool() const
+{
+	return art_particle_sim && (art_effect == ART_PARTICLES || art_effect == ART_SPARKLES);
+}
+
+// Emitter for the pooled particles, sized like the classic effect
+particle_emitter lowerthirds_source::art_emitter() const
+{
+	particle_emitter e;
+	e.rate = art_emit_rate;
+	e.lifetime = art_particle_life;
+	e.velocity = art_particle_velocity;
+	e.size = (art_effect == ART_SPARKLES ? 2.0f : 4.0f) * art_intensity;
+	e.width = 1920.0f;
+	e.height = (float)bar_height_pixels * scale_factor;
+	return e;
+}
+
+// Draw the pooled particles or sparkles in one batched draw. Looks follow
+// the classic effects; alpha also fades in and out over each lifetime.
+void lowerthirds_source::draw_art_pool(BackgroundArtEffect effect, struct vec4 color, float opacity)
+{
+	const particle_pool &p = art_pool;
+	const art_element_table &t = art_table;
+	const art_quality &q = art_gov.quality();
+	const int layers = art_quality_layers(q, effect == ART_PARTICLES ? 5 : 3);
+	const bool sprites = art_sprites.load();
+	
+	// Vertex estimate: 8-segment fans per particle layer, or two beams per
+	// sparkle layer plus the center point
+	size_t per_element = effect == ART_PARTICLES ? (size_t)layers * 8 * 3 : (size_t)(layers * 2 + 1) * 6;
+	if (sprites)
+		art_sprites.begin((size_t)(p.live / q.element_stride + 1));
+	else
+		art_batch.begin((size_t)(p.live / q.element_stride + 1) * per_element);
+	
+	for (int i = 0; i < p.high; i += q.element_stride) {
+		if (p.life[i] <= 0.0f)
+			continue;
+		
+		float f = p.age[i] / p.life[i];
+		float envelope = fminf(f / 0.15f, 1.0f) * fminf((1.0f - f) / 0.3f, 1.0f);
+		float time = p.age[i] * art_speed; // Animation offset units
+		float px = p.x[i];
+		float py = p.y[i];
+		
+		if (effect == ART_PARTICLES) {
+			float pulse = sinf(time * 1.5f + p.phase[i]) * 0.4f + 0.6f;
+			float alpha = pulse * opacity * envelope;
+			if (sprites) {
+				art_sprites.add(ART_SPRITE_PARTICLE, px, py, p.size[i], color, alpha);
+				continue;
+			}
+			for (int layer = 0; layer < layers; layer++) {
+				float layer_size = p.size[i] * (1.0f + layer * 0.6f);
+				struct vec4 c = color;
+				c.w = alpha * t.layer_falloff[layer] * 0.25f;
+				int segments = art_circle_segments(layer_size * scale_factor, t.layer_falloff[layer], q);
+				art_batch.add_fan(px, py, layer_size, segments, vec4_to_rgba(&c));
+			}
+		} else {
+			float twinkle = art_twinkle(time * 2.0f + p.phase[i]);
+			float alpha = twinkle * opacity * 0.6f * envelope;
+			if (alpha <= 0.05f)
+				continue;
+			
+			float size = p.size[i] * (0.5f + twinkle * 0.5f);
+			if (sprites) {
+				art_sprites.add(ART_SPRITE_STAR, px, py, size, color, alpha);
+				continue;
+			}
+			for (int layer = 0; layer < layers; layer++) {
+				float layer_mult = 1.0f + layer * 0.8f;
+				float cross_length = size * 3.0f * layer_mult;
+				float cross_width = size * 0.4f * layer_mult;
+				struct vec4 c = color;
+				c.w = alpha * t.layer_falloff[layer] * 0.4f;
+				uint32_t rgba = vec4_to_rgba(&c);
+				art_batch.add_rect(px - cross_length, py - cross_width, px + cross_length, py + cross_width, rgba);
+				art_batch.add_rect(px - cross_width, py - cross_length, px + cross_width, py + cross_length, rgba);
+				
+				if (layer == 0) {
+					float point_size = size * 1.5f;
+					c.w = alpha * 0.8f;
+					art_batch.add_rect(px - point_size, py - point_size, px + point_size, py + point_size,
+						vec4_to_rgba(&c));
+				}
+			}
+		}
+	}
+	
+	if (sprites)
+		art_sprites.draw();
+	else
+		art_batch.draw();
+}
+
+// Particles, bokeh, sparkles, glow orbs and light streaks as one sprite per
+// element (see sprite-batch.hpp). Returns false, having drawn nothing, for
+// the other effects or when the sprite batch is unavailable.
+bool lowerthirds_source::draw_art_sprites(BackgroundArtEffect effect, struct vec4 color, float opacity,
+	float width, float animation_offset)
+{
+	if (effect != ART_PARTICLES && effect != ART_BOKEH && effect != ART_SPARKLES &&
+		effect != ART_GLOW_ORBS && effect != ART_LIGHT_STREAKS)
+		return false;
+	if (!art_sprites.load())
+		return false;
+	
+	const art_element_table &t = art_table;
+	const int stride = art_gov.quality().element_stride;
+	art_kernel_input in = {t.count, t.x, t.y, t.speed, t.phase, t.phase2, animation_offset, t.height};
+	art_kernel_output out = {t.sim_x, t.sim_y, t.sim_alpha};
+	art_sprites.begin((size_t)(t.count / stride + 1));
+	
+	switch (effect) {
+		case ART_PARTICLES:
+		case ART_BOKEH:
+		case ART_GLOW_ORBS: {
+			art_sprite_shape shape = ART_SPRITE_PARTICLE;
+			if (effect == ART_PARTICLES) {
+				art_kernel_particles(&in, opacity, &out);
+			} else if (effect == ART_BOKEH) {
+				art_kernel_bokeh(&in, opacity * 0.15f, &out);
+				shape = ART_SPRITE_BOKEH;
+			} else {
+				art_kernel_glow_orbs(&in, opacity * 0.12f, &out);
+				shape = ART_SPRITE_ORB;
+			}
+			for (int i = 0; i < t.count; i += stride)
+				art_sprites.add(shape, t.sim_x[i], t.sim_y[i], t.size[i], color, t.sim_alpha[i]);
+			break;
+		}
+		
+		case ART_SPARKLES:
+			for (int i = 0; i < t.count; i += stride) {
+				float twinkle = art_twinkle(animation_offset * t.speed[i] + t.phase[i]);
+				float alpha = twinkle * opacity * 0.6f;
+				if (alpha > 0.05f)
+					art_sprites.add(ART_SPRITE_STAR, t.x[i], t.y[i], t.size[i] * (0.5f + twinkle * 0.5f),
+						color, alpha);
+			}
+			break;
+		
+		case ART_LIGHT_STREAKS:
+			for (int i = 0; i < t.count; i += stride) {
+				float streak_pos = art_streak_pos(t, i, animation_offset, width);
+				float streak_alpha = art_streak_alpha(streak_pos, t.size[i], width, opacity);
+				if (streak_alpha > 0.03f)
+					art_sprites.add_span(ART_SPRITE_STREAK, streak_pos - 20.0f, streak_pos + t.size[i],
+						t.y[i], t.thickness[i], color, streak_alpha);
+			}
+			break;
+		
+		default:
+			break;
+	}
+	
+	art_sprites.draw();
+	return true;
+}
+
+static inline bool art_cache_key_equal(const art_cache_key &a, const art_cache_key &b)
+{
+	return a.effect == b.effect && a.color == b.color && a.opacity == b.opacity &&
+		a.intensity == b.intensity && a.width == b.width && a.height == b.height &&
+		a.animation_offset == b.animation_offset && a.scale_factor == b.scale_factor &&
+		a.quality_tier == b.quality_tier;
+}
+
+// Draw the art pattern from a render-to-texture cache: the frozen pattern
+// when art_animate is off, or the last simulation step when art_sim_rate is
+// below the canvas rate. The pattern is re-rendered only when something in
+// art_cache_key (including the step's animation offset) changes; the
+// animation alpha is applied when compositing so entrance/exit animations
+// reuse the same texture. The cache covers the source bounds (fixed width x
+// bar height), so art that the live path would spill past the bar is clipped
+// like it already is whenever OBS renders the source through a filter.
+void lowerthirds_source::draw_art_cached(float width, float height, float alpha, float animation_offset)
+{
+	float opacity = art_opacity / 100.0f;
+	if (opacity * alpha < 0.001f || width <= 0.0f || height <= 0.0f)
+		return;
+	
+	uint32_t cx = (uint32_t)ceilf(width);
+	uint32_t cy = (uint32_t)ceilf(height);
+	
+	art_cache_key key;
+	key.effect = art_effect;
+	key.color = art_color;
+	key.opacity = art_opacity;
+	key.intensity = art_intensity;
+	key.width = width;
+	key.height = height;
+	key.animation_offset = animation_offset;
+	key.scale_factor = scale_factor;
+	key.quality_tier = art_gov.enabled ? art_gov.tier : ART_QUALITY_FULL;
+	
+	if (!art_cache)
+		art_cache = gs_texrender_create(GS_RGBA16F, GS_ZS_NONE);
+	
+	if (art_cache && (!art_cache_valid || !art_cache_key_equal(key, art_cache_state))) {
+		art_cache_valid = false;
+		gs_texrender_reset(art_cache);
+		if (gs_texrender_begin(art_cache, cx, cy)) {
+			struct vec4 clear_color;
+			vec4_zero(&clear_color);
+			gs_clear(GS_CLEAR_COLOR, &clear_color, 0.0f, 0);
+			gs_ortho(0.0f, (float)cx, 0.0f, (float)cy, -100.0f, 100.0f);
+			
+			// Additive art into a cleared target leaves the premultiplied sum
+			// in RGB and alpha at zero, ready to be added to the bar
+			draw_art_effect(0.0f, 0.0f, width, height, art_effect, art_color,
+				opacity, art_intensity, animation_offset);
+			
+			gs_texrender_end(art_cache);
+			art_cache_state = key;
+			art_cache_valid = true;
+		}
+	}
+	
+	if (!art_cache_valid) {
+		// Render target unavailable - fall back to drawing live
+		draw_art_effect(0.0f, 0.0f, width, height, art_effect, art_color,
+			opacity * alpha, art_intensity, animation_offset);
+		return;
+	}
+	
+	gs_texture_t *texture = gs_texrender_get_texture(art_cache);
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), texture);
+	gs_effect_set_float(gs_effect_get_param_by_name(effect, "multiplier"), alpha);
+	
+	// Same additive blend as the live path, with the alpha already in RGB
+	gs_blend_state_push();
+	gs_enable_color(true, true, true, true);
+	gs_enable_blending(true);
+	gs_blend_function_separate(
+		GS_BLEND_ONE, GS_BLEND_ONE,       // RGB: additive
+		GS_BLEND_ZERO, GS_BLEND_ONE       // Alpha: preserve
+	);
+	
+	while (gs_effect_loop(effect, "DrawMultiply"))
+		gs_draw_sprite(texture, 0, cx, cy);
+	
+	gs_blend_state_pop();
+}
+
+// Loop length of the effects that can be baked, in animation offset units,
+// or 0. Only light rays repeat exactly; shimmer and glow orbs mix per-element
+// speeds that never line up, so they keep drawing live.
+static float art_loop_period(BackgroundArtEffect effect)
+{
+	return effect == ART_LIGHT_RAYS ? 250.0f / 15.0f : 0.0f;
+}
+
+// Draw the art effect from the baked loop atlas, baking (or loading it from
+// the disk cache) first once changed parameters have settled. Returns false
+// if the effect does not loop, the parameters are still moving or the atlas
+// is unavailable, so the caller can draw live instead.
+bool lowerthirds_source::draw_art_baked(float width, float height, float alpha)
+{
+	float period = art_loop_period(art_effect);
+	if (period <= 0.0f)
+		return false;
+	
+	float opacity = art_opacity / 100.0f;
+	if (opacity * alpha < 0.001f || width <= 0.0f || height <= 0.0f)
+		return true;
+	
+	art_loop_key key;
+	memset(&key, 0, sizeof(key));
+	key.effect = (int)art_effect;
+	key.color = art_color;
+	key.opacity = art_opacity;
+	key.intensity = art_intensity;
+	key.width = width;
+	key.height = height;
+	key.scale_factor = scale_factor;
+	key.period = period;
+	key.frames = art_loop_frames;
+	key.resolution = art_loop_resolution;
+	uint64_t hash = art_loop_hash(key);
+	
+	float res = (float)art_loop_resolution / 100.0f;
+	art_loop.poll_save();
+	if (!art_loop.texture || art_loop.hash != hash) {
+		// Draw live while a slider is still moving
+		if (!art_loop.settled(hash))
+			return false;
+		
+		art_loop.release_texture();
+		if (!art_loop.layout(art_loop_frames, (uint32_t)ceilf(width * res), (uint32_t)ceilf(height * res)))
+			return false;
+		
+		if (!art_loop.load(hash)) {
+			uint64_t bake_start = os_gettime_ns();
+			if (!art_loop.bake_begin())
+				return false;
+			
+			// Bake at full quality whatever the governor currently allows
+			bool governed = art_gov.enabled;
+			art_gov.enabled = false;
+			
+			for (int f = 0; f < art_loop.frames; f++) {
+				uint32_t cell_x, cell_y;
+				art_loop.cell_origin(f, &cell_x, &cell_y);
+				struct gs_rect cell = {(int)cell_x, (int)cell_y, (int)art_loop.cell_cx, (int)art_loop.cell_cy};
+				gs_set_scissor_rect(&cell);
+				
+				gs_matrix_push();
+				gs_matrix_translate3f((float)cell_x, (float)cell_y, 0.0f);
+				gs_matrix_scale3f(res, res, 1.0f);
+				
+				float t = (float)f / (float)art_loop.frames * period;
+				draw_art_effect(0.0f, 0.0f, width, height, art_effect, art_color,
+					opacity, art_intensity, t);
+				
+				gs_matrix_pop();
+			}
+			
+			art_gov.enabled = governed;
+			art_loop.bake_end();
+			art_loop.hash = hash;
+			art_loop.save();
+			blog(LOG_INFO, "Baked art loop: %d frames, %ux%u atlas, %.1f ms",
+				art_loop.frames, art_loop.cx, art_loop.cy,
+				(double)(os_gettime_ns() - bake_start) / 1000000.0);
+		}
+	}
+	
+	int frame = (int)(fmodf(art_animation_offset, period) / period * (float)art_loop.frames);
+	if (frame < 0)
+		frame = 0;
+	if (frame >= art_loop.frames)
+		frame = art_loop.frames - 1;
+	uint32_t cell_x, cell_y;
+	art_loop.cell_origin(frame, &cell_x, &cell_y);
+	
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), art_loop.texture);
+	gs_effect_set_float(gs_effect_get_param_by_name(effect, "multiplier"), alpha);
+	
+	// Same additive blend as the cached static pattern
+	gs_blend_state_push();
+	gs_enable_color(true, true, true, true);
+	gs_enable_blending(true);
+	gs_blend_function_separate(
+		GS_BLEND_ONE, GS_BLEND_ONE,       // RGB: additive
+		GS_BLEND_ZERO, GS_BLEND_ONE       // Alpha: preserve
+	);
+	
+	gs_matrix_push();
+	gs_matrix_scale3f(1.0f / res, 1.0f / res, 1.0f);
+	while (gs_effect_loop(effect, "DrawMultiply"))
+		gs_draw_sprite_subregion(art_loop.texture, 0, cell_x, cell_y, art_loop.cell_cx, art_loop.cell_cy);
+	gs_matrix_pop();
+	
+	gs_blend_state_pop();
+	return true;
+}
+
 void register_lowerthirds_source()
 {
 	obs_source_info info = {};
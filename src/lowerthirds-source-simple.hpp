@@ -3,6 +3,49 @@
 #include <obs-module.h>
 #include <graphics/image-file.h>
 #include <string>
+#include "vertex-batch.hpp"
+#include "art-kernel.hpp"
+#include "art-governor.hpp"
+#include "art-loop.hpp"
+#include "particle-pool.hpp"
+#include "art-shader.hpp"
+#include "sprite-batch.hpp"
+#include "gradient-lut.hpp"
+#include "rounded-rect.hpp"
+#include "image-loader.hpp"
+#include "glyph-batch.hpp"
+#include "text-shadow.hpp"
+
+// Side of the A8 glyph cache every text_ft2 source allocates, both in system
+// memory and as a texture
+#define TEXT_FT2_TEXBUF_SIZE 2048
+
+// Settings a private text source was last updated with. A text_ft2 update
+// re-rasterizes the whole string, so update_text_sources() only sends one
+// when these change.
+struct text_fingerprint {
+	bool valid;
+	std::string text;
+	std::string face;
+	int size;
+	uint32_t flags;
+	uint32_t color;
+	uint64_t version;            // text_updates_performed when it last changed
+};
+
+// A string's size as last measured and its highlight box relative to the
+// string's origin. Refreshed when the text, font or highlight padding
+// changes, so render() never measures text.
+struct text_metrics {
+	uint32_t width;
+	uint32_t height;
+	float baseline;              // Top of the string to its first baseline
+	float box_x;                 // Highlight box
+	float box_y;
+	float box_width;
+	float box_height;
+	int pending_ticks;           // Text source may still be rasterizing: re-measure in tick()
+};
 
 // Animation style options
 enum AnimationStyle {
@@ -30,7 +73,9 @@ enum GradientType {
 	GRADIENT_HORIZONTAL = 1,
 	GRADIENT_VERTICAL = 2,
 	GRADIENT_DIAGONAL_TL_BR = 3,
-	GRADIENT_DIAGONAL_BL_TR = 4
+	GRADIENT_DIAGONAL_BL_TR = 4,
+	GRADIENT_ANGLE = 5,         // Linear along gradient_angle
+	GRADIENT_RADIAL = 6         // Center to corners
 };
 
 // Background art effects options
@@ -46,6 +91,47 @@ enum BackgroundArtEffect {
 	ART_ENERGY_FLOW = 8         // Flowing energy effect
 };
 
+// Per-element constants of the active art effect (structure of arrays).
+// Everything derived from the deterministic seed hash is computed once when
+// effect, intensity or bar size change; render only evaluates the
+// time-dependent terms. Which arrays are used depends on the effect.
+// Arrays are padded to ART_KERNEL_PAD floats for the vector kernels.
+struct art_element_table {
+	BackgroundArtEffect effect;
+	float intensity;
+	float width;
+	float height;
+	int count;                  // Elements (energy flow: flows * pulses)
+	float *data;                // Single allocation backing the arrays below
+	float *x;                   // Base position (light rays: direction)
+	float *y;
+	float *size;                // Base size or length
+	float *thickness;           // Streak height
+	float *speed;               // Drift / twinkle / orbit / travel speed
+	float *phase;               // Seed-derived phase offsets
+	float *phase2;
+	float *phase3;
+	float *frequency;           // Shimmer wave frequency
+	float *amplitude;           // Shimmer wave amplitude
+	float *sim_x;               // Per-frame art-kernel output
+	float *sim_y;
+	float *sim_alpha;
+	float layer_falloff[8];     // Alpha falloff per glow layer
+};
+
+// Inputs that fully determine a non-animated art frame
+struct art_cache_key {
+	BackgroundArtEffect effect;
+	uint32_t color;
+	int opacity;
+	float intensity;
+	float width;
+	float height;
+	float animation_offset;     // Frozen offset or last simulation step
+	float scale_factor;         // Drives circle tessellation
+	int quality_tier;           // Adaptive quality at render time
+};
+
 struct lowerthirds_source {
 	obs_source_t *source;
 	
@@ -55,12 +141,35 @@ struct lowerthirds_source {
 	// Number of visible tabs (1-5, starts at 1)
 	int num_visible_tabs;
 	
-	// Text sources for rendering
+	// Text sources for rendering: the current profile's entries of
+	// profile_text_sources, re-pointed by select_profile(). Only created
+	// when the built-in text below is off or has no font.
 	obs_source_t *title_text_source;
 	obs_source_t *subtitle_text_source;
 	obs_source_t *title_right_text_source;
 	obs_source_t *subtitle_right_text_source;
 	
+	// Every profile keeps its own rasterized title, subtitle, right title
+	// and right subtitle (in that order), so a profile switch never waits
+	// for FreeType
+	obs_source_t *profile_text_sources[5][4];
+	text_fingerprint text_fingerprints[5][4];
+	uint64_t text_updates_performed;        // Strings re-rasterized or re-laid out
+	uint64_t text_updates_skipped;          // Unchanged, not sent
+	
+	// Built-in text (see glyph-atlas.hpp): every profile's strings laid out
+	// over two shared fonts and drawn in one batch, instead of a text source
+	// with its own glyph cache per string
+	bool glyph_text_enabled;                // "glyph_text" setting
+	bool use_glyph_text;                    // Enabled, fonts found, effect loaded
+	glyph_font *glyph_fonts[2];             // Bold titles, regular subtitles
+	std::string glyph_face;                 // What glyph_fonts were acquired for
+	int glyph_sizes[2];
+	text_layout glyph_layouts[5][4];
+	uint64_t glyph_generation;              // Atlas generation glyph_layouts point into
+	text_metrics text_metrics_cache[5][4];  // Both paths; what render() lays out with
+	glyph_batch glyph_text;
+	
 	// Text fields for 5 profiles (tabs)
 	char *title[5];
 	char *subtitle[5];
@@ -71,11 +180,15 @@ struct lowerthirds_source {
 	
 	// Background image
 	char *bg_image_path;
-	gs_image_file_t *bg_image;
+	shared_image *bg_image;      // On screen; replaced by bg_loader.swap()
+	image_loader bg_loader;
+	image_fit bg_fit;            // Last requested; see update()
 	
 	// Logo image (left side)
 	char *logo_image_path;
-	gs_image_file_t *logo_image;
+	shared_image *logo_image;
+	image_loader logo_loader;
+	image_fit logo_fit;
 	int logo_size;
 	int logo_opacity;
 	int logo_padding_horizontal;
@@ -98,6 +211,8 @@ struct lowerthirds_source {
 	int text_shadow_opacity;
 	int text_shadow_offset_x;
 	int text_shadow_offset_y;
+	int text_shadow_blur;        // Gaussian radius in px, 0 = hard shadow
+	text_shadow_cache text_shadows; // Silhouettes of the current profile's strings
 	
 	// Shadow properties for logo
 	bool logo_shadow_enabled;
@@ -113,10 +228,22 @@ struct lowerthirds_source {
 	int text_highlight_corner_radius;
 	int text_highlight_padding_horizontal;
 	int text_highlight_padding_vertical;
+	bool text_highlight_sdf;     // Boxes from the SDF shader instead of cached geometry
+	int text_highlight_border_width;
+	uint32_t text_highlight_border_color;
+	int text_highlight_inner_shadow;
+	uint32_t text_highlight_inner_shadow_color;
+	int text_highlight_inner_shadow_opacity;
+	rounded_rect_cache highlight_rects; // Box geometry per size (one draw each)
+	rounded_rect_sdf highlight_sdf;
 	
 	// Gradient properties
 	GradientType gradient_type;
 	uint32_t gradient_color2;
+	int gradient_stop_count;     // 2-8, evenly spaced
+	uint32_t gradient_stops[GRADIENT_MAX_STOPS]; // bg_color, gradient_color2, gradient_color3...
+	int gradient_angle;          // Degrees, 0 = left to right, 90 = top to bottom
+	gradient_lut gradient_tex;   // Baked stops for multi-stop and radial gradients
 	
 	// Background art effect properties
 	BackgroundArtEffect art_effect;
@@ -126,6 +253,29 @@ struct lowerthirds_source {
 	float art_speed;
 	bool art_animate;
 	float art_animation_offset;  // For animation state
+	int art_sim_rate;            // Art simulation steps per second (0 = every frame)
+	float art_sim_elapsed;       // Time since the last simulation step
+	float art_sim_offset;        // art_animation_offset at the last step
+	bool art_sim_live;           // Step every frame anyway - draw live, skip the cache
+	vertex_batch art_batch;      // Per-frame art geometry (single draw)
+	art_element_table art_table; // Precomputed per-element art constants
+	gs_texrender_t *art_cache;   // Static pattern when art_animate is off
+	bool art_cache_valid;
+	art_cache_key art_cache_state;
+	art_governor art_gov;        // Adaptive effect quality (render time budget)
+	bool art_loop_bake;          // Play looping effects from a baked sprite sheet
+	int art_loop_frames;         // Cells per loop period
+	int art_loop_resolution;     // Cell size in percent of the bar
+	art_loop_atlas art_loop;
+	bool art_particle_sim;       // Particles/sparkles from the pooled simulation
+	float art_emit_rate;         // Spawns per second
+	float art_particle_life;     // Seconds
+	float art_particle_velocity; // px/s
+	particle_pool art_pool;
+	particle_emitter art_pool_emitter; // What art_pool was sized and warmed for
+	bool art_use_shader;         // Per-pixel effect shader instead of CPU geometry
+	art_shader art_gpu;
+	sprite_batch art_sprites;    // Soft elements as atlas sprites (one draw)
 	
 	// Responsive scaling
 	bool auto_scale;
@@ -157,12 +307,39 @@ struct lowerthirds_source {
 	uint32_t get_height();
 	
 	void update_text_sources();
+	void update_glyph_fonts();
+	void update_profile_text(int profile);
+	void refresh_glyph_layouts();
+	void create_text_source(int profile, int slot);
+	void release_text_source(int profile, int slot);
+	void release_text_sources();
+	void select_profile(int profile);
+	size_t profile_text_bytes(int profile);
+	bool update_text_source(int profile, int slot, const char *text, int size, uint32_t flags);
+	bool text_slot_ready(int slot);
+	const text_metrics &slot_metrics(int slot) const;
+	void measure_text(int profile, int slot);
+	void update_text_box(text_metrics &metrics);
+	void tick_text_metrics();
+	void draw_text(int slot, uint32_t color, bool tint);
+	void update_text_shadows();
+	void draw_text_shadow(int slot, uint32_t color);
+	void flush_glyph_text();
 	void draw_gradient_rect(float x, float y, float width, float height, 
 		struct vec4 color1, struct vec4 color2, GradientType type);
+	bool draw_gradient_lut(float width, float height, float alpha);
 	void draw_logo_with_alpha(gs_texture_t *texture, float width, float height, float alpha);
 	void draw_rounded_rect(float x, float y, float width, float height, float radius, uint32_t color, float opacity);
+	void update_art_table(BackgroundArtEffect effect, float intensity, float width, float height);
 	void draw_art_effect(float x, float y, float width, float height, BackgroundArtEffect effect, 
 		uint32_t color, float opacity, float intensity, float animation_offset);
+	void draw_art_cached(float width, float height, float alpha, float animation_offset);
+	bool draw_art_baked(float width, float height, float alpha);
+	bool art_uses_pool() const;
+	particle_emitter art_emitter() const;
+	void draw_art_pool(BackgroundArtEffect effect, struct vec4 color, float opacity);
+	bool draw_art_sprites(BackgroundArtEffect effect, struct vec4 color, float opacity,
+		float width, float animation_offset);
 };
 
 void register_lowerthirds_source();
@@ -0,0 +1,140 @@
+/**
+ * Lower Thirds Plus - pooled particle simulation
+ *
+ * See particle-pool.hpp.
+ */
+
+#include "particle-pool.hpp"
+#include <util/bmem.h>
+#include <math.h>
+#include <string.h>
+
+particle_pool::particle_pool()
+	: capacity(0)
+	, high(0)
+	, live(0)
+	, data(nullptr)
+	, x(nullptr)
+	, y(nullptr)
+	, vx(nullptr)
+	, vy(nullptr)
+	, age(nullptr)
+	, life(nullptr)
+	, size(nullptr)
+	, phase(nullptr)
+	, free_list(nullptr)
+	, free_count(0)
+	, emit_accum(0.0f)
+	, rng(0x9e3779b9u)
+{
+}
+
+void particle_pool::init(int num)
+{
+	destroy();
+	if (num < 1)
+		return;
+
+	const int num_arrays = 8;
+	capacity = num;
+	data = (float *)bmalloc(sizeof(float) * num_arrays * num);
+	x = data;
+	y = x + num;
+	vx = y + num;
+	vy = vx + num;
+	age = vy + num;
+	life = age + num;
+	size = life + num;
+	phase = size + num;
+	free_list = (int *)bmalloc(sizeof(int) * num);
+	clear();
+}
+
+void particle_pool::destroy()
+{
+	bfree(data);
+	bfree(free_list);
+	data = nullptr;
+	free_list = nullptr;
+	capacity = 0;
+	high = 0;
+	live = 0;
+	free_count = 0;
+}
+
+void particle_pool::clear()
+{
+	high = 0;
+	live = 0;
+	free_count = 0;
+	emit_accum = 0.0f;
+	rng = 0x9e3779b9u;
+}
+
+int particle_pool::steady_count(const particle_emitter &emitter)
+{
+	return (int)ceilf(emitter.rate * emitter.lifetime);
+}
+
+void particle_pool::warm(const particle_emitter &e)
+{
+	const float step = 0.1f;
+	for (float t = 0.0f; t < e.lifetime * 1.25f; t += step)
+		update(e, step);
+}
+
+void particle_pool::spawn(const particle_emitter &e)
+{
+	int i;
+	if (free_count > 0)
+		i = free_list[--free_count];
+	else if (high < capacity)
+		i = high++;
+	else
+		return; // Pool full: the emitter is faster than the capacity allows
+
+	x[i] = random01() * e.width;
+	y[i] = random01() * e.height;
+	// Mostly upward, with a slow sideways drift either way
+	vx[i] = (random01() - 0.5f) * e.velocity * 0.6f;
+	vy[i] = -e.velocity * (0.5f + random01());
+	age[i] = 0.0f;
+	life[i] = e.lifetime * (0.75f + random01() * 0.5f);
+	size[i] = e.size * (0.7f + random01() * 0.5f);
+	phase[i] = random01() * 6.2831853f;
+	live++;
+}
+
+void particle_pool::update(const particle_emitter &e, float seconds)
+{
+	if (!capacity)
+		return;
+
+	// Integrate every used slot without branching so the loop vectorizes;
+	// free slots integrate garbage that the next spawn overwrites
+	for (int i = 0; i < high; i++) {
+		age[i] += seconds;
+		x[i] += vx[i] * seconds;
+		y[i] += vy[i] * seconds;
+	}
+
+	// Then retire what expired or left the area (life == 0 marks free slots,
+	// which are already on the free list)
+	const float margin = e.size * 3.0f;
+	const float min_x = -margin, max_x = e.width + margin;
+	const float min_y = -margin, max_y = e.height + margin;
+	for (int i = 0; i < high; i++) {
+		if (life[i] > 0.0f && (age[i] >= life[i] || y[i] < min_y || y[i] > max_y ||
+			x[i] < min_x || x[i] > max_x)) {
+			life[i] = 0.0f;
+			free_list[free_count++] = i;
+			live--;
+		}
+	}
+
+	emit_accum += e.rate * seconds;
+	int spawns = (int)emit_accum;
+	emit_accum -= (float)spawns;
+	for (int n = 0; n < spawns; n++)
+		spawn(e);
+}
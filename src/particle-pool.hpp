@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+
+// Fixed-capacity particle storage for the simulated art effects. Particles
+// live in structure-of-arrays slots; dead slots go on a free list and are
+// reused by the next spawn, so nothing is allocated after init(). Slots
+// below `high` are either live (life > 0) or on the free list.
+//
+// Must only be used from the graphics thread (tick and render).
+
+struct particle_emitter {
+	float rate;                 // Spawns per second
+	float lifetime;             // Seconds, each particle varies +-25%
+	float velocity;             // Rise speed in px/s, with sideways drift
+	float size;                 // Base radius, each particle varies 0.7-1.2x
+	float width;                // Spawn area and kill bounds
+	float height;
+};
+
+struct particle_pool {
+	int capacity;
+	int high;                   // Slots ever used (iteration bound)
+	int live;
+	float *data;                // Single allocation backing the arrays below
+	float *x;
+	float *y;
+	float *vx;
+	float *vy;
+	float *age;
+	float *life;                // Total lifetime; 0 marks a free slot
+	float *size;
+	float *phase;               // Per-particle pulse/twinkle offset
+	int *free_list;
+	int free_count;
+	float emit_accum;           // Fractional spawns carried to the next tick
+	uint32_t rng;
+
+	particle_pool();
+
+	// (Re)allocates for `capacity` particles and clears the pool
+	void init(int capacity);
+	void destroy();
+	void clear();
+
+	// Spawns rate * seconds particles, ages all of them and frees the ones
+	// that expired or left the area
+	void update(const particle_emitter &emitter, float seconds);
+
+	// Runs the emitter for one lifetime in coarse steps so a new pool starts
+	// at its steady state instead of filling up on screen
+	void warm(const particle_emitter &emitter);
+
+	// Steady-state population of an emitter (rate x mean lifetime)
+	static int steady_count(const particle_emitter &emitter);
+
+private:
+	void spawn(const particle_emitter &emitter);
+	inline float random01()
+	{
+		// xorshift32: deterministic per pool, cheap enough for 10k spawns
+		rng ^= rng << 13;
+		rng ^= rng >> 17;
+		rng ^= rng << 5;
+		return (float)(rng >> 8) * (1.0f / 16777216.0f);
+	}
+};
@@ -0,0 +1,232 @@
+/**
+ * Lower Thirds Plus - cached rounded rectangles
+ *
+ * See rounded-rect.hpp.
+ */
+
+#include "rounded-rect.hpp"
+#include "unit-circle.hpp"
+#include <graphics/vec2.h>
+#include <graphics/vec3.h>
+#include <graphics/matrix4.h>
+#include <math.h>
+#include <util/bmem.h>
+
+rounded_rect_cache::rounded_rect_cache()
+	: slots()
+	, uses(0)
+	, builds(0)
+{
+}
+
+rounded_rect_cache::slot *rounded_rect_cache::find(const rounded_rect_key &key)
+{
+	slot *oldest = &slots[0];
+	for (slot &s : slots) {
+		if (s.vbuf && s.key.width == key.width && s.key.height == key.height &&
+			s.key.radius == key.radius && s.key.segments == key.segments)
+			return &s;
+		if (!s.vbuf || (oldest->vbuf && s.last_used < oldest->last_used))
+			oldest = &s;
+	}
+
+	if (!build(*oldest, key))
+		return nullptr;
+	return oldest;
+}
+
+bool rounded_rect_cache::build(slot &s, const rounded_rect_key &key)
+{
+	const float w = key.width, h = key.height, r = key.radius;
+	const bool rounded = r > 0.5f && key.segments > 0;
+	const int segments = key.segments;
+
+	// Rectangle: 2 triangles. Rounded: one triangle per outline edge, the
+	// outline being each corner's quarter arc (segments + 1 points)
+	size_t num = rounded ? (size_t)12 * (segments + 1) : 6;
+
+	struct gs_vb_data *vb_data = gs_vbdata_create();
+	vb_data->num = num;
+	vb_data->points = (struct vec3 *)bmalloc(sizeof(struct vec3) * num);
+	struct vec3 *p = vb_data->points;
+
+	if (!rounded) {
+		vec3_set(p++, 0.0f, 0.0f, 0.0f);
+		vec3_set(p++, w, 0.0f, 0.0f);
+		vec3_set(p++, 0.0f, h, 0.0f);
+		vec3_set(p++, w, 0.0f, 0.0f);
+		vec3_set(p++, w, h, 0.0f);
+		vec3_set(p++, 0.0f, h, 0.0f);
+	} else {
+		const struct vec2 *rim = unit_circle_table(segments * 4);
+
+		// Corner centers clockwise from top-left with their quarter of the
+		// table (180-270, 270-360, 0-90, 90-180 deg)
+		const float corners[4][3] = {
+			{r, r, 2.0f},
+			{w - r, r, 3.0f},
+			{w - r, h - r, 0.0f},
+			{r, h - r, 1.0f},
+		};
+
+		struct vec2 outline[4 * (UNIT_CIRCLE_MAX_SEGMENTS / 4 + 1) + 4];
+		int points = 0;
+		for (int c = 0; c < 4; c++) {
+			int first = (int)corners[c][2] * segments;
+			for (int i = 0; i <= segments; i++) {
+				const struct vec2 &dir = rim[first + i];
+				vec2_set(&outline[points++], corners[c][0] + r * dir.x, corners[c][1] + r * dir.y);
+			}
+		}
+
+		for (int i = 0; i < points; i++) {
+			const struct vec2 &a = outline[i];
+			const struct vec2 &b = outline[(i + 1) % points];
+			vec3_set(p++, w * 0.5f, h * 0.5f, 0.0f);
+			vec3_set(p++, a.x, a.y, 0.0f);
+			vec3_set(p++, b.x, b.y, 0.0f);
+		}
+	}
+
+	gs_vertbuffer_t *vbuf = gs_vertexbuffer_create(vb_data, 0);
+	if (!vbuf) {
+		gs_vbdata_destroy(vb_data);
+		return false;
+	}
+
+	if (s.vbuf)
+		gs_vertexbuffer_destroy(s.vbuf);
+	s.key = key;
+	s.vbuf = vbuf;
+	s.vertices = (uint32_t)num;
+	builds++;
+	return true;
+}
+
+void rounded_rect_cache::draw(float width, float height, float radius, int segments, const struct vec4 &color)
+{
+	if (segments > UNIT_CIRCLE_MAX_SEGMENTS / 4)
+		segments = UNIT_CIRCLE_MAX_SEGMENTS / 4;
+	rounded_rect_key key = {width, height, radius, radius > 0.5f ? segments : 0};
+	slot *s = find(key);
+	if (!s)
+		return;
+	s->last_used = ++uses;
+
+	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
+	gs_eparam_t *color_param = gs_effect_get_param_by_name(solid, "color");
+	gs_effect_set_vec4(color_param, &color);
+
+	gs_load_vertexbuffer(s->vbuf);
+	gs_load_indexbuffer(nullptr);
+	while (gs_effect_loop(solid, "Solid"))
+		gs_draw(GS_TRIS, 0, s->vertices);
+	gs_load_vertexbuffer(nullptr);
+}
+
+void rounded_rect_cache::destroy()
+{
+	for (slot &s : slots) {
+		if (s.vbuf)
+			gs_vertexbuffer_destroy(s.vbuf);
+		s = slot();
+	}
+	uses = 0;
+}
+
+rounded_rect_sdf::rounded_rect_sdf()
+	: effect(nullptr)
+	, size(nullptr)
+	, pad(nullptr)
+	, radius(nullptr)
+	, fill(nullptr)
+	, border_color(nullptr)
+	, border_width(nullptr)
+	, shadow_color(nullptr)
+	, shadow_size(nullptr)
+	, load_failed(false)
+{
+}
+
+bool rounded_rect_sdf::load()
+{
+	if (effect)
+		return true;
+	if (load_failed)
+		return false;
+
+	char *path = obs_module_file("effects/rounded-rect.effect");
+	char *errors = nullptr;
+	if (path)
+		effect = gs_effect_create_from_file(path, &errors);
+
+	if (effect) {
+		size = gs_effect_get_param_by_name(effect, "box_size");
+		pad = gs_effect_get_param_by_name(effect, "box_pad");
+		radius = gs_effect_get_param_by_name(effect, "corner_radius");
+		fill = gs_effect_get_param_by_name(effect, "fill_color");
+		border_color = gs_effect_get_param_by_name(effect, "border_color");
+		border_width = gs_effect_get_param_by_name(effect, "border_width");
+		shadow_color = gs_effect_get_param_by_name(effect, "shadow_color");
+		shadow_size = gs_effect_get_param_by_name(effect, "shadow_size");
+		if (!size || !pad || !radius || !fill || !border_color ||
+			!border_width || !shadow_color || !shadow_size) {
+			gs_effect_destroy(effect);
+			effect = nullptr;
+		}
+	}
+
+	if (!effect) {
+		load_failed = true;
+		blog(LOG_WARNING, "Rounded rect effect unavailable (%s), using cached geometry%s%s",
+			path ? path : "effects/rounded-rect.effect", errors ? ": " : "",
+			errors ? errors : "");
+	}
+	bfree(errors);
+	bfree(path);
+	return effect != nullptr;
+}
+
+void rounded_rect_sdf::destroy()
+{
+	gs_effect_destroy(effect);
+	effect = nullptr;
+	size = pad = radius = fill = nullptr;
+	border_color = border_width = shadow_color = shadow_size = nullptr;
+	load_failed = false;
+}
+
+bool rounded_rect_sdf::draw(float width, float height, float corner_radius, const rounded_rect_style &style)
+{
+	if (!load())
+		return false;
+
+	// The shader sizes the edge ramp itself; the quad only has to overhang
+	// by a screen pixel under the current transform (scene item scale
+	// included), in layout units
+	struct matrix4 m;
+	gs_matrix_get(&m);
+	float scale_x = sqrtf(m.x.x * m.x.x + m.x.y * m.x.y);
+	float scale_y = sqrtf(m.y.x * m.y.x + m.y.y * m.y.y);
+	float pixel_scale = scale_x < scale_y ? scale_x : scale_y;
+	float aa = pixel_scale > 0.0f ? 1.0f / pixel_scale : 1.0f;
+
+	struct vec2 box;
+	vec2_set(&box, width, height);
+	gs_effect_set_vec2(size, &box);
+	gs_effect_set_float(pad, aa);
+	gs_effect_set_float(radius, corner_radius);
+	gs_effect_set_vec4(fill, &style.fill);
+	gs_effect_set_vec4(border_color, &style.border);
+	gs_effect_set_float(border_width, style.border_width);
+	gs_effect_set_vec4(shadow_color, &style.shadow);
+	gs_effect_set_float(shadow_size, style.shadow_size);
+
+	gs_matrix_push();
+	gs_matrix_translate3f(-aa, -aa, 0.0f);
+	gs_matrix_scale3f(width + 2.0f * aa, height + 2.0f * aa, 1.0f);
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw_sprite(nullptr, 0, 1, 1);
+	gs_matrix_pop();
+	return true;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+#include <graphics/vec4.h>
+#include <stdint.h>
+
+// Rounded rectangles for the text highlight boxes.
+//
+// rounded_rect_cache: cached triangle fills. The geometry
+// for one (width, height, radius, corner segments) key is built once into a
+// static vertex buffer, a triangle list fanned from the center (exact, the
+// shape is convex), and every frame with the same key is a single gs_draw
+// through OBS_EFFECT_SOLID with the color as its uniform. A new key (text
+// size or highlight settings changed) rebuilds the least recently used slot.
+//
+// rounded_rect_sdf: data/effects/rounded-rect.effect evaluates the box's
+// signed distance per pixel, so a box is one quad with anti-aliased corners
+// at any radius and canvas scale, plus an optional border and inner shadow.
+//
+// Must only be used from the graphics thread.
+
+#define ROUNDED_RECT_SLOTS 4        // Title, subtitle and both right-side boxes
+
+struct rounded_rect_key {
+	float width;
+	float height;
+	float radius;               // Clamped; <= 0.5 is a plain rectangle
+	int segments;               // Per corner
+};
+
+struct rounded_rect_cache {
+	struct slot {
+		rounded_rect_key key;
+		gs_vertbuffer_t *vbuf;
+		uint32_t vertices;
+		uint64_t last_used;
+	};
+
+	slot slots[ROUNDED_RECT_SLOTS];
+	uint64_t uses;
+	uint64_t builds;            // Geometry (re)builds since creation
+
+	rounded_rect_cache();
+
+	// Fills (0, 0)-(width, height) in the current transform. radius must
+	// already be clamped to half the shorter side.
+	void draw(float width, float height, float radius, int segments, const struct vec4 &color);
+
+	void destroy();
+
+private:
+	slot *find(const rounded_rect_key &key);
+	bool build(slot &s, const rounded_rect_key &key);
+};
+
+// Straight RGBA colors, opacity already in alpha
+struct rounded_rect_style {
+	struct vec4 fill;
+	struct vec4 border;
+	float border_width;         // Layout pixels, 0 = none
+	struct vec4 shadow;         // Alpha = strength
+	float shadow_size;          // Layout pixels, 0 = none
+};
+
+struct rounded_rect_sdf {
+	gs_effect_t *effect;
+	gs_eparam_t *size;
+	gs_eparam_t *pad;
+	gs_eparam_t *radius;
+	gs_eparam_t *fill;
+	gs_eparam_t *border_color;
+	gs_eparam_t *border_width;
+	gs_eparam_t *shadow_color;
+	gs_eparam_t *shadow_size;
+	bool load_failed;           // Only try (and log) once
+
+	rounded_rect_sdf();
+
+	// Compiles the effect on first use; false if it is unavailable
+	bool load();
+	void destroy();
+
+	// Box over (0, 0)-(width, height) in the current transform; the quad
+	// overhangs by one screen pixel (measured from the current matrix) for
+	// the edge ramp. False (nothing drawn) if the effect is unavailable.
+	bool draw(float width, float height, float radius, const rounded_rect_style &style);
+};
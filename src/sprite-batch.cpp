@@ -0,0 +1,308 @@
+/**
+ * Lower Thirds Plus - art sprite batch
+ *
+ * See sprite-batch.hpp.
+ */
+
+#include "sprite-batch.hpp"
+#include <graphics/vec4.h>
+#include <util/bmem.h>
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+static const uint32_t cell_size = 128;          // Texels per atlas cell (square)
+static const uint32_t cell_border = 1;          // Empty texels around each cell
+static const int cell_supersample = 4;          // Per axis, for anti-aliased steps
+
+// Stacked layers of a shape: layer l reaches 1 + l * grow element sizes (disc
+// radius, beam scale or band half height) and adds weight[l]. Radii and
+// weights mirror draw_art_effect's fans, beams and strips (layer falloff
+// times the per-effect draw factor).
+struct shape_layers {
+	int count;
+	float grow;
+	float weight[6];
+};
+
+static shape_layers layers_for(art_sprite_shape shape)
+{
+	static const struct {
+		int count;
+		float grow;
+		float falloff_exp;
+		float factor;
+	} table[ART_SPRITE_SHAPES] = {
+		{5, 0.6f, 2.0f, 0.25f},
+		{4, 0.5f, 2.5f, 1.0f},
+		{6, 0.5f, 2.5f, 1.0f},
+		{3, 0.8f, 2.0f, 0.4f},
+		{4, 0.8f, 2.0f, 0.3f},      // Strips drew with their trailing-edge (30%) uniform
+	};
+
+	shape_layers sl = {table[shape].count, table[shape].grow, {0}};
+	for (int l = 0; l < sl.count; l++)
+		sl.weight[l] = powf(1.0f - (float)l / sl.count, table[shape].falloff_exp) * table[shape].factor;
+	return sl;
+}
+
+// Summed layer alpha at (x, y), in units of the element size
+static float shape_coverage(art_sprite_shape shape, const shape_layers &sl, float x, float y)
+{
+	float ax = fabsf(x), ay = fabsf(y);
+	float d = shape == ART_SPRITE_STREAK ? ay : sqrtf(x * x + y * y);
+	float sum = 0.0f;
+	for (int l = 0; l < sl.count; l++) {
+		float mult = 1.0f + l * sl.grow;
+		if (shape == ART_SPRITE_STAR) {
+			// Horizontal and vertical beam, each drawn separately
+			if (ax < 3.0f * mult && ay < 0.4f * mult)
+				sum += sl.weight[l];
+			if (ax < 0.4f * mult && ay < 3.0f * mult)
+				sum += sl.weight[l];
+		} else if (d < mult) {
+			sum += sl.weight[l];
+		}
+	}
+	if (shape == ART_SPRITE_STAR && ax < 1.5f && ay < 1.5f)
+		sum += 0.8f;                // Center point
+	return sum;
+}
+
+static art_sprite_shape_info shape_infos[ART_SPRITE_SHAPES] = {
+	{3.4f, 3.4f, 0.0f},
+	{2.5f, 2.5f, 0.0f},
+	{3.5f, 3.5f, 0.0f},
+	{7.8f, 7.8f, 0.0f},
+	{1.0f, 3.4f, 0.0f},
+};
+
+const art_sprite_shape_info &art_sprite_info(art_sprite_shape shape)
+{
+	art_sprite_shape_info &info = shape_infos[shape];
+	if (info.peak == 0.0f)
+		info.peak = shape_coverage(shape, layers_for(shape), 0.0f, 0.0f); // Every shape peaks at its center
+	return info;
+}
+
+// White RGBA cells, coverage / peak in alpha, side by side
+static void build_atlas(uint8_t *pixels)
+{
+	const uint32_t atlas_cx = cell_size * ART_SPRITE_SHAPES;
+	const uint32_t inner = cell_size - cell_border * 2;
+	const float samples = (float)(cell_supersample * cell_supersample);
+
+	for (int s = 0; s < ART_SPRITE_SHAPES; s++) {
+		art_sprite_shape shape = (art_sprite_shape)s;
+		const art_sprite_shape_info &info = art_sprite_info(shape);
+		const shape_layers sl = layers_for(shape);
+		for (uint32_t ty = 0; ty < cell_size; ty++) {
+			for (uint32_t tx = 0; tx < cell_size; tx++) {
+				float coverage = 0.0f;
+				if (tx >= cell_border && tx < cell_border + inner &&
+					ty >= cell_border && ty < cell_border + inner) {
+					for (int sy = 0; sy < cell_supersample; sy++) {
+						for (int sx = 0; sx < cell_supersample; sx++) {
+							float u = ((float)(tx - cell_border) + (sx + 0.5f) / cell_supersample) / inner;
+							float v = ((float)(ty - cell_border) + (sy + 0.5f) / cell_supersample) / inner;
+							coverage += shape_coverage(shape, sl, (u * 2.0f - 1.0f) * info.extent_x,
+								(v * 2.0f - 1.0f) * info.extent_y);
+						}
+					}
+					coverage /= samples * info.peak;
+				}
+
+				uint8_t *p = pixels + ((size_t)ty * atlas_cx + (size_t)s * cell_size + tx) * 4;
+				p[0] = p[1] = p[2] = 255;
+				p[3] = (uint8_t)(fminf(coverage, 1.0f) * 255.0f + 0.5f);
+			}
+		}
+	}
+}
+
+// The pixels only depend on the constants above, so every source shares one
+// build and only uploads its own texture
+static const std::vector<uint8_t> &atlas_pixels()
+{
+	static const std::vector<uint8_t> pixels = [] {
+		std::vector<uint8_t> out((size_t)cell_size * ART_SPRITE_SHAPES * cell_size * 4, 0);
+		build_atlas(out.data());
+		return out;
+	}();
+	return pixels;
+}
+
+sprite_batch::sprite_batch()
+	: vbuf(nullptr)
+	, data(nullptr)
+	, capacity(0)
+	, count(0)
+	, atlas(nullptr)
+	, effect(nullptr)
+	, image(nullptr)
+	, load_failed(false)
+{
+}
+
+bool sprite_batch::load()
+{
+	if (effect && atlas)
+		return true;
+	if (load_failed)
+		return false;
+
+	char *path = obs_module_file("effects/art-sprite.effect");
+	char *errors = nullptr;
+	if (path)
+		effect = gs_effect_create_from_file(path, &errors);
+	if (effect)
+		image = gs_effect_get_param_by_name(effect, "image");
+
+	if (effect && image) {
+		const uint8_t *planes = atlas_pixels().data();
+		atlas = gs_texture_create(cell_size * ART_SPRITE_SHAPES, cell_size, GS_RGBA, 1, &planes, 0);
+	}
+
+	if (!effect || !image || !atlas) {
+		load_failed = true;
+		blog(LOG_WARNING, "Art sprite batch unavailable (%s), using layered geometry%s%s",
+			path ? path : "effects/art-sprite.effect", errors ? ": " : "",
+			errors ? errors : "");
+		gs_effect_destroy(effect);
+		gs_texture_destroy(atlas);
+		effect = nullptr;
+		image = nullptr;
+		atlas = nullptr;
+	}
+	bfree(errors);
+	bfree(path);
+	return effect != nullptr;
+}
+
+void sprite_batch::begin(size_t num)
+{
+	count = 0;
+	if (!vbuf || num * 6 > capacity)
+		grow(num * 6);
+}
+
+bool sprite_batch::grow(size_t num)
+{
+	// Grow geometrically so intensity slider drags don't recreate every frame
+	size_t new_capacity = capacity ? capacity : 1536;
+	while (new_capacity < num)
+		new_capacity *= 2;
+
+	struct gs_vb_data *vb_data = gs_vbdata_create();
+	vb_data->num = new_capacity;
+	vb_data->points = (struct vec3 *)bmalloc(sizeof(struct vec3) * new_capacity);
+	vb_data->colors = (uint32_t *)bmalloc(sizeof(uint32_t) * new_capacity);
+	vb_data->num_tex = 1;
+	vb_data->tvarray = (struct gs_tvertarray *)bzalloc(sizeof(struct gs_tvertarray));
+	vb_data->tvarray[0].width = 2;
+	vb_data->tvarray[0].array = bmalloc(sizeof(struct vec2) * new_capacity);
+
+	gs_vertbuffer_t *new_vbuf = gs_vertexbuffer_create(vb_data, GS_DYNAMIC);
+	if (!new_vbuf) {
+		gs_vbdata_destroy(vb_data);
+		return false;
+	}
+
+	struct gs_vb_data *new_data = gs_vertexbuffer_get_data(new_vbuf);
+	size_t kept = count;
+	if (kept) {
+		memcpy(new_data->points, data->points, sizeof(struct vec3) * kept);
+		memcpy(new_data->colors, data->colors, sizeof(uint32_t) * kept);
+		memcpy(new_data->tvarray[0].array, data->tvarray[0].array, sizeof(struct vec2) * kept);
+	}
+
+	if (vbuf)
+		gs_vertexbuffer_destroy(vbuf);
+	vbuf = new_vbuf;
+	data = new_data;
+	capacity = new_capacity;
+	count = kept;
+	return true;
+}
+
+void sprite_batch::add_quad(art_sprite_shape shape, float x0, float y0, float x1, float y1, uint32_t color)
+{
+	if (count + 6 > capacity && !grow(count + 6))
+		return;
+
+	// Inner area of the cell, clear of the border texels
+	const float atlas_cx = (float)(cell_size * ART_SPRITE_SHAPES);
+	float u0 = ((float)shape * cell_size + cell_border) / atlas_cx;
+	float u1 = ((float)(shape + 1) * cell_size - cell_border) / atlas_cx;
+	float v0 = (float)cell_border / cell_size;
+	float v1 = (float)(cell_size - cell_border) / cell_size;
+
+	const float corners[6][4] = {
+		{x0, y0, u0, v0}, {x1, y0, u1, v0}, {x0, y1, u0, v1},
+		{x1, y0, u1, v0}, {x1, y1, u1, v1}, {x0, y1, u0, v1},
+	};
+	struct vec2 *uvs = (struct vec2 *)data->tvarray[0].array;
+	for (const float *c : corners) {
+		vec3_set(&data->points[count], c[0], c[1], 0.0f);
+		data->colors[count] = color;
+		vec2_set(&uvs[count], c[2], c[3]);
+		count++;
+	}
+}
+
+void sprite_batch::add(art_sprite_shape shape, float cx, float cy, float size, const struct vec4 &tint, float alpha)
+{
+	const art_sprite_shape_info &info = art_sprite_info(shape);
+	float hx = size * info.extent_x;
+	float hy = size * info.extent_y;
+
+	// The cell is normalized to its peak, so the vertex alpha carries it
+	// back; it saturates at 1 where the classic layers summed past it
+	struct vec4 c = tint;
+	c.w = alpha * info.peak;
+	add_quad(shape, cx - hx, cy - hy, cx + hx, cy + hy, vec4_to_rgba(&c));
+}
+
+void sprite_batch::add_span(art_sprite_shape shape, float x0, float x1, float cy, float size,
+	const struct vec4 &tint, float alpha)
+{
+	const art_sprite_shape_info &info = art_sprite_info(shape);
+	float hy = size * info.extent_y;
+
+	struct vec4 c = tint;
+	c.w = alpha * info.peak;
+	add_quad(shape, x0, cy - hy, x1, cy + hy, vec4_to_rgba(&c));
+}
+
+void sprite_batch::draw()
+{
+	if (!vbuf || count == 0 || !effect)
+		return;
+
+	gs_effect_set_texture(image, atlas);
+
+	gs_vertexbuffer_flush(vbuf);
+	gs_load_vertexbuffer(vbuf);
+	gs_load_indexbuffer(nullptr);
+
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw(GS_TRIS, 0, (uint32_t)count);
+
+	gs_load_vertexbuffer(nullptr);
+}
+
+void sprite_batch::destroy()
+{
+	if (vbuf)
+		gs_vertexbuffer_destroy(vbuf);
+	vbuf = nullptr;
+	data = nullptr;
+	capacity = 0;
+	count = 0;
+	gs_effect_destroy(effect);
+	gs_texture_destroy(atlas);
+	effect = nullptr;
+	image = nullptr;
+	atlas = nullptr;
+	load_failed = false;
+}
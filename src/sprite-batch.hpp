@@ -0,0 +1,70 @@
+#pragma once
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+#include <graphics/vec2.h>
+#include <graphics/vec3.h>
+
+// Textured-quad batch for the soft art elements. Each element is one quad
+// sampling a cell of a generated atlas that holds the element's whole glow
+// (the stacked layers the fans used to draw, pre-summed), tinted by a vertex
+// color. All quads of a frame go out in one gs_draw through
+// data/effects/art-sprite.effect.
+//
+// Must only be used from the graphics thread.
+
+enum art_sprite_shape {
+	ART_SPRITE_PARTICLE,        // 5 discs, radius 1 + 0.6 * layer
+	ART_SPRITE_BOKEH,           // 4 discs, radius 1 + 0.5 * layer
+	ART_SPRITE_ORB,             // 6 discs, radius 1 + 0.5 * layer
+	ART_SPRITE_STAR,            // 3 crossed beam pairs plus the center point
+	ART_SPRITE_STREAK,          // 4 stacked bands, half height 1 + 0.8 * layer
+	ART_SPRITE_SHAPES
+};
+
+struct art_sprite_shape_info {
+	float extent_x;             // Quad half size in units of the element size
+	float extent_y;
+	float peak;                 // Summed layer alpha the cell was normalized by
+};
+
+const art_sprite_shape_info &art_sprite_info(art_sprite_shape shape);
+
+struct sprite_batch {
+	gs_vertbuffer_t *vbuf;
+	struct gs_vb_data *data;
+	size_t capacity;            // Vertices
+	size_t count;
+	gs_texture_t *atlas;
+	gs_effect_t *effect;
+	gs_eparam_t *image;
+	bool load_failed;           // Only try (and log) once
+
+	sprite_batch();
+
+	// Builds the atlas and compiles the effect on first use; false if the
+	// effect is unavailable (callers then draw the classic geometry)
+	bool load();
+
+	// Starts a new frame with room for at least num sprites
+	void begin(size_t num);
+
+	// Element of `shape` centered at (cx, cy), `size` = the classic base
+	// size. `alpha` is the classic per-element alpha; the layer weights are
+	// in the cell.
+	void add(art_sprite_shape shape, float cx, float cy, float size, const struct vec4 &tint, float alpha);
+
+	// Element whose quad is given directly; `size` only scales the height
+	// of the cell's profile (streaks: x runs along the streak)
+	void add_span(art_sprite_shape shape, float x0, float x1, float cy, float size,
+		const struct vec4 &tint, float alpha);
+
+	// Uploads and draws everything added since begin() as GS_TRIS
+	void draw();
+
+	void destroy();
+
+private:
+	bool grow(size_t num);
+	void add_quad(art_sprite_shape shape, float x0, float y0, float x1, float y1, uint32_t color);
+};
@@ -0,0 +1,195 @@
+/**
+ * Lower Thirds Plus - cached text shadows
+ *
+ * See text-shadow.hpp.
+ */
+
+#include "text-shadow.hpp"
+#include <graphics/vec2.h>
+#include <graphics/vec4.h>
+#include <util/bmem.h>
+
+text_shadow_cache::text_shadow_cache()
+	: shadows()
+	, scratch(nullptr)
+	, effect(nullptr)
+	, image(nullptr)
+	, texel_step(nullptr)
+	, blur_radius(nullptr)
+	, shadow_color(nullptr)
+	, load_failed(false)
+	, builds(0)
+{
+}
+
+bool text_shadow_cache::load()
+{
+	if (effect)
+		return true;
+	if (load_failed)
+		return false;
+
+	char *path = obs_module_file("effects/text-shadow.effect");
+	char *errors = nullptr;
+	if (path)
+		effect = gs_effect_create_from_file(path, &errors);
+	if (effect) {
+		image = gs_effect_get_param_by_name(effect, "image");
+		texel_step = gs_effect_get_param_by_name(effect, "texel_step");
+		blur_radius = gs_effect_get_param_by_name(effect, "blur_radius");
+		shadow_color = gs_effect_get_param_by_name(effect, "shadow_color");
+		if (!image || !texel_step || !blur_radius || !shadow_color) {
+			gs_effect_destroy(effect);
+			effect = nullptr;
+		}
+	}
+
+	if (!effect) {
+		load_failed = true;
+		blog(LOG_WARNING, "Text shadow effect unavailable (%s), rendering shadows from the text%s%s",
+			path ? path : "effects/text-shadow.effect", errors ? ": " : "",
+			errors ? errors : "");
+	}
+	bfree(errors);
+	bfree(path);
+	return effect != nullptr;
+}
+
+bool text_shadow_cache::current(int slot, int profile, uint64_t version, int radius, uint32_t cx,
+	uint32_t cy) const
+{
+	const text_shadow &s = shadows[slot];
+	return s.valid && s.profile == profile && s.version == version && s.radius == radius &&
+		s.cx == cx + 2 * (uint32_t)s.margin && s.cy == cy + 2 * (uint32_t)s.margin;
+}
+
+bool text_shadow_cache::build_begin(int slot, int profile, uint64_t version, int radius, uint32_t cx,
+	uint32_t cy)
+{
+	if (!cx || !cy || !load())
+		return false;
+
+	text_shadow &s = shadows[slot];
+	if (!s.texrender)
+		s.texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+	if (radius > TEXT_SHADOW_MAX_BLUR)
+		radius = TEXT_SHADOW_MAX_BLUR;
+
+	// Room for the blur to spread into (sigma = radius / 2)
+	s.valid = false;
+	s.margin = radius > 0 ? radius + 1 : 0;
+	s.cx = cx + 2 * (uint32_t)s.margin;
+	s.cy = cy + 2 * (uint32_t)s.margin;
+	s.profile = profile;
+	s.version = version;
+	s.radius = radius;
+
+	gs_texrender_reset(s.texrender);
+	if (!gs_texrender_begin(s.texrender, s.cx, s.cy))
+		return false;
+
+	struct vec4 clear_color;
+	vec4_zero(&clear_color);
+	gs_clear(GS_CLEAR_COLOR, &clear_color, 0.0f, 0);
+	gs_ortho(0.0f, (float)s.cx, 0.0f, (float)s.cy, -100.0f, 100.0f);
+
+	// Overlapping glyphs add up to full coverage in alpha
+	gs_blend_state_push();
+	gs_enable_blending(true);
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	gs_matrix_translate3f((float)s.margin, (float)s.margin, 0.0f);
+	return true;
+}
+
+void text_shadow_cache::build_end(int slot)
+{
+	text_shadow &s = shadows[slot];
+	gs_blend_state_pop();
+	gs_texrender_end(s.texrender);
+
+	if (s.radius > 0) {
+		if (!scratch)
+			scratch = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+		// Horizontal into the scratch target, vertical back into the shadow
+		blur_pass(scratch, gs_texrender_get_texture(s.texrender), s.cx, s.cy, 1.0f / (float)s.cx, 0.0f,
+			(float)s.radius);
+		blur_pass(s.texrender, gs_texrender_get_texture(scratch), s.cx, s.cy, 0.0f, 1.0f / (float)s.cy,
+			(float)s.radius);
+	}
+	s.valid = true;
+	builds++;
+}
+
+void text_shadow_cache::blur_pass(gs_texrender_t *target, gs_texture_t *source, uint32_t cx, uint32_t cy,
+	float step_x, float step_y, float radius)
+{
+	gs_texrender_reset(target);
+	if (!gs_texrender_begin(target, cx, cy))
+		return;
+
+	struct vec4 clear_color;
+	vec4_zero(&clear_color);
+	gs_clear(GS_CLEAR_COLOR, &clear_color, 0.0f, 0);
+	gs_ortho(0.0f, (float)cx, 0.0f, (float)cy, -100.0f, 100.0f);
+
+	struct vec2 step;
+	vec2_set(&step, step_x, step_y);
+	gs_effect_set_texture(image, source);
+	gs_effect_set_vec2(texel_step, &step);
+	gs_effect_set_float(blur_radius, radius);
+
+	gs_blend_state_push();
+	gs_enable_blending(false);
+	while (gs_effect_loop(effect, "Blur"))
+		gs_draw_sprite(source, 0, cx, cy);
+	gs_blend_state_pop();
+
+	gs_texrender_end(target);
+}
+
+bool text_shadow_cache::draw(int slot, uint32_t color)
+{
+	const text_shadow &s = shadows[slot];
+	if (!s.valid || !effect)
+		return false;
+	gs_texture_t *texture = gs_texrender_get_texture(s.texrender);
+	if (!texture)
+		return false;
+
+	// ABGR to RGBA, the packed alpha is the opacity
+	struct vec4 color_vec;
+	vec4_set(&color_vec,
+		((color >> 0) & 0xFF) / 255.0f,
+		((color >> 8) & 0xFF) / 255.0f,
+		((color >> 16) & 0xFF) / 255.0f,
+		((color >> 24) & 0xFF) / 255.0f);
+	gs_effect_set_texture(image, texture);
+	gs_effect_set_vec4(shadow_color, &color_vec);
+
+	gs_matrix_push();
+	gs_matrix_translate3f(-(float)s.margin, -(float)s.margin, 0.0f);
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw_sprite(texture, 0, s.cx, s.cy);
+	gs_matrix_pop();
+	return true;
+}
+
+void text_shadow_cache::clear()
+{
+	for (text_shadow &s : shadows) {
+		gs_texrender_destroy(s.texrender);
+		s = text_shadow();
+	}
+	gs_texrender_destroy(scratch);
+	scratch = nullptr;
+}
+
+void text_shadow_cache::destroy()
+{
+	clear();
+	gs_effect_destroy(effect);
+	effect = nullptr;
+	image = texel_step = blur_radius = shadow_color = nullptr;
+	load_failed = false;
+}
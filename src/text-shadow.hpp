@@ -0,0 +1,64 @@
+#pragma once
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+#include <stdint.h>
+
+// Text shadows cached as textures (data/effects/text-shadow.effect): each
+// string's silhouette is rendered once, blurred with a separable Gaussian
+// when a blur radius is set, and drawn every frame as one quad in the
+// shadow color. Color, opacity and offset are applied at draw time, so only
+// a text, font or blur change rebuilds a shadow.
+//
+// Must only be used from the graphics thread.
+
+#define TEXT_SHADOW_MAX_BLUR 32         // Loop bound in the effect file
+
+struct text_shadow {
+	gs_texrender_t *texrender;          // White, coverage in alpha
+	uint32_t cx, cy;                    // String size plus the blur margin
+	int margin;                         // Empty texels around the string
+	int profile;                        // What it was built for
+	uint64_t version;
+	int radius;
+	bool valid;
+};
+
+struct text_shadow_cache {
+	text_shadow shadows[4];             // Title, subtitle, right title, right subtitle
+	gs_texrender_t *scratch;            // Horizontal blur pass, shared
+	gs_effect_t *effect;
+	gs_eparam_t *image;
+	gs_eparam_t *texel_step;
+	gs_eparam_t *blur_radius;
+	gs_eparam_t *shadow_color;
+	bool load_failed;                   // Only try (and log) once
+	uint64_t builds;                    // Silhouettes rendered since creation
+
+	text_shadow_cache();
+
+	// Compiles the effect on first use; false if it is unavailable (callers
+	// then render the string tinted, as before)
+	bool load();
+
+	// True if the slot holds this string (`version` changes with its text or
+	// font) at this size and blur radius
+	bool current(int slot, int profile, uint64_t version, int radius, uint32_t cx, uint32_t cy) const;
+
+	// Opens the slot's silhouette for a cx x cy string: draw it at (0, 0)
+	// with coverage in alpha, then call build_end(), which blurs it
+	bool build_begin(int slot, int profile, uint64_t version, int radius, uint32_t cx, uint32_t cy);
+	void build_end(int slot);
+
+	// The slot's shadow at the string's origin under the current matrix, in
+	// `color` (ABGR, alpha = opacity). False if nothing is cached.
+	bool draw(int slot, uint32_t color);
+
+	// Frees the textures but keeps the effect (shadows turned off)
+	void clear();
+	void destroy();
+
+private:
+	void blur_pass(gs_texrender_t *target, gs_texture_t *source, uint32_t cx, uint32_t cy,
+		float step_x, float step_y, float radius);
+};
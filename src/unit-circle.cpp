@@ -0,0 +1,64 @@
+/**
+ * Lower Thirds Plus - shared unit-circle tables
+ *
+ * See unit-circle.hpp.
+ */
+
+#include "unit-circle.hpp"
+#include <math.h>
+
+// Tables for every segment count, packed back to back (~17 KB)
+struct unit_circle_tables {
+	int offset[UNIT_CIRCLE_MAX_SEGMENTS + 1];
+	struct vec2 *points;
+
+	unit_circle_tables()
+	{
+		int total = 0;
+		for (int n = UNIT_CIRCLE_MIN_SEGMENTS; n <= UNIT_CIRCLE_MAX_SEGMENTS; n++) {
+			offset[n] = total;
+			total += n + 1;
+		}
+
+		points = new struct vec2[total];
+		for (int n = UNIT_CIRCLE_MIN_SEGMENTS; n <= UNIT_CIRCLE_MAX_SEGMENTS; n++) {
+			struct vec2 *table = points + offset[n];
+			for (int k = 0; k < n; k++) {
+				double angle = (double)k / (double)n * 2.0 * M_PI;
+				vec2_set(&table[k], (float)cos(angle), (float)sin(angle));
+			}
+			table[n] = table[0];
+		}
+	}
+
+	~unit_circle_tables() { delete[] points; }
+};
+
+const struct vec2 *unit_circle_table(int segments)
+{
+	static const unit_circle_tables tables;
+
+	if (segments < UNIT_CIRCLE_MIN_SEGMENTS)
+		segments = UNIT_CIRCLE_MIN_SEGMENTS;
+	else if (segments > UNIT_CIRCLE_MAX_SEGMENTS)
+		segments = UNIT_CIRCLE_MAX_SEGMENTS;
+	return tables.points + tables.offset[segments];
+}
+
+int unit_circle_segments(float radius, float max_error, int min_segments)
+{
+	if (min_segments < UNIT_CIRCLE_MIN_SEGMENTS)
+		min_segments = UNIT_CIRCLE_MIN_SEGMENTS;
+	if (max_error <= 0.0f)
+		return UNIT_CIRCLE_MAX_SEGMENTS;
+	if (radius <= max_error)
+		return min_segments;
+
+	// Sagitta of one segment: r * (1 - cos(pi / n)) <= max_error
+	float n = ceilf((float)M_PI * sqrtf(radius / (2.0f * max_error)));
+	if (n < (float)min_segments)
+		return min_segments;
+	if (n > (float)UNIT_CIRCLE_MAX_SEGMENTS)
+		return UNIT_CIRCLE_MAX_SEGMENTS;
+	return (int)n;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <graphics/vec2.h>
+
+// Shared unit-circle tables for circle and rounded-corner primitives, so
+// render never evaluates cosf/sinf per vertex, plus segment selection from
+// the on-screen radius.
+
+#define UNIT_CIRCLE_MIN_SEGMENTS 3
+#define UNIT_CIRCLE_MAX_SEGMENTS 64
+
+// segments + 1 rim points of a unit circle; point k is at angle
+// 2 * pi * k / segments (the last point repeats the first). segments is
+// clamped to [UNIT_CIRCLE_MIN_SEGMENTS, UNIT_CIRCLE_MAX_SEGMENTS].
+const struct vec2 *unit_circle_table(int segments);
+
+// Fewest segments whose polygon stays within max_error pixels of a circle of
+// the given on-screen radius, clamped to [min_segments, max]. Uses
+// acos(1 - x) >= sqrt(2x), which never under-tessellates and needs no
+// transcendental call.
+int unit_circle_segments(float radius, float max_error, int min_segments);
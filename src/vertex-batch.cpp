@@ -0,0 +1,119 @@
+/**
+ * Lower Thirds Plus - batched colored geometry
+ *
+ * See vertex-batch.hpp.
+ */
+
+#include "vertex-batch.hpp"
+#include "unit-circle.hpp"
+#include <graphics/vec4.h>
+#include <util/bmem.h>
+#include <string.h>
+
+vertex_batch::vertex_batch()
+	: vbuf(nullptr)
+	, data(nullptr)
+	, capacity(0)
+	, count(0)
+{
+}
+
+void vertex_batch::begin(size_t num)
+{
+	count = 0;
+	if (!vbuf || num > capacity)
+		grow(num);
+}
+
+bool vertex_batch::grow(size_t num)
+{
+	// Grow geometrically so intensity slider drags don't recreate every frame
+	size_t new_capacity = capacity ? capacity : 1024;
+	while (new_capacity < num)
+		new_capacity *= 2;
+
+	struct gs_vb_data *vb_data = gs_vbdata_create();
+	vb_data->num = new_capacity;
+	vb_data->points = (struct vec3 *)bmalloc(sizeof(struct vec3) * new_capacity);
+	vb_data->colors = (uint32_t *)bmalloc(sizeof(uint32_t) * new_capacity);
+
+	gs_vertbuffer_t *new_vbuf = gs_vertexbuffer_create(vb_data, GS_DYNAMIC);
+	if (!new_vbuf) {
+		gs_vbdata_destroy(vb_data);
+		return false;
+	}
+
+	struct gs_vb_data *new_data = gs_vertexbuffer_get_data(new_vbuf);
+	size_t kept = count;
+	if (kept) {
+		memcpy(new_data->points, data->points, sizeof(struct vec3) * kept);
+		memcpy(new_data->colors, data->colors, sizeof(uint32_t) * kept);
+	}
+
+	destroy();
+	vbuf = new_vbuf;
+	data = new_data;
+	capacity = new_capacity;
+	count = kept;
+	return true;
+}
+
+void vertex_batch::add_fan(float cx, float cy, float radius, int segments, uint32_t color)
+{
+	// Same winding as the (center, rim) tri-strips it replaces, minus the
+	// degenerate triangles
+	if (segments < UNIT_CIRCLE_MIN_SEGMENTS)
+		segments = UNIT_CIRCLE_MIN_SEGMENTS;
+	else if (segments > UNIT_CIRCLE_MAX_SEGMENTS)
+		segments = UNIT_CIRCLE_MAX_SEGMENTS;
+
+	const struct vec2 *rim = unit_circle_table(segments);
+	for (int s = 0; s < segments; s++) {
+		add(cx, cy, color);
+		add(cx + rim[s].x * radius, cy + rim[s].y * radius, color);
+		add(cx + rim[s + 1].x * radius, cy + rim[s + 1].y * radius, color);
+	}
+}
+
+void vertex_batch::add_rect(float x0, float y0, float x1, float y1, uint32_t color)
+{
+	add(x0, y0, color);
+	add(x1, y0, color);
+	add(x0, y1, color);
+	add(x1, y0, color);
+	add(x1, y1, color);
+	add(x0, y1, color);
+}
+
+void vertex_batch::draw()
+{
+	if (!vbuf || count == 0)
+		return;
+
+	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
+	gs_eparam_t *color_param = gs_effect_get_param_by_name(solid, "color");
+
+	// Vertex colors carry the full RGBA; the uniform just passes them through
+	struct vec4 white;
+	vec4_set(&white, 1.0f, 1.0f, 1.0f, 1.0f);
+	gs_effect_set_vec4(color_param, &white);
+
+	gs_vertexbuffer_flush(vbuf);
+	gs_load_vertexbuffer(vbuf);
+	gs_load_indexbuffer(nullptr);
+
+	while (gs_effect_loop(solid, "SolidColored"))
+		gs_draw(GS_TRIS, 0, (uint32_t)count);
+
+	gs_load_vertexbuffer(nullptr);
+}
+
+void vertex_batch::destroy()
+{
+	if (vbuf)
+		gs_vertexbuffer_destroy(vbuf);
+	vbuf = nullptr;
+	data = nullptr;
+	capacity = 0;
+	count = 0;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+#include <graphics/vec3.h>
+
+// Dynamic position + color vertex buffer that is refilled every frame and
+// submitted with a single gs_draw through OBS_EFFECT_SOLID's "SolidColored"
+// technique. Replaces long runs of immediate-mode gs_render_start/stop pairs
+// that only differ by their uniform color.
+//
+// Must only be used from the graphics thread.
+struct vertex_batch {
+	gs_vertbuffer_t *vbuf;
+	struct gs_vb_data *data;
+	size_t capacity;
+	size_t count;
+
+	vertex_batch();
+
+	// Starts a new frame's geometry with room for at least num vertices
+	// (a hint: add() grows the buffer if the estimate was short)
+	void begin(size_t num);
+
+	inline void add(float x, float y, uint32_t color)
+	{
+		if (count >= capacity && !grow(count + 1))
+			return;
+		vec3_set(&data->points[count], x, y, 0.0f);
+		data->colors[count] = color;
+		count++;
+	}
+
+	// Filled circle as a triangle list: segments * 3 vertices, rim points
+	// from the shared unit-circle table
+	void add_fan(float cx, float cy, float radius, int segments, uint32_t color);
+
+	// Axis-aligned rectangle as two triangles (6 vertices)
+	void add_rect(float x0, float y0, float x1, float y1, uint32_t color);
+
+	// Uploads and draws everything added since begin() as GS_TRIS
+	void draw();
+
+	void destroy();
+
+private:
+	// Reallocates for at least num vertices, keeping what was added so far
+	bool grow(size_t num);
+};